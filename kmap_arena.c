@@ -0,0 +1,208 @@
+/**
+ * @file kmap_arena.c
+ * @brief Chained bump arena for per-solve scratch and results
+ *
+ * Allocation bumps a cursor in the current block; a full block chains to
+ * the next one, reusing blocks kept from earlier solves before asking
+ * malloc for more. Reset and release only move cursors, so once an arena
+ * has grown to a workload's peak, solving allocates nothing.
+ */
+
+#include "kmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGN 16
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct arena_block {
+    struct arena_block* next;                   // Newer block (kept across resets)
+    size_t size;                                // Usable bytes
+    size_t used;                                // Bump cursor
+    bool owned;                                 // Allocated with malloc
+    char* data;
+} arena_block_t;
+
+struct kmap_arena {
+    arena_block_t* first;
+    arena_block_t* current;
+    size_t block_size;                          // Minimum size of chained blocks
+    bool owned;                                 // Header allocated with malloc
+};
+
+static inline size_t align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+/**
+ * @brief Carve a block header and data out of one allocation
+ */
+static arena_block_t* block_in(void* memory, size_t len, bool owned) {
+    size_t header = align_up(sizeof(arena_block_t));
+    if (len < header + ARENA_ALIGN) return NULL;
+    
+    arena_block_t* block = (arena_block_t*)memory;
+    block->next = NULL;
+    block->data = (char*)memory + header;
+    block->size = (len - header) & ~(size_t)(ARENA_ALIGN - 1);
+    block->used = 0;
+    block->owned = owned;
+    return block;
+}
+
+/* === PUBLIC API === */
+
+kmap_arena_t* kmap_arena_create(size_t block_size) {
+    if (block_size == 0) block_size = DEFAULT_BLOCK_SIZE;
+    
+    kmap_arena_t* arena = malloc(sizeof(kmap_arena_t));
+    void* memory = malloc(block_size);
+    arena_block_t* block = memory ? block_in(memory, block_size, true) : NULL;
+    if (!arena || !block) {
+        free(arena);
+        free(memory);
+        return NULL;
+    }
+    
+    arena->first = block;
+    arena->current = block;
+    arena->block_size = block_size;
+    arena->owned = true;
+    return arena;
+}
+
+kmap_arena_t* kmap_arena_init(void* buffer, size_t len) {
+    if (!buffer) return NULL;
+    
+    /* Align the start so any char buffer will do */
+    size_t skew = (size_t)(-(uintptr_t)buffer & (ARENA_ALIGN - 1));
+    size_t header = skew + align_up(sizeof(kmap_arena_t));
+    if (len < header) return NULL;
+    
+    arena_block_t* block = block_in((char*)buffer + header, len - header, false);
+    if (!block) return NULL;
+    
+    kmap_arena_t* arena = (kmap_arena_t*)((char*)buffer + skew);
+    arena->first = block;
+    arena->current = block;
+    arena->block_size = (len > DEFAULT_BLOCK_SIZE) ? len : DEFAULT_BLOCK_SIZE;
+    arena->owned = false;
+    return arena;
+}
+
+void kmap_arena_destroy(kmap_arena_t* arena) {
+    if (!arena) return;
+    
+    arena_block_t* block = arena->first;
+    while (block) {
+        arena_block_t* next = block->next;
+        if (block->owned) free(block);
+        block = next;
+    }
+    
+    if (arena->owned) free(arena);
+}
+
+void kmap_arena_reset(kmap_arena_t* arena) {
+    if (!arena) return;
+    
+    for (arena_block_t* block = arena->first; block; block = block->next) block->used = 0;
+    arena->current = arena->first;
+}
+
+void* kmap_arena_alloc(kmap_arena_t* arena, size_t size) {
+    if (!arena) return NULL;
+    
+    size = align_up(size ? size : 1);
+    arena_block_t* block = arena->current;
+    
+    /* Later blocks are empty: by reset, release, or never used */
+    while (block->size - block->used < size) {
+        if (!block->next || block->next->size < size) {
+            size_t len = align_up(sizeof(arena_block_t)) + size;
+            if (len < arena->block_size) len = arena->block_size;
+            
+            void* memory = malloc(len);
+            arena_block_t* fresh = memory ? block_in(memory, len, true) : NULL;
+            if (!fresh) {
+                free(memory);
+                return NULL;
+            }
+            
+            fresh->next = block->next;
+            block->next = fresh;
+        }
+        block = block->next;
+    }
+    
+    arena->current = block;
+    void* ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void* kmap_arena_calloc(kmap_arena_t* arena, size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    
+    void* ptr = kmap_arena_alloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+size_t kmap_arena_capacity(const kmap_arena_t* arena) {
+    size_t total = 0;
+    if (!arena) return 0;
+    
+    for (const arena_block_t* block = arena->first; block; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+/* === PER-THREAD ARENA === */
+
+static __thread kmap_arena_t* thread_arena;
+
+kmap_arena_t* kmap_thread_arena(void) {
+    if (!thread_arena) thread_arena = kmap_arena_create(0);
+    return thread_arena;
+}
+
+void kmap_thread_arena_free(void) {
+    kmap_arena_destroy(thread_arena);
+    thread_arena = NULL;
+}
+
+/* === INTERNAL: NESTED SCOPES AND GROWTH === */
+
+kmap_arena_mark_t kmap_arena_mark(const kmap_arena_t* arena) {
+    kmap_arena_mark_t mark;
+    mark.block = arena->current;
+    mark.used = arena->current->used;
+    return mark;
+}
+
+void kmap_arena_release(kmap_arena_t* arena, kmap_arena_mark_t mark) {
+    arena_block_t* block = (arena_block_t*)mark.block;
+    block->used = mark.used;
+    for (arena_block_t* later = block->next; later; later = later->next) later->used = 0;
+    arena->current = block;
+}
+
+void* kmap_arena_grow(kmap_arena_t* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!ptr) return kmap_arena_alloc(arena, new_size);
+    
+    /* The newest allocation grows in place while its block has room */
+    arena_block_t* block = arena->current;
+    size_t old_aligned = align_up(old_size ? old_size : 1);
+    size_t new_aligned = align_up(new_size ? new_size : 1);
+    if ((char*)ptr + old_aligned == block->data + block->used &&
+        block->used - old_aligned + new_aligned <= block->size) {
+        block->used = block->used - old_aligned + new_aligned;
+        return ptr;
+    }
+    
+    void* moved = kmap_arena_alloc(arena, new_size);
+    if (moved) memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
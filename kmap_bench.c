@@ -0,0 +1,492 @@
+/**
+ * @file kmap_bench.c
+ * @brief Per-stage benchmark harness for the solver core
+ *
+ * For each corpus (random, dense don't cares, parity) and variable count
+ * the stages parse, primes, cover and emit are timed on their own, then
+ * the full string-to-string solve. A sample is the mean of a short burst
+ * of operations over the corpus, so timer overhead stays out of 2-variable
+ * numbers; percentiles are taken over the samples.
+ *
+ * Usage: kmap_bench [--json FILE] [--seed N] [--time-ms N] [--max-vars N]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CORPUS_SIZE 256
+#define WIDE_CORPUS_SIZE 16
+#define BURST 16
+#define MIN_SAMPLES 32
+#define MAX_SAMPLES 20000
+#define DEFAULT_TIME_MS 40
+#define DEFAULT_MAX_VARS 10
+
+typedef enum {
+    CORPUS_RANDOM,
+    CORPUS_DENSE_DC,
+    CORPUS_PARITY,
+    CORPUS_COUNT
+} corpus_kind_t;
+
+static const char* const corpus_names[CORPUS_COUNT] = {"random", "dense_dc", "parity"};
+
+/**
+ * @brief Inputs of one (corpus, variable count) pair, plus per-stage precomputation
+ */
+typedef struct {
+    uint8_t num_vars;
+    size_t count;
+    char** inputs;                              // Binary strings, highest cell first
+    
+    /* Up to 6 variables */
+    truth_table_t* tables;
+    implicant_t (*primes)[MAX_CUBES];
+    uint16_t* prime_counts;
+    solution_t* solutions;
+    
+    /* 7 or more variables */
+    kmap_wide_table_t* wide;
+    kmap_cube_t** wide_primes;
+    uint32_t* wide_prime_counts;
+    kmap_cover_t* covers;
+    
+    kmap_arena_t* arena;
+    kmap_options_t opts;
+} bench_corpus_t;
+
+typedef void (*stage_fn)(bench_corpus_t* corpus, size_t index);
+
+typedef struct {
+    const char* name;
+    stage_fn narrow;
+    stage_fn wide;
+} bench_stage_t;
+
+typedef struct {
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    size_t samples;
+} bench_stats_t;
+
+/* Results reach memory, so no stage can be optimized away */
+static volatile uint64_t sink;
+
+static char emit_buffer[1 << 20];
+
+/* === CORPUS GENERATION === */
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Write one cell pattern of the corpus into minterm/don't-care words
+ */
+static void generate_cells(corpus_kind_t kind, uint8_t num_vars, uint64_t* state,
+                           uint64_t* minterms, uint64_t* dont_cares) {
+    size_t cells = (size_t)1 << num_vars;
+    uint64_t flip = next_random(state) & 1;
+    
+    for (size_t c = 0; c < cells; c++) {
+        uint64_t bit = 1ULL << (c % 64);
+        uint64_t r = next_random(state);
+        bool one = false, dc = false;
+        
+        switch (kind) {
+            case CORPUS_RANDOM: one = r & 1; break;
+            case CORPUS_DENSE_DC:
+                /* Half don't cares, the rest split evenly */
+                dc = (r & 3) < 2;
+                one = !dc && (r & 3) == 2;
+                break;
+            case CORPUS_PARITY: one = (popcount((uint64_t)c) & 1) ^ flip; break;
+            default: break;
+        }
+        
+        if (one) minterms[c / 64] |= bit;
+        if (dc) dont_cares[c / 64] |= bit;
+    }
+}
+
+static char* render_cells(const uint64_t* minterms, const uint64_t* dont_cares,
+                          uint8_t num_vars) {
+    size_t cells = (size_t)1 << num_vars;
+    char* text = malloc(cells + 1);
+    if (!text) return NULL;
+    
+    for (size_t c = 0; c < cells; c++) {
+        uint64_t bit = 1ULL << (c % 64);
+        char cell = (minterms[c / 64] & bit) ? '1' : (dont_cares[c / 64] & bit) ? 'X' : '0';
+        text[cells - 1 - c] = cell;
+    }
+    text[cells] = '\0';
+    return text;
+}
+
+static void free_corpus(bench_corpus_t* corpus) {
+    for (size_t i = 0; i < corpus->count; i++) {
+        if (corpus->inputs) free(corpus->inputs[i]);
+        if (corpus->wide) kmap_wide_table_free(&corpus->wide[i]);
+        if (corpus->wide_primes) free(corpus->wide_primes[i]);
+        if (corpus->covers) kmap_cover_free(&corpus->covers[i]);
+    }
+    
+    free(corpus->inputs);
+    free(corpus->tables);
+    free(corpus->primes);
+    free(corpus->prime_counts);
+    free(corpus->solutions);
+    free(corpus->wide);
+    free(corpus->wide_primes);
+    free(corpus->wide_prime_counts);
+    free(corpus->covers);
+    kmap_arena_destroy(corpus->arena);
+    memset(corpus, 0, sizeof(bench_corpus_t));
+}
+
+/**
+ * @brief Generate a corpus and run every stage once to fill its inputs
+ */
+static int build_corpus(bench_corpus_t* corpus, corpus_kind_t kind, uint8_t num_vars,
+                        uint64_t seed) {
+    bool wide = num_vars > MAX_VARIABLES;
+    uint64_t state = (seed ^ ((uint64_t)kind << 32) ^ num_vars) * 0x9E3779B97F4A7C15ULL;
+    if (state == 0) state = 1;  /* xorshift never leaves zero */
+    
+    memset(corpus, 0, sizeof(bench_corpus_t));
+    corpus->num_vars = num_vars;
+    corpus->count = wide ? WIDE_CORPUS_SIZE : CORPUS_SIZE;
+    corpus->inputs = calloc(corpus->count, sizeof(char*));
+    corpus->arena = kmap_arena_create(0);
+    kmap_get_options(&corpus->opts);
+    if (!corpus->inputs || !corpus->arena) return -4;
+    
+    if (wide) {
+        corpus->wide = calloc(corpus->count, sizeof(kmap_wide_table_t));
+        corpus->wide_primes = calloc(corpus->count, sizeof(kmap_cube_t*));
+        corpus->wide_prime_counts = calloc(corpus->count, sizeof(uint32_t));
+        corpus->covers = calloc(corpus->count, sizeof(kmap_cover_t));
+        if (!corpus->wide || !corpus->wide_primes || !corpus->wide_prime_counts ||
+            !corpus->covers) {
+            return -4;
+        }
+    } else {
+        corpus->tables = calloc(corpus->count, sizeof(truth_table_t));
+        corpus->primes = calloc(corpus->count, sizeof(*corpus->primes));
+        corpus->prime_counts = calloc(corpus->count, sizeof(uint16_t));
+        corpus->solutions = calloc(corpus->count, sizeof(solution_t));
+        if (!corpus->tables || !corpus->primes || !corpus->prime_counts || !corpus->solutions) {
+            return -4;
+        }
+    }
+    
+    for (size_t i = 0; i < corpus->count; i++) {
+        int result;
+        
+        if (wide) {
+            kmap_wide_table_t* tt = &corpus->wide[i];
+            result = kmap_wide_table_init(tt, num_vars);
+            if (result != 0) return result;
+            generate_cells(kind, num_vars, &state, tt->minterms, tt->dont_cares);
+            
+            /* Primes are copied out of the arena so the stages can reuse it */
+            kmap_cube_t* primes;
+            uint32_t prime_count;
+            kmap_arena_reset(corpus->arena);
+            result = generate_wide_primes(tt, corpus->arena, &primes, &prime_count);
+            if (result != 0) return result;
+            
+            size_t bytes = prime_count * sizeof(kmap_cube_t);
+            corpus->wide_primes[i] = malloc(bytes ? bytes : 1);
+            if (!corpus->wide_primes[i]) return -4;
+            if (bytes) memcpy(corpus->wide_primes[i], primes, bytes);
+            corpus->wide_prime_counts[i] = prime_count;
+            
+            result = solve_kmap_wide(tt, &corpus->covers[i], &corpus->opts);
+            if (result != 0) return result;
+            
+            corpus->inputs[i] = render_cells(tt->minterms, tt->dont_cares, num_vars);
+        } else {
+            uint64_t minterms = 0, dont_cares = 0;
+            generate_cells(kind, num_vars, &state, &minterms, &dont_cares);
+            
+            truth_table_t* tt = &corpus->tables[i];
+            result = init_truth_table(minterms, dont_cares, num_vars, tt);
+            if (result == 0) result = find_prime_implicants(tt, &corpus->solutions[i]);
+            if (result != 0) return result;
+            
+            corpus->prime_counts[i] = generate_prime_implicants(minterms, dont_cares, num_vars,
+                                                                corpus->primes[i]);
+            corpus->inputs[i] = render_cells(&minterms, &dont_cares, num_vars);
+        }
+        
+        if (!corpus->inputs[i]) return -4;
+    }
+    
+    kmap_arena_reset(corpus->arena);
+    return 0;
+}
+
+/* === STAGES === */
+
+static void stage_parse(bench_corpus_t* corpus, size_t index) {
+    truth_table_t tt;
+    int result = parse_input_n(corpus->inputs[index], (size_t)1 << corpus->num_vars, &tt);
+    sink += (uint64_t)result + tt.minterms;
+}
+
+static void stage_parse_wide(bench_corpus_t* corpus, size_t index) {
+    kmap_wide_table_t tt;
+    int result = parse_input_wide(corpus->inputs[index], (size_t)1 << corpus->num_vars, &tt);
+    if (result == 0) {
+        sink += tt.minterms[0];
+        kmap_wide_table_free(&tt);
+    }
+}
+
+static void stage_primes(bench_corpus_t* corpus, size_t index) {
+    prime_set_t primes;
+    const truth_table_t* tt = &corpus->tables[index];
+    sink += generate_prime_set(tt->minterms, tt->dont_cares, tt->num_vars, &primes);
+}
+
+static void stage_primes_wide(bench_corpus_t* corpus, size_t index) {
+    kmap_cube_t* primes;
+    uint32_t prime_count = 0;
+    kmap_arena_reset(corpus->arena);
+    generate_wide_primes(&corpus->wide[index], corpus->arena, &primes, &prime_count);
+    sink += prime_count;
+}
+
+/**
+ * @brief Exact cover over precomputed primes, as solve_uncached() runs it
+ */
+static void stage_cover(bench_corpus_t* corpus, size_t index) {
+    uint64_t columns[MAX_CUBES];
+    uint16_t costs[MAX_CUBES];
+    uint32_t selected[MAX_CELLS];
+    uint32_t selected_count = 0;
+    bool optimal;
+    
+    const implicant_t* primes = corpus->primes[index];
+    uint16_t prime_count = corpus->prime_counts[index];
+    for (uint16_t i = 0; i < prime_count; i++) {
+        columns[i] = primes[i].covered_minterms;
+        costs[i] = (uint16_t)(TERM_COST + popcount(primes[i].literal_mask));
+    }
+    
+    solve_cover(columns, costs, prime_count, corpus->tables[index].minterms, &corpus->opts,
+                selected, &selected_count, &optimal);
+    sink += selected_count;
+}
+
+static void stage_cover_wide(bench_corpus_t* corpus, size_t index) {
+    kmap_cover_t cover;
+    kmap_arena_reset(corpus->arena);
+    cover_wide_primes(&corpus->wide[index], corpus->wide_primes[index],
+                      corpus->wide_prime_counts[index], &corpus->opts, corpus->arena, &cover);
+    sink += cover.count;
+}
+
+static void stage_emit(bench_corpus_t* corpus, size_t index) {
+    sink += (uint64_t)generate_sop_expression_n(&corpus->solutions[index], corpus->num_vars,
+                                                emit_buffer, sizeof(emit_buffer));
+}
+
+static void stage_emit_wide(bench_corpus_t* corpus, size_t index) {
+    sink += (uint64_t)generate_sop_expression_wide(&corpus->covers[index], corpus->num_vars,
+                                                   emit_buffer, sizeof(emit_buffer));
+}
+
+/**
+ * @brief String in, string out, with the process-wide caches enabled
+ */
+static void stage_solve(bench_corpus_t* corpus, size_t index) {
+    sink += (uint64_t)solve_forms_n(corpus->inputs[index], (size_t)1 << corpus->num_vars,
+                                    KMAP_FORM_SOP, '\n', emit_buffer, sizeof(emit_buffer));
+}
+
+static const bench_stage_t stages[] = {
+    {"parse", stage_parse, stage_parse_wide},
+    {"primes", stage_primes, stage_primes_wide},
+    {"cover", stage_cover, stage_cover_wide},
+    {"emit", stage_emit, stage_emit_wide},
+    {"solve", stage_solve, stage_solve},
+};
+
+#define STAGE_COUNT (sizeof(stages) / sizeof(stages[0]))
+
+/* === TIMING === */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double* sorted, size_t count, double p) {
+    size_t rank = (size_t)(p * (double)(count - 1) + 0.5);
+    return sorted[rank];
+}
+
+/**
+ * @brief Sample bursts of one stage until the time budget is spent
+ */
+static void run_stage(bench_corpus_t* corpus, stage_fn fn, double budget_ns,
+                      double* samples, bench_stats_t* stats) {
+    size_t burst = (corpus->num_vars > MAX_VARIABLES) ? 1 : BURST;
+    size_t next = 0, count = 0;
+    double total = 0;
+    
+    /* Warm caches and branch predictors on the whole corpus first */
+    for (size_t i = 0; i < corpus->count; i++) fn(corpus, i);
+    
+    double start = now_ns();
+    while (count < MAX_SAMPLES && (count < MIN_SAMPLES || now_ns() - start < budget_ns)) {
+        double begin = now_ns();
+        for (size_t k = 0; k < burst; k++) {
+            fn(corpus, next);
+            next = (next + 1 == corpus->count) ? 0 : next + 1;
+        }
+        double sample = (now_ns() - begin) / (double)burst;
+        samples[count++] = sample;
+        total += sample;
+    }
+    
+    qsort(samples, count, sizeof(double), compare_doubles);
+    stats->samples = count;
+    stats->mean = total / (double)count;
+    stats->p50 = percentile(samples, count, 0.50);
+    stats->p90 = percentile(samples, count, 0.90);
+    stats->p99 = percentile(samples, count, 0.99);
+    stats->max = samples[count - 1];
+}
+
+/* === DRIVER === */
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--json FILE] [--seed N] [--time-ms N] [--max-vars N]\n"
+                    "  --json FILE   Also write results as JSON (- = stdout)\n"
+                    "  --seed N      Corpus seed (default 1)\n"
+                    "  --time-ms N   Sampling time per stage (default %d)\n"
+                    "  --max-vars N  Largest variable count, 2-16 (default %d)\n",
+            program, DEFAULT_TIME_MS, DEFAULT_MAX_VARS);
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = NULL;
+    uint64_t seed = 1;
+    long time_ms = DEFAULT_TIME_MS;
+    long max_vars = DEFAULT_MAX_VARS;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--json") == 0 && value) {
+            json_path = value;
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            seed = strtoull(value, NULL, 0);
+        } else if (strcmp(argv[i], "--time-ms") == 0 && value) {
+            time_ms = strtol(value, NULL, 10);
+        } else if (strcmp(argv[i], "--max-vars") == 0 && value) {
+            max_vars = strtol(value, NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    
+    if (seed == 0) seed = 1;
+    if (time_ms <= 0 || max_vars < 2 || max_vars > MAX_WIDE_VARIABLES) {
+        usage(argv[0]);
+        return 2;
+    }
+    
+    FILE* json = NULL;
+    if (json_path) {
+        json = (strcmp(json_path, "-") == 0) ? stdout : fopen(json_path, "w");
+        if (!json) {
+            perror(json_path);
+            return 1;
+        }
+        fprintf(json, "{\n  \"seed\": %llu,\n  \"time_ms\": %ld,\n  \"results\": [",
+                (unsigned long long)seed, time_ms);
+    }
+    
+    double* samples = malloc(MAX_SAMPLES * sizeof(double));
+    if (!samples) return 1;
+    
+    FILE* table = (json == stdout) ? stderr : stdout;
+    fprintf(table, "%-9s %4s %-7s %10s %10s %10s %10s %8s\n",
+            "corpus", "vars", "stage", "mean ns", "p50 ns", "p90 ns", "p99 ns", "samples");
+    
+    bool first = true;
+    int status = 0;
+    
+    for (int kind = 0; kind < CORPUS_COUNT && status == 0; kind++) {
+        for (long n = 2; n <= max_vars && status == 0; n++) {
+            /* Every variable count up to 6, then every other one */
+            if (n > MAX_VARIABLES && n % 2 != 0 && n != max_vars) continue;
+            
+            bench_corpus_t corpus;
+            int result = build_corpus(&corpus, (corpus_kind_t)kind, (uint8_t)n, seed);
+            if (result != 0) {
+                fprintf(stderr, "corpus %s/%ld failed (code %d)\n", corpus_names[kind], n, result);
+                free_corpus(&corpus);
+                status = 1;
+                break;
+            }
+            
+            for (size_t s = 0; s < STAGE_COUNT; s++) {
+                bench_stats_t stats;
+                stage_fn fn = (n > MAX_VARIABLES) ? stages[s].wide : stages[s].narrow;
+                run_stage(&corpus, fn, (double)time_ms * 1e6, samples, &stats);
+                
+                fprintf(table, "%-9s %4ld %-7s %10.1f %10.1f %10.1f %10.1f %8zu\n",
+                        corpus_names[kind], n, stages[s].name,
+                        stats.mean, stats.p50, stats.p90, stats.p99, stats.samples);
+                
+                if (json) {
+                    fprintf(json, "%s\n    {\"corpus\": \"%s\", \"num_vars\": %ld, "
+                                  "\"stage\": \"%s\", \"mean_ns\": %.1f, \"p50_ns\": %.1f, "
+                                  "\"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, "
+                                  "\"samples\": %zu}",
+                            first ? "" : ",", corpus_names[kind], n, stages[s].name,
+                            stats.mean, stats.p50, stats.p90, stats.p99, stats.max,
+                            stats.samples);
+                    first = false;
+                }
+            }
+            
+            free_corpus(&corpus);
+        }
+    }
+    
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        if (json != stdout) fclose(json);
+    }
+    
+    free(samples);
+    kmap_thread_arena_free();
+    return status;
+}
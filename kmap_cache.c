@@ -0,0 +1,495 @@
+/**
+ * @file kmap_cache.c
+ * @brief Solution caches in front of the exact solver
+ * 
+ * 4-variable functions without don't cares are memoized in a flat
+ * 65536-entry table indexed directly by the truth table. 5-6 variable
+ * functions go through a fixed-size hash table keyed on a canonical form
+ * under input permutation and negation.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* === 4-VARIABLE MEMO TABLE === */
+
+#define MEMO4_ENTRIES 65536
+#define MEMO4_MAX_TERMS 8                       // 2^(4-1): worst case is parity
+
+/* Entry states */
+#define MEMO4_EMPTY 0
+#define MEMO4_BUSY 1
+#define MEMO4_READY 2
+
+/**
+ * @brief One memoized solution, 16 bytes
+ * 
+ * Each term packs literal_mask in the high nibble and literal_values in
+ * the low nibble. Entries hold no pointers, so the table can be written
+ * to disk or mapped as-is.
+ */
+typedef struct {
+    uint8_t state;                              // MEMO4_* (atomic)
+    uint8_t term_count;
+    uint8_t optimal;
+    uint8_t reserved;
+    uint8_t terms[MEMO4_MAX_TERMS];
+    uint8_t padding[4];
+} memo4_entry_t;
+
+/* Lives in BSS: pages are only touched as entries fill in */
+static memo4_entry_t memo4_table[MEMO4_ENTRIES];
+
+bool memo4_lookup(uint16_t minterms, solution_t* solution) {
+    const memo4_entry_t* entry = &memo4_table[minterms];
+    
+    if (__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE) != MEMO4_READY) return false;
+    
+    memset(solution, 0, sizeof(solution_t));
+    
+    for (uint8_t i = 0; i < entry->term_count; i++) {
+        implicant_t* imp = &solution->implicants[i];
+        
+        imp->literal_mask = entry->terms[i] >> 4;
+        imp->literal_values = entry->terms[i] & 0x0F;
+        imp->covered_minterms = cube_coverage(imp->literal_mask, imp->literal_values, 4) & minterms;
+        imp->size = popcount(imp->covered_minterms);
+        solution->literal_count += popcount(imp->literal_mask);
+    }
+    
+    solution->implicant_count = entry->term_count;
+    solution->term_count = entry->term_count;
+    solution->optimal = entry->optimal;
+    
+    return true;
+}
+
+void memo4_store(uint16_t minterms, const solution_t* solution) {
+    memo4_entry_t* entry = &memo4_table[minterms];
+    uint8_t expected = MEMO4_EMPTY;
+    
+    /* A budget-limited cover would be served to every later caller */
+    if (!solution->optimal || solution->implicant_count > MEMO4_MAX_TERMS) return;
+    
+    /* First writer wins; concurrent solvers of the same function just skip */
+    if (!__atomic_compare_exchange_n(&entry->state, &expected, MEMO4_BUSY, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+    }
+    
+    for (uint8_t i = 0; i < solution->implicant_count; i++) {
+        entry->terms[i] = (uint8_t)((solution->implicants[i].literal_mask << 4) |
+                                    (solution->implicants[i].literal_values & 0x0F));
+    }
+    entry->term_count = solution->implicant_count;
+    entry->optimal = solution->optimal;
+    
+    __atomic_store_n(&entry->state, MEMO4_READY, __ATOMIC_RELEASE);
+}
+
+int kmap_memo4_prewarm(void) {
+    kmap_options_t opts;
+    truth_table_t tt;
+    solution_t solution;
+    
+    kmap_get_options(&opts);
+    opts.flags &= ~KMAP_OPT_MEMO4;
+    
+    for (uint32_t minterms = 0; minterms < MEMO4_ENTRIES; minterms++) {
+        if (__atomic_load_n(&memo4_table[minterms].state, __ATOMIC_ACQUIRE) == MEMO4_READY) continue;
+        
+        init_truth_table(minterms, 0, 4, &tt);
+        int result = find_prime_implicants_ex(&tt, &solution, &opts);
+        if (result != 0) return result;
+        
+        memo4_store((uint16_t)minterms, &solution);
+    }
+    
+    return 0;
+}
+
+size_t kmap_memo4_count(void) {
+    size_t count = 0;
+    
+    for (uint32_t i = 0; i < MEMO4_ENTRIES; i++) {
+        if (__atomic_load_n(&memo4_table[i].state, __ATOMIC_ACQUIRE) == MEMO4_READY) count++;
+    }
+    
+    return count;
+}
+
+/* === NP-CANONICAL CACHE === */
+
+#define NPN_PROBE 4                             // Slots searched per lookup
+#define NPN_MAX_CANDIDATES 48                   // Tie-break transforms tried
+
+static const uint64_t var_masks[MAX_VARIABLES] = {
+    VAR_MASK_0, VAR_MASK_1, VAR_MASK_2, VAR_MASK_3, VAR_MASK_4, VAR_MASK_5
+};
+
+/**
+ * @brief One cached solution in canonical variable order, 88 bytes
+ */
+typedef struct {
+    uint64_t minterms;                          // Canonical key
+    uint64_t dont_cares;
+    uint8_t lock;                               // Spinlock (atomic)
+    uint8_t num_vars;                           // 0 = empty slot
+    uint8_t term_count;
+    uint8_t optimal;
+    uint16_t terms[MAX_GROUPS];                 // literal_mask << 8 | literal_values
+} npn_entry_t;
+
+static npn_entry_t* npn_table;
+static size_t npn_capacity;                     // Power of two
+
+/* Counters (atomic) */
+static uint64_t npn_lookups;
+static uint64_t npn_hits;
+static uint64_t npn_misses;
+static uint64_t npn_evictions;
+static uint64_t npn_used;
+
+/**
+ * @brief Complement one input: swap the cofactors across it
+ */
+static inline uint64_t negate_variable(uint64_t cells, uint8_t var) {
+    uint8_t shift = 1 << var;
+    return ((cells & var_masks[var]) >> shift) | ((cells << shift) & var_masks[var]);
+}
+
+/**
+ * @brief Exchange inputs i < j with a delta swap
+ */
+static inline uint64_t swap_variables(uint64_t cells, uint8_t i, uint8_t j) {
+    uint8_t delta = (1 << j) - (1 << i);
+    uint64_t t = ((cells >> delta) ^ cells) & var_masks[i] & ~var_masks[j];
+    return cells ^ t ^ (t << delta);
+}
+
+/**
+ * @brief Negate the inputs in negate, then move original input perm[i] to i
+ */
+static uint64_t apply_transform(uint64_t cells, uint8_t num_vars,
+                                const uint8_t* perm, uint8_t negate) {
+    uint8_t current[MAX_VARIABLES];
+    
+    for (uint8_t var = 0; var < num_vars; var++) {
+        if (negate & (1 << var)) cells = negate_variable(cells, var);
+        current[var] = var;
+    }
+    
+    for (uint8_t i = 0; i < num_vars; i++) {
+        uint8_t j = i;
+        while (current[j] != perm[i]) j++;
+        if (j == i) continue;
+        
+        cells = swap_variables(cells, i, j);
+        current[j] = current[i];
+        current[i] = perm[i];
+    }
+    
+    return cells;
+}
+
+/**
+ * @brief Search state for resolving canonicalization ties
+ */
+typedef struct {
+    const truth_table_t* tt;
+    uint8_t perm[MAX_VARIABLES];                // Permutation being built
+    uint8_t run_end[MAX_VARIABLES];             // End of the tie run at i
+    uint8_t negate;
+    uint8_t ambiguous;                          // Inputs with balanced cofactors
+    uint64_t best_minterms;
+    uint64_t best_dont_cares;
+    uint8_t best_perm[MAX_VARIABLES];
+    uint8_t best_negate;
+} canon_search_t;
+
+static void canon_try(canon_search_t* cs) {
+    uint8_t subset = 0;
+    
+    /* Every phase choice for the balanced inputs */
+    do {
+        uint8_t negate = cs->negate ^ subset;
+        uint64_t on = apply_transform(cs->tt->minterms, cs->tt->num_vars, cs->perm, negate);
+        uint64_t dc = apply_transform(cs->tt->dont_cares, cs->tt->num_vars, cs->perm, negate);
+        
+        if (on < cs->best_minterms || (on == cs->best_minterms && dc < cs->best_dont_cares)) {
+            cs->best_minterms = on;
+            cs->best_dont_cares = dc;
+            memcpy(cs->best_perm, cs->perm, sizeof(cs->perm));
+            cs->best_negate = negate;
+        }
+        
+        subset = (uint8_t)((subset - cs->ambiguous) & cs->ambiguous);
+    } while (subset);
+}
+
+/**
+ * @brief Enumerate orders within each run of equally weighted inputs
+ */
+static void canon_permute(canon_search_t* cs, uint8_t pos) {
+    if (pos >= cs->tt->num_vars) {
+        canon_try(cs);
+        return;
+    }
+    
+    uint8_t end = cs->run_end[pos];
+    if (pos + 1 >= end) {
+        canon_permute(cs, end);
+        return;
+    }
+    
+    /* Choose which input of the run sits at pos, recurse for the rest */
+    for (uint8_t i = pos; i < end; i++) {
+        uint8_t tmp = cs->perm[pos];
+        cs->perm[pos] = cs->perm[i];
+        cs->perm[i] = tmp;
+        
+        canon_permute(cs, pos + 1);
+        
+        cs->perm[i] = cs->perm[pos];
+        cs->perm[pos] = tmp;
+    }
+}
+
+void kmap_np_canonicalize(const truth_table_t* tt, truth_table_t* canonical,
+                          uint8_t perm[MAX_VARIABLES], uint8_t* negate) {
+    uint8_t num_vars = tt->num_vars;
+    uint64_t cells = cube_coverage(0, 0, num_vars);
+    uint16_t weight[MAX_VARIABLES];
+    canon_search_t cs;
+    
+    cs.tt = tt;
+    cs.negate = 0;
+    cs.ambiguous = 0;
+    
+    /* Make the positive cofactor of every input the heavier one */
+    for (uint8_t var = 0; var < num_vars; var++) {
+        uint64_t high = var_masks[var] & cells;
+        uint64_t low = ~var_masks[var] & cells;
+        uint16_t w1 = (uint16_t)((popcount(tt->minterms & high) << 8) | popcount(tt->dont_cares & high));
+        uint16_t w0 = (uint16_t)((popcount(tt->minterms & low) << 8) | popcount(tt->dont_cares & low));
+        
+        if (w1 < w0) cs.negate |= 1 << var;
+        if (w1 == w0) cs.ambiguous |= 1 << var;
+        weight[var] = (w1 > w0) ? w1 : w0;
+        cs.perm[var] = var;
+    }
+    
+    /* Heaviest inputs first */
+    for (uint8_t i = 1; i < num_vars; i++) {
+        uint8_t var = cs.perm[i];
+        uint8_t j = i;
+        while (j > 0 && weight[cs.perm[j - 1]] < weight[var]) {
+            cs.perm[j] = cs.perm[j - 1];
+            j--;
+        }
+        cs.perm[j] = var;
+    }
+    
+    /* Runs of equal weight are interchangeable; count the candidates */
+    uint32_t candidates = 1U << popcount(cs.ambiguous);
+    for (uint8_t i = 0; i < num_vars;) {
+        uint8_t end = i + 1;
+        while (end < num_vars && weight[cs.perm[end]] == weight[cs.perm[i]]) end++;
+        for (uint8_t k = i; k < end; k++) cs.run_end[k] = end;
+        for (uint8_t k = 2; k <= end - i; k++) candidates *= k;
+        i = end;
+    }
+    
+    cs.best_minterms = apply_transform(tt->minterms, num_vars, cs.perm, cs.negate);
+    cs.best_dont_cares = apply_transform(tt->dont_cares, num_vars, cs.perm, cs.negate);
+    memcpy(cs.best_perm, cs.perm, sizeof(cs.perm));
+    cs.best_negate = cs.negate;
+    
+    /* Too many symmetric inputs: keep the base transform, still a valid key */
+    if (candidates > 1 && candidates <= NPN_MAX_CANDIDATES) canon_permute(&cs, 0);
+    
+    canonical->minterms = cs.best_minterms;
+    canonical->dont_cares = cs.best_dont_cares;
+    canonical->num_vars = num_vars;
+    canonical->minterm_count = tt->minterm_count;
+    memcpy(perm, cs.best_perm, MAX_VARIABLES);
+    *negate = cs.best_negate;
+}
+
+int kmap_npn_cache_init(size_t entries) {
+    size_t capacity = NPN_PROBE;
+    while (capacity < entries) capacity <<= 1;
+    
+    npn_entry_t* table = calloc(capacity, sizeof(npn_entry_t));
+    if (!table) return -1;
+    
+    kmap_npn_cache_free();
+    npn_table = table;
+    npn_capacity = capacity;
+    
+    return 0;
+}
+
+void kmap_npn_cache_free(void) {
+    free(npn_table);
+    npn_table = NULL;
+    npn_capacity = 0;
+    
+    npn_lookups = npn_hits = npn_misses = npn_evictions = npn_used = 0;
+}
+
+void kmap_npn_cache_stats(kmap_cache_stats_t* stats) {
+    if (!stats) return;
+    
+    stats->lookups = __atomic_load_n(&npn_lookups, __ATOMIC_RELAXED);
+    stats->hits = __atomic_load_n(&npn_hits, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&npn_misses, __ATOMIC_RELAXED);
+    stats->evictions = __atomic_load_n(&npn_evictions, __ATOMIC_RELAXED);
+    stats->entries = npn_capacity;
+    stats->used = (size_t)__atomic_load_n(&npn_used, __ATOMIC_RELAXED);
+    stats->memory_bytes = npn_capacity * sizeof(npn_entry_t);
+}
+
+static inline uint64_t hash_key(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars) {
+    /* splitmix64 finalizer */
+    uint64_t h = minterms ^ (dont_cares * 0x9E3779B97F4A7C15ULL) ^ num_vars;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+static inline void entry_lock(npn_entry_t* entry) {
+    while (__atomic_test_and_set(&entry->lock, __ATOMIC_ACQUIRE)) {
+        /* spin - critical sections are a few dozen bytes */
+    }
+}
+
+static inline void entry_unlock(npn_entry_t* entry) {
+    __atomic_clear(&entry->lock, __ATOMIC_RELEASE);
+}
+
+static void npn_insert(const truth_table_t* canon, uint64_t hash, const solution_t* solution) {
+    size_t mask = npn_capacity - 1;
+    size_t base = (size_t)hash & mask;
+    npn_entry_t* victim = NULL;
+    
+    /* Empty or matching slot in the probe window, else evict one */
+    for (size_t p = 0; p < NPN_PROBE; p++) {
+        npn_entry_t* entry = &npn_table[(base + p) & mask];
+        entry_lock(entry);
+        if (entry->num_vars == 0 ||
+            (entry->num_vars == canon->num_vars && entry->minterms == canon->minterms &&
+             entry->dont_cares == canon->dont_cares)) {
+            victim = entry;
+            break;
+        }
+        entry_unlock(entry);
+    }
+    
+    if (!victim) {
+        victim = &npn_table[(base + (hash >> 32) % NPN_PROBE) & mask];
+        entry_lock(victim);
+        __atomic_fetch_add(&npn_evictions, 1, __ATOMIC_RELAXED);
+    } else if (victim->num_vars == 0) {
+        __atomic_fetch_add(&npn_used, 1, __ATOMIC_RELAXED);
+    }
+    
+    victim->minterms = canon->minterms;
+    victim->dont_cares = canon->dont_cares;
+    victim->num_vars = canon->num_vars;
+    victim->term_count = solution->implicant_count;
+    victim->optimal = solution->optimal;
+    for (uint8_t i = 0; i < solution->implicant_count; i++) {
+        victim->terms[i] = (uint16_t)((solution->implicants[i].literal_mask << 8) |
+                                      solution->implicants[i].literal_values);
+    }
+    
+    entry_unlock(victim);
+}
+
+int npn_cached_solve(const truth_table_t* tt, solution_t* solution,
+                     const kmap_options_t* opts) {
+    if (!npn_table) return solve_uncached(tt, solution, opts);
+    
+    truth_table_t canon;
+    uint8_t perm[MAX_VARIABLES];
+    uint8_t negate;
+    kmap_np_canonicalize(tt, &canon, perm, &negate);
+    
+    uint64_t hash = hash_key(canon.minterms, canon.dont_cares, canon.num_vars);
+    size_t mask = npn_capacity - 1;
+    size_t base = (size_t)hash & mask;
+    uint16_t terms[MAX_GROUPS];
+    uint8_t term_count = 0;
+    uint8_t optimal = 0;
+    bool hit = false;
+    
+    __atomic_fetch_add(&npn_lookups, 1, __ATOMIC_RELAXED);
+    
+    for (size_t p = 0; p < NPN_PROBE && !hit; p++) {
+        npn_entry_t* entry = &npn_table[(base + p) & mask];
+        entry_lock(entry);
+        if (entry->num_vars == canon.num_vars && entry->minterms == canon.minterms &&
+            entry->dont_cares == canon.dont_cares) {
+            term_count = entry->term_count;
+            optimal = entry->optimal;
+            memcpy(terms, entry->terms, term_count * sizeof(uint16_t));
+            hit = true;
+        }
+        entry_unlock(entry);
+    }
+    
+    if (hit) {
+        __atomic_fetch_add(&npn_hits, 1, __ATOMIC_RELAXED);
+        KMAP_STAT_ADD(cache_hits, 1);
+    } else {
+        KMAP_STAT_ADD(cache_misses, 1);
+        int result = solve_uncached(&canon, solution, opts);
+        if (result != 0) return result;
+        
+        __atomic_fetch_add(&npn_misses, 1, __ATOMIC_RELAXED);
+        /* A budget-limited cover must not be served to every NP-equivalent function */
+        if (solution->optimal) npn_insert(&canon, hash, solution);
+        
+        term_count = solution->implicant_count;
+        optimal = solution->optimal;
+        for (uint8_t i = 0; i < term_count; i++) {
+            terms[i] = (uint16_t)((solution->implicants[i].literal_mask << 8) |
+                                  solution->implicants[i].literal_values);
+        }
+    }
+    
+    np_expand_solution(tt, terms, term_count, optimal, perm, negate, solution);
+    return 0;
+}
+
+void np_expand_solution(const truth_table_t* tt, const uint16_t* terms, uint8_t term_count,
+                        uint8_t optimal, const uint8_t* perm, uint8_t negate,
+                        solution_t* solution) {
+    /* Canonical input i is original input perm[i], complemented if negated */
+    memset(solution, 0, sizeof(solution_t));
+    
+    for (uint8_t t = 0; t < term_count; t++) {
+        uint8_t canon_mask = terms[t] >> 8;
+        uint8_t canon_values = terms[t] & 0xFF;
+        implicant_t* imp = &solution->implicants[t];
+        
+        for (uint8_t i = 0; i < tt->num_vars; i++) {
+            if (!(canon_mask & (1 << i))) continue;
+            
+            uint8_t var = perm[i];
+            imp->literal_mask |= 1 << var;
+            if (((canon_values >> i) ^ (negate >> var)) & 1) imp->literal_values |= 1 << var;
+        }
+        
+        imp->covered_minterms = cube_coverage(imp->literal_mask, imp->literal_values,
+                                              tt->num_vars) & tt->minterms;
+        imp->size = popcount(imp->covered_minterms);
+        solution->literal_count += popcount(imp->literal_mask);
+    }
+    
+    solution->implicant_count = term_count;
+    solution->term_count = term_count;
+    solution->optimal = optimal;
+}
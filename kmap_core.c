@@ -6,74 +6,48 @@
  * Optimized for speed and minimal memory usage.
  */
 
-#include "kmap_core.h"
+#define _POSIX_C_SOURCE 200809L
+
+#include "kmap_internal.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <time.h>
 
 /* Forward declarations for static functions */
-static int parse_binary_string(const char* input, truth_table_t* tt);
-static int parse_minterm_list(const char* input, truth_table_t* tt);
-static int find_groups_with_dont_cares(uint64_t minterms, uint64_t dont_cares, 
-                                      uint8_t num_vars, implicant_t* groups, 
-                                      uint8_t* group_count);
-static bool is_valid_4cell_group(uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t num_vars);
-static void remove_redundant_implicants(solution_t* solution);
-
-/* === GRAY CODE LOOKUP TABLES === */
-/* Pre-computed for maximum speed */
-
-static const uint8_t gray_2var[4] = {0, 1, 3, 2};
-static const uint8_t gray_3var[8] = {0, 1, 3, 2, 6, 7, 5, 4};
-static const uint8_t gray_4var[16] = {
-    0, 1, 3, 2, 6, 7, 5, 4, 12, 13, 15, 14, 10, 11, 9, 8
-};
+static void remove_redundant_columns(const prime_set_t* set, uint32_t* selected,
+                                    uint32_t* selected_count);
+static int solve_truth_table(const truth_table_t* tt, solution_t* solution);
 
-/* Reverse lookup tables for Gray to linear conversion */
-static const uint8_t linear_2var[4] = {0, 1, 3, 2};
-static const uint8_t linear_3var[8] = {0, 1, 3, 2, 7, 6, 4, 5};
-static const uint8_t linear_4var[16] = {
-    0, 1, 3, 2, 7, 6, 4, 5, 15, 14, 12, 13, 8, 9, 11, 10
-};
+/**
+ * @brief Mask of all valid cells for a variable count
+ * 
+ * Avoids the undefined 1ULL << 64 shift for 6 variables.
+ */
+static inline uint64_t cell_mask(uint8_t num_vars) {
+    return (num_vars >= MAX_VARIABLES) ? ~0ULL : (1ULL << (1 << num_vars)) - 1;
+}
 
 /* === UTILITY FUNCTION IMPLEMENTATIONS === */
 
+/* Reflected Gray code is the same closed form for every width, so these
+ * only check the range instead of switching on num_vars */
+
 uint8_t linear_to_gray(uint8_t linear, uint8_t num_vars) {
-    if (linear >= (1 << num_vars)) return 0;
-    
-    switch (num_vars) {
-        case 2: return gray_2var[linear];
-        case 3: return gray_3var[linear];
-        case 4: return gray_4var[linear];
-        case 5: 
-        case 6:
-            /* For 5-6 variables, use algorithmic conversion */
-            return linear ^ (linear >> 1);
-        default:
-            return 0;
-    }
+    if (num_vars < 2 || num_vars > MAX_VARIABLES || linear >= (1 << num_vars)) return 0;
+    return linear ^ (linear >> 1);
 }
 
 uint8_t gray_to_linear(uint8_t gray, uint8_t num_vars) {
-    if (gray >= (1 << num_vars)) return 0;
+    if (num_vars < 2 || num_vars > MAX_VARIABLES || gray >= (1 << num_vars)) return 0;
     
-    switch (num_vars) {
-        case 2: return linear_2var[gray];
-        case 3: return linear_3var[gray];
-        case 4: return linear_4var[gray];
-        case 5:
-        case 6: {
-            /* Algorithmic conversion for larger cases */
-            uint8_t result = gray;
-            for (uint8_t i = 1; i < num_vars; i++) {
-                result ^= (gray >> i);
-            }
-            return result;
-        }
-        default:
-            return 0;
-    }
+    /* Prefix XOR of the higher bits; three steps cover 8 bits */
+    uint8_t linear = gray;
+    linear ^= linear >> 1;
+    linear ^= linear >> 2;
+    linear ^= linear >> 4;
+    return linear;
 }
 
 bool are_adjacent(uint8_t cell1, uint8_t cell2, uint8_t num_vars) {
@@ -92,7 +66,7 @@ bool validate_truth_table(const truth_table_t* tt) {
     if (!tt) return false;
     if (tt->num_vars < 2 || tt->num_vars > MAX_VARIABLES) return false;
     
-    uint64_t max_mask = (1ULL << (1 << tt->num_vars)) - 1;
+    uint64_t max_mask = cell_mask(tt->num_vars);
     
     /* Check that minterms and don't cares don't overlap */
     if (tt->minterms & tt->dont_cares) return false;
@@ -114,7 +88,12 @@ bool validate_solution(const truth_table_t* tt, const solution_t* solution) {
     
     /* Check that all implicants together cover exactly the minterms */
     for (uint8_t i = 0; i < solution->implicant_count; i++) {
-        covered |= solution->implicants[i].covered_minterms;
+        const implicant_t* imp = &solution->implicants[i];
+        
+        /* Each term must be a real implicant of minterms | dont_cares */
+        if (!is_implicant(tt, imp->literal_mask, imp->literal_values)) return false;
+        
+        covered |= imp->covered_minterms;
     }
     
     /* Must cover all minterms, no more, no less */
@@ -124,161 +103,527 @@ bool validate_solution(const truth_table_t* tt, const solution_t* solution) {
 /* === INPUT PARSING FUNCTIONS === */
 
 /**
- * @brief Detect input format and delegate to appropriate parser
+ * @brief Parse NUL-terminated input (see parse_input_n)
  */
 int parse_input(const char* input, truth_table_t* tt) {
+    if (!input) return -1;
+    return parse_input_n(input, SIZE_MAX, tt);
+}
+
+/**
+ * @brief Single-pass parser for every input format
+ * 
+ * Both interpretations are tracked at once, so the input is scanned once
+ * and nothing is copied or allocated:
+ * - binary string: each character is shifted in at bit 0, which leaves
+ *   the first character at the highest cell like the original parser
+ * - minterm list: numbers are OR-ed straight into the masks, with an
+ *   optional "d(...)" section of don't cares
+ * A comma or a d(...) section selects the list format. Expressions are
+ * tried only when neither format matches (see parse_input_n).
+ */
+static int parse_cells_n(const char* input, size_t len, truth_table_t* tt) {
     if (!input || !tt) return -1;
     
+    /* Bare 4-6 variable binary strings take the vectorized path */
+    size_t view = (len == SIZE_MAX) ? strnlen(input, MAX_CELLS + 1) : len;
+    if (view >= 16 && view <= MAX_CELLS && (view & (view - 1)) == 0 &&
+        parse_binary_n(input, view, tt) == 0) {
+        return 0;
+    }
+    
     /* Initialize truth table */
     memset(tt, 0, sizeof(truth_table_t));
     
-    /* Skip whitespace */
-    while (isspace(*input)) input++;
-    if (*input == '\0') return -1;
-    
-    /* Detect format */
-    if (strchr(input, ',')) {
-        /* Minterm list format: "0,1,3,5" */
-        return parse_minterm_list(input, tt);
-    } else if (strspn(input, "01Xx-") == strlen(input)) {
-        /* Binary string format: "10110" */
-        return parse_binary_string(input, tt);
-    } else {
-        /* Unknown format */
+    /* Binary string state */
+    uint64_t bin_ones = 0, bin_dont_cares = 0;
+    size_t bin_len = 0;
+    bool bin_ok = true;
+    
+    /* Minterm list state */
+    uint64_t list_masks[2] = {0, 0};            // [0] = minterms, [1] = don't cares
+    uint8_t section = 0;                        // 1 inside d(...)
+    uint32_t value = 0;
+    uint8_t max_cell = 0;
+    bool pending = false;                       // Number read, not yet stored
+    bool in_number = false;                     // Currently reading digits
+    bool need_paren = false;                    // Saw 'd', expecting '('
+    bool closed = false;                        // Saw the closing ')'
+    bool is_list = false;
+    bool list_ok = true;
+    bool seen_content = false;
+    bool trailing_space = false;
+    
+    for (size_t i = 0; i < len && input[i] != '\0'; i++) {
+        char c = input[i];
+        
+        if (isspace((unsigned char)c)) {
+            if (seen_content) trailing_space = true;
+            in_number = false;
+            continue;
+        }
+        
+        /* Binary strings may not contain interior whitespace */
+        if (trailing_space) bin_ok = false;
+        seen_content = true;
+        
+        if (bin_ok) {
+            bin_ones <<= 1;
+            bin_dont_cares <<= 1;
+            switch (c) {
+                case '1': bin_ones |= 1; break;
+                case '0': break;
+                case 'X':
+                case 'x':
+                case '-': bin_dont_cares |= 1; break;
+                default: bin_ok = false; break;
+            }
+            if (++bin_len > MAX_CELLS) bin_ok = false;
+        }
+        
+        if (!list_ok) {
+            if (!bin_ok) return -1;
+            continue;
+        }
+        
+        if (c >= '0' && c <= '9') {
+            /* Two numbers need a comma between them */
+            if ((pending && !in_number) || need_paren || closed) {
+                list_ok = false;
+                continue;
+            }
+            value = in_number ? value * 10 + (uint32_t)(c - '0') : (uint32_t)(c - '0');
+            if (value >= MAX_CELLS) list_ok = false;
+            pending = true;
+            in_number = true;
+            continue;
+        }
+        
+        in_number = false;
+        
+        /* Any separator stores the number before it */
+        if (pending) {
+            list_masks[section] |= 1ULL << value;
+            if (value > max_cell) max_cell = (uint8_t)value;
+            pending = false;
+        }
+        
+        switch (c) {
+            case ',':
+                if (need_paren || closed) list_ok = false;
+                is_list = true;
+                break;
+            case 'd':
+            case 'D':
+                if (section != 0) list_ok = false;
+                need_paren = true;
+                is_list = true;
+                break;
+            case '(':
+                if (!need_paren) list_ok = false;
+                need_paren = false;
+                section = 1;
+                break;
+            case ')':
+                if (section != 1 || closed) list_ok = false;
+                closed = true;
+                break;
+            default:
+                list_ok = false;
+                break;
+        }
+    }
+    
+    if (!seen_content) return -1;
+    
+    if (is_list && list_ok) {
+        /* Unterminated d(...) section */
+        if (need_paren || (section == 1 && !closed)) return -1;
+        
+        if (pending) {
+            list_masks[section] |= 1ULL << value;
+            if (value > max_cell) max_cell = (uint8_t)value;
+        }
+        
+        tt->minterms = list_masks[0];
+        tt->dont_cares = list_masks[1];
+        tt->minterm_count = popcount(tt->minterms);
+        
+        /* Determine number of variables from highest cell */
+        tt->num_vars = 2;
+        while ((1U << tt->num_vars) <= max_cell) tt->num_vars++;
+        
+        return 0;
+    }
+    
+    if (!bin_ok) return -1;
+    
+    /* Determine number of variables from string length */
+    uint8_t num_vars = 0;
+    while ((1U << num_vars) < bin_len) num_vars++;
+    
+    if ((1U << num_vars) != bin_len || num_vars < 2 || num_vars > MAX_VARIABLES) {
         return -1;
     }
+    
+    tt->num_vars = num_vars;
+    tt->minterms = bin_ones;
+    tt->dont_cares = bin_dont_cares;
+    tt->minterm_count = popcount(bin_ones);
+    
+    return 0;
+}
+
+int parse_input_n(const char* input, size_t len, truth_table_t* tt) {
+    int result = parse_cells_n(input, len, tt);
+    
+    /* Neither cells nor a list: it may be an expression */
+    if (result == -1 && input && tt) result = parse_expression_n(input, len, tt);
+    return result;
 }
 
+/* === MAIN SOLVING FUNCTION === */
+
 /**
- * @brief Parse binary string format
+ * @brief Solve an already parsed truth table
+ * 
+ * Shared by the string and batch entry points so a table is validated
+ * and solved exactly once.
  */
-static int parse_binary_string(const char* input, truth_table_t* tt) {
-    size_t len = strlen(input);
+static int solve_truth_table(const truth_table_t* tt, solution_t* solution) {
+    /* Find prime implicants (validates the table) */
+    int result = find_prime_implicants(tt, solution);
+    if (result != 0) return result;
     
-    /* Determine number of variables from string length */
-    uint8_t num_vars = 0;
-    while ((1U << num_vars) < len) num_vars++;
+    /* A cover that fails validation is a solver fault; -3 stays "buffer too small" */
+    if (!validate_solution(tt, solution)) return -4;
     
-    if ((1U << num_vars) != len || num_vars < 2 || num_vars > MAX_VARIABLES) {
-        return -1;
+    return 0;
+}
+
+/**
+ * @brief Terms first, then literals, as the cover search weighs them
+ */
+static inline uint32_t form_cost(uint32_t terms, uint32_t literals) {
+    return terms * TERM_COST + literals;
+}
+
+/**
+ * @brief Resolve KMAP_FORM_CHEAPEST once both costs are known (ties keep SOP)
+ */
+static inline int pick_form(int form, uint32_t sop_cost, uint32_t pos_cost) {
+    if (!(form & KMAP_FORM_CHEAPEST)) return form;
+    return (pos_cost < sop_cost) ? KMAP_FORM_POS : KMAP_FORM_SOP;
+}
+
+int emit_forms(const solution_t* sop, const solution_t* pos, const truth_table_t* tt, int form,
+               char separator, char* output, size_t output_len) {
+    bool map = (form & KMAP_FORM_MAP) != 0;
+    form &= ~KMAP_FORM_MAP;
+    if (form & KMAP_FORM_CHEAPEST) {
+        form = pick_form(form, form_cost(sop->term_count, sop->literal_count),
+                         form_cost(pos->term_count, pos->literal_count));
     }
     
-    tt->num_vars = num_vars;
-    tt->minterms = 0;
-    tt->dont_cares = 0;
-    tt->minterm_count = 0;
-    
-    /* Parse each character - reverse bit order for standard representation */
-    for (size_t i = 0; i < len; i++) {
-        uint64_t bit = 1ULL << (len - 1 - i);  /* Reverse bit order */
-        
-        switch (input[i]) {
-            case '1':
-                tt->minterms |= bit;
-                tt->minterm_count++;
-                break;
-            case '0':
-                /* Already 0, do nothing */
-                break;
-            case 'X':
-            case 'x':
-            case '-':
-                tt->dont_cares |= bit;
-                break;
-            default:
-                return -1; /* Invalid character */
-        }
+    uint8_t num_vars = tt->num_vars;
+    size_t used = 0;
+    
+    /* Grid of the first form written: groups of 1s, or of 0s for POS alone */
+    if (map) {
+        bool clauses = (form == KMAP_FORM_POS);
+        int needed = render_kmap(tt, clauses ? pos : sop, clauses, output, output_len);
+        if (needed < 0) return needed;
+        used = emit_chars(output, output_len, (size_t)needed, "\n", 1);
+    }
+    if (form & KMAP_FORM_SOP) {
+        bool room = used < output_len;
+        int needed = generate_sop_expression_n(sop, num_vars, room ? output + used : NULL,
+                                               room ? output_len - used : 0);
+        if (needed < 0) return needed;
+        used += (size_t)needed;
+    }
+    if (form == KMAP_FORM_BOTH) used = emit_chars(output, output_len, used, &separator, 1);
+    if (form & KMAP_FORM_POS) {
+        bool room = used < output_len;
+        int needed = generate_pos_expression_n(pos, num_vars, room ? output + used : NULL,
+                                               room ? output_len - used : 0);
+        if (needed < 0) return needed;
+        used += (size_t)needed;
     }
     
-    return 0;
+    return (int)used;
 }
 
 /**
- * @brief Parse minterm list format
+ * @brief emit_forms() for a table with more than 6 variables
  */
-static int parse_minterm_list(const char* input, truth_table_t* tt) {
-    char* input_copy = strdup(input);
-    if (!input_copy) return -1;
+static int solve_wide_forms(const kmap_wide_table_t* tt, int form, char separator,
+                            char* output, size_t output_len) {
+    kmap_wide_table_t off;
+    kmap_cover_t sop, pos;
+    int result = 0;
     
-    tt->minterms = 0;
-    tt->dont_cares = 0;
-    tt->minterm_count = 0;
+    /* Grids stop at 6 variables */
+    if (form & KMAP_FORM_MAP) return -1;
     
-    uint8_t max_minterm = 0;
-    char* token = strtok(input_copy, ",");
+    memset(&sop, 0, sizeof(sop));
+    memset(&pos, 0, sizeof(pos));
     
-    while (token) {
-        /* Skip whitespace */
-        while (isspace(*token)) token++;
-        
-        char* endptr;
-        long value = strtol(token, &endptr, 10);
-        
-        if (*endptr != '\0' || value < 0 || value >= MAX_CELLS) {
-            free(input_copy);
-            return -1;
+    if (form & (KMAP_FORM_SOP | KMAP_FORM_CHEAPEST)) {
+        result = solve_kmap_wide(tt, &sop, NULL);
+        if (result == 0 && !validate_wide_cover(tt, &sop)) result = -4;
+    }
+    
+    /* POS clauses come from the off-set of the same table */
+    if (result == 0 && (form & (KMAP_FORM_POS | KMAP_FORM_CHEAPEST))) {
+        result = kmap_wide_table_complement(tt, &off);
+        if (result == 0) {
+            result = solve_kmap_wide(&off, &pos, NULL);
+            if (result == 0 && !validate_wide_cover(&off, &pos)) result = -4;
+            kmap_wide_table_free(&off);
         }
+    }
+    
+    if (result == 0) {
+        KMAP_STAGE_START(emit_start);
+        form = pick_form(form, form_cost(sop.count, sop.literal_count),
+                         form_cost(pos.count, pos.literal_count));
         
-        uint8_t minterm = (uint8_t)value;
-        if (minterm > max_minterm) max_minterm = minterm;
+        size_t used = 0;
+        int needed = 0;
         
-        tt->minterms |= (1ULL << minterm);
-        tt->minterm_count++;
+        if (form & KMAP_FORM_SOP) {
+            needed = generate_sop_expression_wide(&sop, tt->num_vars, output, output_len);
+            if (needed >= 0) used = (size_t)needed;
+        }
+        if (needed >= 0 && form == KMAP_FORM_BOTH) {
+            used = emit_chars(output, output_len, used, &separator, 1);
+        }
+        if (needed >= 0 && (form & KMAP_FORM_POS)) {
+            bool room = used < output_len;
+            needed = generate_pos_expression_wide(&pos, tt->num_vars, room ? output + used : NULL,
+                                                  room ? output_len - used : 0);
+            if (needed >= 0) used += (size_t)needed;
+        }
         
-        token = strtok(NULL, ",");
+        result = (needed < 0) ? needed : (int)used;
+        KMAP_STAGE_STOP(KMAP_STAGE_EMIT, emit_start);
     }
     
-    free(input_copy);
+    kmap_cover_free(&pos);
+    kmap_cover_free(&sop);
+    return result;
+}
+
+/**
+ * @brief Both narrow forms of a parsed table, emitted
+ */
+static int solve_narrow_forms(const truth_table_t* tt, int form, char separator,
+                              char* output, size_t output_len) {
+    solution_t sop, pos;
+    
+    /* Only the forms that are needed */
+    bool want_sop = (form & (KMAP_FORM_SOP | KMAP_FORM_CHEAPEST)) != 0;
+    bool want_pos = (form & (KMAP_FORM_POS | KMAP_FORM_CHEAPEST)) != 0;
+    int result = solve_kmap_dual(tt, want_sop ? &sop : NULL, want_pos ? &pos : NULL, NULL);
+    if (result != 0) return result;
     
-    /* Determine number of variables from highest minterm */
-    tt->num_vars = 2;
-    while ((1U << tt->num_vars) <= max_minterm) tt->num_vars++;
+    KMAP_STAGE_START(emit_start);
+    result = emit_forms(&sop, &pos, tt, form, separator, output, output_len);
+    KMAP_STAGE_STOP(KMAP_STAGE_EMIT, emit_start);
+    return result;
+}
+
+int solve_table_forms(const kmap_wide_table_t* tt, int form, char separator,
+                      char* output, size_t output_len) {
+    if (!tt || (!output && output_len > 0) || !kmap_form_valid(form)) return -1;
+    if (!validate_wide_table(tt)) return -2;
     
-    if (tt->num_vars > MAX_VARIABLES) return -1;
+    if (tt->num_vars > MAX_VARIABLES) {
+        return solve_wide_forms(tt, form, separator, output, output_len);
+    }
     
-    return 0;
+    truth_table_t narrow;
+    int result = init_truth_table(tt->minterms[0], tt->dont_cares[0], tt->num_vars, &narrow);
+    if (result != 0) return result;
+    
+    return solve_narrow_forms(&narrow, form, separator, output, output_len);
 }
 
-/* === MAIN SOLVING FUNCTION === */
+int solve_forms_n(const char* input, size_t len, int form, char separator,
+                  char* output, size_t output_len) {
+    if (!input || (!output && output_len > 0) || !kmap_form_valid(form)) return -1;
+    
+    truth_table_t tt;
+    
+    /* Parse input; more than 64 cells goes to the multi-word solver */
+    KMAP_STAGE_START(parse_start);
+    int result = parse_input_n(input, len, &tt);
+    KMAP_STAGE_STOP(KMAP_STAGE_PARSE, parse_start);
+    if (result == -1) {
+        kmap_wide_table_t wide;
+        KMAP_STAGE_START(wide_parse_start);
+        result = parse_input_wide(input, len, &wide);
+        KMAP_STAGE_STOP(KMAP_STAGE_PARSE, wide_parse_start);
+        if (result != 0) return result;
+        
+        result = solve_wide_forms(&wide, form, separator, output, output_len);
+        kmap_wide_table_free(&wide);
+        return result;
+    }
+    if (result != 0) return result;
+    
+    return solve_narrow_forms(&tt, form, separator, output, output_len);
+}
 
 int solve_kmap(const char* input, char* output, int output_len) {
+    return solve_kmap_form(input, KMAP_FORM_SOP, output, output_len);
+}
+
+int solve_kmap_form(const char* input, int form, char* output, int output_len) {
     if (!input || !output || output_len <= 0) return -1;
     
-    truth_table_t tt;
-    solution_t solution;
+    int needed = solve_forms_n(input, SIZE_MAX, form, '\n', output, (size_t)output_len);
+    if (needed < 0) return needed;
     
-    /* Parse input */
-    int result = parse_input(input, &tt);
-    if (result != 0) return result;
+    return (needed < output_len) ? 0 : -3; /* Buffer too small */
+}
+
+/* === BATCH SOLVING FUNCTIONS === */
+
+int init_truth_table(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars,
+                     truth_table_t* tt) {
+    if (!tt) return -1;
+    
+    tt->minterms = minterms;
+    tt->dont_cares = dont_cares;
+    tt->num_vars = num_vars;
+    tt->minterm_count = popcount(minterms);
     
-    /* Validate parsed truth table */
-    if (!validate_truth_table(&tt)) return -2;
+    return validate_truth_table(tt) ? 0 : -2;
+}
+
+int solve_kmap_batch(const truth_table_t* tables, size_t count,
+                     solution_t* solutions, int* status) {
+    if ((!tables || !solutions) && count > 0) return -1;
     
-    /* Handle trivial cases */
-    if (tt.minterm_count == 0) {
-        strncpy(output, "0", output_len - 1);
-        output[output_len - 1] = '\0';
-        return 0;
+    int first_error = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        int result = solve_truth_table(&tables[i], &solutions[i]);
+        
+        if (status) status[i] = result;
+        if (result != 0 && first_error == 0) first_error = result;
     }
     
-    if (tt.minterms == ((1ULL << (1 << tt.num_vars)) - 1)) {
-        strncpy(output, "1", output_len - 1);
-        output[output_len - 1] = '\0';
-        return 0;
+    return first_error;
+}
+
+int solve_kmap_batch_sop(const truth_table_t* tables, size_t count,
+                         char* arena, size_t arena_len,
+                         size_t* offsets, int* status) {
+    if ((!tables || !arena || !offsets) && count > 0) return -1;
+    
+    int first_error = 0;
+    size_t used = 0;
+    solution_t solution;
+    
+    for (size_t i = 0; i < count; i++) {
+        int result = solve_truth_table(&tables[i], &solution);
+        
+        if (result == 0) {
+            /* Write straight into the arena; a short tail still reports the size */
+            size_t space = arena_len - used;
+            int needed = generate_sop_expression_n(&solution, tables[i].num_vars,
+                                                   arena + used, space);
+            if (needed < 0) {
+                result = needed;
+            } else if ((size_t)needed >= space) {
+                result = -3;
+            } else {
+                offsets[i] = used;
+                used += (size_t)needed + 1;
+            }
+        }
+        
+        if (result != 0) {
+            offsets[i] = (size_t)-1;
+            if (first_error == 0) first_error = result;
+        }
+        
+        if (status) status[i] = result;
     }
     
-    /* Find prime implicants */
-    result = find_prime_implicants(&tt, &solution);
-    if (result != 0) return result;
+    return first_error;
+}
+
+int solve_kmap_batch_packed(const truth_table_t* tables, size_t count,
+                            uint8_t* arena, size_t arena_len,
+                            size_t* offsets, int* status) {
+    if ((!tables || !arena || !offsets) && count > 0) return -1;
     
-    /* Validate solution */
-    if (!validate_solution(&tt, &solution)) return -3;
+    int first_error = 0;
+    size_t used = 0;
+    solution_t solution;
     
-    /* Generate SOP expression */
-    result = generate_sop_expression(&solution, tt.num_vars, output, output_len);
-    if (result != 0) return result;
+    for (size_t i = 0; i < count; i++) {
+        int result = solve_truth_table(&tables[i], &solution);
+        
+        if (result == 0) {
+            size_t space = arena_len - used;
+            int needed = pack_solution(&solution, tables[i].num_vars, arena + used, space);
+            if (needed < 0) {
+                result = needed;
+            } else if ((size_t)needed > space) {
+                result = -3;
+            } else {
+                offsets[i] = used;
+                used += (size_t)needed;
+            }
+        }
+        
+        if (result != 0) {
+            offsets[i] = (size_t)-1;
+            if (first_error == 0) first_error = result;
+        }
+        
+        if (status) status[i] = result;
+    }
     
-    return 0;
+    return first_error;
+}
+
+int solve_kmap_batch_arrays(const uint64_t* minterms, const uint64_t* dont_cares,
+                            size_t count, uint8_t num_vars, kmap_array_result_t* results) {
+    if ((!minterms || !results) && count > 0) return -1;
+    
+    int first_error = 0;
+    truth_table_t tt;
+    solution_t solution;
+    
+    for (size_t i = 0; i < count; i++) {
+        kmap_array_result_t* out = &results[i];
+        memset(out, 0, sizeof(kmap_array_result_t));
+        
+        int result = init_truth_table(minterms[i], dont_cares ? dont_cares[i] : 0, num_vars, &tt);
+        if (result == 0) result = solve_truth_table(&tt, &solution);
+        
+        if (result == 0) {
+            out->term_count = solution.term_count;
+            out->literal_count = solution.literal_count;
+            out->optimal = solution.optimal;
+            for (int t = 0; t < solution.implicant_count; t++) {
+                out->cubes[t] = (uint16_t)(solution.implicants[t].literal_mask |
+                                           solution.implicants[t].literal_values << 8);
+            }
+        } else if (first_error == 0) {
+            first_error = result;
+        }
+        
+        out->status = (int8_t)result;
+    }
+    
+    return first_error;
 }
 
 /* === DEBUG FUNCTIONS === */
@@ -329,201 +674,693 @@ void debug_print_solution(const solution_t* solution, uint8_t num_vars) {
 
 /* === CORE GROUPING ALGORITHM === */
 
+static const uint64_t var_masks[MAX_VARIABLES] = {
+    VAR_MASK_0, VAR_MASK_1, VAR_MASK_2, VAR_MASK_3, VAR_MASK_4, VAR_MASK_5
+};
+
+/* === CUBE COVERAGE TABLE === */
+/*
+ * Cubes are encoded in base 3, one digit per variable:
+ * 0 = complemented literal, 1 = true literal, 2 = variable absent.
+ * The compiler expands the macros below into all 3^6 coverage masks.
+ */
+
+#define CUBE_DIGIT(var, d) \
+    ((d) == 0 ? ~VAR_MASK_##var : (d) == 1 ? VAR_MASK_##var : ~0ULL)
+#define CUBE_CELLS(d5, d4, d3, d2, d1, d0) \
+    (CUBE_DIGIT(0, d0) & CUBE_DIGIT(1, d1) & CUBE_DIGIT(2, d2) & \
+     CUBE_DIGIT(3, d3) & CUBE_DIGIT(4, d4) & CUBE_DIGIT(5, d5))
+#define CUBE_ROW0(d5, d4, d3, d2, d1) \
+    CUBE_CELLS(d5, d4, d3, d2, d1, 0), CUBE_CELLS(d5, d4, d3, d2, d1, 1), \
+    CUBE_CELLS(d5, d4, d3, d2, d1, 2)
+#define CUBE_ROW1(d5, d4, d3, d2) \
+    CUBE_ROW0(d5, d4, d3, d2, 0), CUBE_ROW0(d5, d4, d3, d2, 1), CUBE_ROW0(d5, d4, d3, d2, 2)
+#define CUBE_ROW2(d5, d4, d3) \
+    CUBE_ROW1(d5, d4, d3, 0), CUBE_ROW1(d5, d4, d3, 1), CUBE_ROW1(d5, d4, d3, 2)
+#define CUBE_ROW3(d5, d4) \
+    CUBE_ROW2(d5, d4, 0), CUBE_ROW2(d5, d4, 1), CUBE_ROW2(d5, d4, 2)
+#define CUBE_ROW4(d5) \
+    CUBE_ROW3(d5, 0), CUBE_ROW3(d5, 1), CUBE_ROW3(d5, 2)
+
+static const uint64_t cube_table[MAX_CUBES] = {
+    CUBE_ROW4(0), CUBE_ROW4(1), CUBE_ROW4(2)
+};
+
+/* Sum of 3^v over the variables in a 6-bit set */
+#define TERNARY_WEIGHT(b) \
+    (((b) & 1) + (((b) >> 1) & 1) * 3 + (((b) >> 2) & 1) * 9 + \
+     (((b) >> 3) & 1) * 27 + (((b) >> 4) & 1) * 81 + (((b) >> 5) & 1) * 243)
+#define TERNARY_WEIGHT4(b) \
+    TERNARY_WEIGHT(b), TERNARY_WEIGHT(b + 1), TERNARY_WEIGHT(b + 2), TERNARY_WEIGHT(b + 3)
+#define TERNARY_WEIGHT16(b) \
+    TERNARY_WEIGHT4(b), TERNARY_WEIGHT4(b + 4), TERNARY_WEIGHT4(b + 8), TERNARY_WEIGHT4(b + 12)
+
+static const uint16_t ternary_weight[MAX_CELLS] = {
+    TERNARY_WEIGHT16(0), TERNARY_WEIGHT16(16), TERNARY_WEIGHT16(32), TERNARY_WEIGHT16(48)
+};
+
+/**
+ * @brief Base-3 index of a cube: literal value where present, 2 where absent
+ */
+static inline uint16_t cube_code(uint8_t literal_mask, uint8_t literal_values) {
+    literal_mask &= MAX_CELLS - 1;
+    return ternary_weight[literal_values & literal_mask] +
+           2 * ternary_weight[~literal_mask & (MAX_CELLS - 1)];
+}
+
+/**
+ * @brief Cells covered by the cube (literal_mask, literal_values)
+ */
+static inline uint64_t cube_cells(uint8_t literal_mask, uint8_t literal_values, uint8_t num_vars) {
+    return cube_table[cube_code(literal_mask, literal_values)] & cell_mask(num_vars);
+}
+
+uint16_t cube_index(uint8_t literal_mask, uint8_t literal_values) {
+    return cube_code(literal_mask, literal_values);
+}
+
+uint64_t cube_coverage(uint8_t literal_mask, uint8_t literal_values, uint8_t num_vars) {
+    if (num_vars > MAX_VARIABLES) return 0;
+    return cube_cells(literal_mask, literal_values, num_vars);
+}
+
+bool is_implicant(const truth_table_t* tt, uint8_t literal_mask, uint8_t literal_values) {
+    if (!tt || tt->num_vars > MAX_VARIABLES) return false;
+    
+    /* Single AND-compare against the allowed cells */
+    uint64_t cells = cube_cells(literal_mask, literal_values, tt->num_vars);
+    return (cells & ~(tt->minterms | tt->dont_cares)) == 0;
+}
+
+/* === PRIME IMPLICANT GENERATION === */
+
 /**
- * @brief Correct don't care aware grouping algorithm
+ * @brief Move every cell to its neighbour across one variable
+ */
+static inline uint64_t swap_variable(uint64_t cells, uint8_t var) {
+    uint8_t shift = 1 << var;
+    return ((cells & var_masks[var]) >> shift) | ((cells << shift) & var_masks[var]);
+}
+
+/**
+ * @brief Bit-parallel Quine-McCluskey prime implicant generation
+ * 
+ * implicants[free] has bit m set when the cube through cell m with the
+ * variables in 'free' eliminated lies entirely inside minterms | dont_cares.
+ * Merging cubes across variable v is one AND with the vector swapped along
+ * v, so each column of the classic QM table costs a few 64-bit operations
+ * and all 2^n variable subsets are visited exactly once.
+ * 
+ * A cube is prime when no single merge extends it. Primes made only of
+ * don't cares are dropped since they never help the cover.
  * 
- * This algorithm properly implements don't care optimization:
- * 1. Only covers required minterms (not don't cares)
- * 2. Uses don't cares to form larger, more optimal groups
- * 3. Each don't care can be treated as 0 or 1 to maximize benefit
+ * Always inlined into one kernel per variable count, so num_vars is a
+ * constant: the subset and variable loops unroll, and the cell masks and
+ * swap shifts fold into immediates.
  */
-static int find_groups_with_dont_cares(uint64_t minterms, uint64_t dont_cares, 
-                                      uint8_t num_vars, implicant_t* groups, 
-                                      uint8_t* group_count) {
-    uint64_t remaining_minterms = minterms;  /* Only these need to be covered */
-    uint64_t available_for_grouping = minterms | dont_cares;  /* These can be used in groups */
-    uint64_t total_cells = (1ULL << num_vars);
-    
-    *group_count = 0;
-    
-    /* First pass: find pairs that include at least one required minterm */
-    for (uint8_t cell1 = 0; cell1 < total_cells && *group_count < MAX_GROUPS; cell1++) {
-        if (!(available_for_grouping & (1ULL << cell1))) continue;
-        if (!(remaining_minterms & (1ULL << cell1))) continue; /* Must start with a required minterm */
-        
-        /* Look for adjacent cells to form pairs */
-        for (uint8_t cell2 = cell1 + 1; cell2 < total_cells; cell2++) {
-            if (!(available_for_grouping & (1ULL << cell2))) continue;
+static inline __attribute__((always_inline))
+uint16_t prime_kernel(uint64_t minterms, uint64_t dont_cares, const uint8_t num_vars,
+                      prime_set_t* set) {
+    uint64_t implicants[MAX_CELLS];
+    const uint8_t all_vars = (1 << num_vars) - 1;
+    uint16_t prime_count = 0;
+    
+    /* Level 0 is the cells themselves; each level adds one free variable */
+    implicants[0] = minterms | dont_cares;
+    for (uint16_t free = 1; free <= all_vars; free++) {
+        uint64_t base = implicants[free & (free - 1)];
+        implicants[free] = base & swap_variable(base, ctz(free));
+    }
+    
+    for (uint16_t free = 0; free <= all_vars; free++) {
+        uint64_t cubes = implicants[free];
+        if (!cubes) continue;
+        
+        /* Drop cubes that still merge, keep one representative cell each */
+        uint64_t representatives = cell_mask(num_vars);
+        for (uint8_t var = 0; var < num_vars; var++) {
+            if (free & (1 << var)) {
+                representatives &= ~var_masks[var];
+            } else {
+                cubes &= ~implicants[free | (1 << var)];
+            }
+        }
+        KMAP_STAT_ADD(cubes_examined, popcount(implicants[free] & representatives));
+        cubes &= representatives;
+        
+        while (cubes) {
+            uint8_t cell = ctz(cubes);
+            cubes &= cubes - 1;
+            
+            uint8_t literal_mask = all_vars & ~free;
+            uint8_t literal_values = cell & literal_mask;
+            uint64_t covered = cube_cells(literal_mask, literal_values, num_vars) & minterms;
+            
+            /* Don't care only - never needed */
+            if (!covered) continue;
             
-            /* Check if they're adjacent (differ by exactly 1 bit) */
-            if (are_adjacent(cell1, cell2, num_vars)) {
-                /* Found a pair - create implicant */
-                uint8_t diff = cell1 ^ cell2;
-                uint64_t group_mask = (1ULL << cell1) | (1ULL << cell2);
+            set->covered[prime_count] = covered;
+            set->cost[prime_count] = (uint16_t)(TERM_COST + popcount(literal_mask));
+            set->literal_mask[prime_count] = literal_mask;
+            set->literal_values[prime_count] = literal_values;
+            prime_count++;
+        }
+    }
+    
+    return prime_count;
+}
+
+#define DEFINE_PRIME_KERNEL(n) \
+    static uint16_t prime_kernel_##n(uint64_t minterms, uint64_t dont_cares, \
+                                     prime_set_t* set) { \
+        return prime_kernel(minterms, dont_cares, n, set); \
+    }
+
+DEFINE_PRIME_KERNEL(2)
+DEFINE_PRIME_KERNEL(3)
+DEFINE_PRIME_KERNEL(4)
+DEFINE_PRIME_KERNEL(5)
+DEFINE_PRIME_KERNEL(6)
+
+uint16_t generate_prime_set(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars,
+                            prime_set_t* set) {
+    switch (num_vars) {
+        case 2: return prime_kernel_2(minterms, dont_cares, set);
+        case 3: return prime_kernel_3(minterms, dont_cares, set);
+        case 4: return prime_kernel_4(minterms, dont_cares, set);
+        case 5: return prime_kernel_5(minterms, dont_cares, set);
+        case 6: return prime_kernel_6(minterms, dont_cares, set);
+        default: return 0;
+    }
+}
+
+uint16_t generate_prime_implicants(uint64_t minterms, uint64_t dont_cares,
+                                   uint8_t num_vars, implicant_t* primes) {
+    prime_set_t set;
+    uint16_t prime_count = generate_prime_set(minterms, dont_cares, num_vars, &set);
+    
+    for (uint16_t i = 0; i < prime_count; i++) {
+        primes[i].covered_minterms = set.covered[i];
+        primes[i].literal_mask = set.literal_mask[i];
+        primes[i].literal_values = set.literal_values[i];
+        primes[i].size = popcount(set.covered[i]);
+    }
+    return prime_count;
+}
+
+/* === EXACT MINIMUM COVER === */
+
+/* Nodes between deadline checks */
+#define TIME_CHECK_INTERVAL 256
+
+static kmap_options_t default_options = {
+    KMAP_DEFAULT_NODE_LIMIT,
+    KMAP_DEFAULT_TIME_LIMIT_US,
+    KMAP_DEFAULT_FLAGS
+};
+
+void kmap_default_options(kmap_options_t* opts) {
+    if (!opts) return;
+    
+    opts->cover_node_limit = KMAP_DEFAULT_NODE_LIMIT;
+    opts->cover_time_limit_us = KMAP_DEFAULT_TIME_LIMIT_US;
+    opts->flags = KMAP_DEFAULT_FLAGS;
+}
+
+void kmap_set_options(const kmap_options_t* opts) {
+    if (opts) {
+        default_options = *opts;
+    } else {
+        kmap_default_options(&default_options);
+    }
+}
+
+void kmap_get_options(kmap_options_t* opts) {
+    if (opts) *opts = default_options;
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Branch-and-bound state over the cyclic core
+ */
+typedef struct {
+    uint64_t cover[MAX_CUBES] __attribute__((aligned(64))); // Rows covered by each column
+    uint16_t cost[MAX_CUBES];                   // TERM_COST + literals
+    uint32_t index[MAX_CUBES];                  // Original column index
+    uint8_t banned[MAX_CUBES];                  // Excluded on this branch
+    uint32_t count;
+    
+    uint32_t path[MAX_CELLS];                   // Columns on current branch
+    uint32_t best[MAX_CELLS];                   // Cheapest cover found
+    uint32_t best_len;
+    uint32_t best_cost;
+    
+    uint64_t nodes;
+    uint64_t node_limit;                        // 0 = unlimited
+    uint64_t deadline_ns;                       // 0 = unlimited
+    bool aborted;
+} cover_search_t;
+
+/**
+ * @brief Reduce the covering problem to its cyclic core
+ * 
+ * Repeats essential column extraction, row dominance and column dominance
+ * until nothing changes. Essential choices are appended to selected.
+ * 
+ * @return false if some row cannot be covered
+ */
+static bool reduce_cover(cover_search_t* cs, uint64_t* remaining,
+                         uint32_t* selected, uint32_t* selected_count) {
+    uint64_t rows = *remaining;
+    bool changed = true;
+    
+    while (changed && rows) {
+        changed = false;
+        
+        /* Essential columns: the only cover of some row */
+        uint64_t once = 0, twice = 0;
+        for (uint32_t i = 0; i < cs->count; i++) {
+            twice |= once & cs->cover[i];
+            once |= cs->cover[i];
+        }
+        if (rows & ~once) return false;
+        
+        uint64_t essential = once & ~twice & rows;
+        for (uint32_t i = 0; i < cs->count && essential; i++) {
+            if (!(cs->cover[i] & essential)) continue;
+            
+            selected[(*selected_count)++] = cs->index[i];
+            rows &= ~cs->cover[i];
+            essential &= ~cs->cover[i];
+            cs->cover[i] = 0;
+            changed = true;
+        }
+        
+        /* Row dominance: covering r always covers every row in implied */
+        uint64_t pending = rows;
+        while (pending) {
+            uint8_t row = ctz(pending);
+            pending &= pending - 1;
+            if (!(rows & (1ULL << row))) continue;
+            
+            uint64_t implied = rows;
+            for (uint32_t i = 0; i < cs->count; i++) {
+                if (cs->cover[i] & (1ULL << row)) implied &= cs->cover[i];
+            }
+            
+            implied &= ~(1ULL << row);
+            if (implied) {
+                rows &= ~implied;
+                changed = true;
+            }
+        }
+        
+        /* Column dominance: drop columns no better than another one */
+        for (uint32_t i = 0; i < cs->count; i++) cs->cover[i] &= rows;
+        
+        for (uint32_t i = 0; i < cs->count; i++) {
+            uint64_t cov = cs->cover[i];
+            if (!cov) continue;
+            
+            /* Only supersets of column i can dominate it; most columns are not */
+            for (uint32_t j = find_superset_column(cs->cover, 0, cs->count, cov); j < cs->count;
+                 j = find_superset_column(cs->cover, j + 1, cs->count, cov)) {
+                if (i == j || cs->cost[j] > cs->cost[i]) continue;
                 
-                groups[*group_count].covered_minterms = group_mask & minterms; /* Only count actual minterms */
-                groups[*group_count].literal_mask = ((1 << num_vars) - 1) & ~diff;
-                groups[*group_count].literal_values = cell1 & groups[*group_count].literal_mask;
-                groups[*group_count].size = popcount(groups[*group_count].covered_minterms);
+                /* Identical columns: keep the lower index */
+                if (cov == cs->cover[j] && cs->cost[j] == cs->cost[i] && j > i) continue;
                 
-                /* Only add if this group covers at least one required minterm */
-                if (groups[*group_count].covered_minterms != 0) {
-                    (*group_count)++;
-                    
-                    /* Remove covered minterms from remaining */
-                    remaining_minterms &= ~groups[*group_count - 1].covered_minterms;
-                    
-                    /* Remove used cells from available to prevent reuse */
-                    available_for_grouping &= ~group_mask;
-                    break; /* Move to next cell1 */
-                }
+                cs->cover[i] = 0;
+                changed = true;
+                break;
             }
         }
+        
+        /* Compact surviving columns */
+        uint32_t write = 0;
+        for (uint32_t i = 0; i < cs->count; i++) {
+            if (!cs->cover[i]) continue;
+            cs->cover[write] = cs->cover[i];
+            cs->cost[write] = cs->cost[i];
+            cs->index[write] = cs->index[i];
+            write++;
+        }
+        cs->count = write;
     }
     
-    /* Try to find larger groups (4-cell groups) for remaining minterms */
-    for (uint8_t cell1 = 0; cell1 < total_cells && *group_count < MAX_GROUPS && remaining_minterms; cell1++) {
-        if (!(remaining_minterms & (1ULL << cell1))) continue;
+    *remaining = rows;
+    return true;
+}
+
+/**
+ * @brief Greedy cover of the core, used as the initial upper bound
+ */
+static void greedy_cover(cover_search_t* cs, uint64_t rows) {
+    cs->best_len = 0;
+    cs->best_cost = 0;
+    
+    while (rows) {
+        uint32_t best = 0;
+        uint8_t best_gain = 0;
         
-        /* Look for groups of 4 adjacent cells */
-        for (uint8_t cell2 = cell1 + 1; cell2 < total_cells; cell2++) {
-            if (!are_adjacent(cell1, cell2, num_vars)) continue;
-            if (!(available_for_grouping & (1ULL << cell2))) continue;
-            
-            for (uint8_t cell3 = cell2 + 1; cell3 < total_cells; cell3++) {
-                if (!are_adjacent(cell1, cell3, num_vars) && !are_adjacent(cell2, cell3, num_vars)) continue;
-                if (!(available_for_grouping & (1ULL << cell3))) continue;
-                
-                for (uint8_t cell4 = cell3 + 1; cell4 < total_cells; cell4++) {
-                    if (!(available_for_grouping & (1ULL << cell4))) continue;
-                    
-                    /* Check if all 4 cells form a valid rectangle */
-                    uint64_t group_mask = (1ULL << cell1) | (1ULL << cell2) | (1ULL << cell3) | (1ULL << cell4);
-                    uint8_t diff_bits = cell1 ^ cell2 ^ cell3 ^ cell4;
-                    
-                    /* For a valid 4-cell group, exactly 2 variables should differ */
-                    if (popcount(diff_bits) == 2 && is_valid_4cell_group(cell1, cell2, cell3, cell4, num_vars)) {
-                        uint64_t covered_minterms = group_mask & minterms;
-                        
-                        if (covered_minterms != 0) {
-                            groups[*group_count].covered_minterms = covered_minterms;
-                            groups[*group_count].literal_mask = ((1 << num_vars) - 1) & ~diff_bits;
-                            groups[*group_count].literal_values = cell1 & groups[*group_count].literal_mask;
-                            groups[*group_count].size = popcount(covered_minterms);
-                            
-                            (*group_count)++;
-                            remaining_minterms &= ~covered_minterms;
-                            available_for_grouping &= ~group_mask;
-                            goto next_cell1; /* Found a 4-cell group, move on */
-                        }
-                    }
-                }
+        for (uint32_t i = 0; i < cs->count; i++) {
+            uint8_t gain = popcount(cs->cover[i] & rows);
+            if (gain > best_gain || (gain == best_gain && gain > 0 && cs->cost[i] < cs->cost[best])) {
+                best = i;
+                best_gain = gain;
             }
         }
-        next_cell1:;
+        
+        cs->best[cs->best_len++] = best;
+        cs->best_cost += cs->cost[best];
+        rows &= ~cs->cover[best];
     }
+}
+
+/**
+ * @brief Recursive branch-and-bound over the remaining rows
+ * 
+ * Branches on the row with the fewest live columns. Per-row column counts
+ * are kept in bit-sliced counters so choosing the row costs a few ANDs
+ * per column. The bound is popcount(rows) / best column gain.
+ */
+static void cover_search(cover_search_t* cs, uint64_t rows, uint32_t depth, uint32_t cost) {
+    if (cs->aborted) return;
     
-    /* Final pass: individual minterms that couldn't be grouped */
-    for (uint8_t cell = 0; cell < total_cells && *group_count < MAX_GROUPS; cell++) {
-        if (remaining_minterms & (1ULL << cell)) {
-            /* Single cell implicant */
-            groups[*group_count].covered_minterms = (1ULL << cell);
-            groups[*group_count].literal_mask = (1 << num_vars) - 1;
-            groups[*group_count].literal_values = cell;
-            groups[*group_count].size = 1;
-            
-            (*group_count)++;
+    if (!rows) {
+        if (cost < cs->best_cost) {
+            memcpy(cs->best, cs->path, depth * sizeof(uint32_t));
+            cs->best_len = depth;
+            cs->best_cost = cost;
         }
+        return;
+    }
+    
+    cs->nodes++;
+    if (cs->node_limit && cs->nodes > cs->node_limit) {
+        cs->aborted = true;
+        return;
+    }
+    if (cs->deadline_ns && (cs->nodes % TIME_CHECK_INTERVAL) == 0 &&
+        monotonic_ns() > cs->deadline_ns) {
+        cs->aborted = true;
+        return;
+    }
+    
+    /* Saturating 2-bit counts of live columns per row, plus bound inputs */
+    uint64_t count0 = 0, count1 = 0, many = 0;
+    uint8_t max_gain = 0;
+    uint16_t min_cost = UINT16_MAX;
+    
+    for (uint32_t i = 0; i < cs->count; i++) {
+        if (cs->banned[i]) continue;
+        
+        uint64_t cov = cs->cover[i] & rows;
+        if (!cov) continue;
+        
+        uint64_t carry = count0 & cov;
+        count0 ^= cov;
+        many |= count1 & carry;
+        count1 ^= carry;
+        
+        uint8_t gain = popcount(cov);
+        if (gain > max_gain) max_gain = gain;
+        if (cs->cost[i] < min_cost) min_cost = cs->cost[i];
     }
     
-    return *group_count;
+    /* Row nobody covers any more - dead branch */
+    if (rows & ~(count0 | count1 | many)) return;
+    
+    uint32_t needed = (popcount(rows) + max_gain - 1) / max_gain;
+    if (cost + needed * min_cost >= cs->best_cost) return;
+    
+    /* Prefer a row with exactly one, then two, live columns */
+    uint64_t pick = rows & count0 & ~count1 & ~many;
+    if (!pick) pick = rows & ~count0 & count1 & ~many;
+    if (!pick) pick = rows;
+    uint64_t row_bit = pick & (~pick + 1);
+    
+    for (uint32_t i = 0; i < cs->count && !cs->aborted; i++) {
+        if (cs->banned[i] || !(cs->cover[i] & row_bit)) continue;
+        
+        cs->path[depth] = i;
+        cover_search(cs, rows & ~cs->cover[i], depth + 1, cost + cs->cost[i]);
+        
+        /* Later siblings must not reuse this column */
+        cs->banned[i] = (uint8_t)(depth + 1);
+    }
+    
+    for (uint32_t i = 0; i < cs->count; i++) {
+        if (cs->banned[i] == depth + 1) cs->banned[i] = 0;
+    }
 }
 
 /**
- * @brief Check if 4 cells form a valid rectangular group
+ * @brief Exact minimum cover of rows by the given columns
+ * 
+ * Essential columns and dominance reductions come first, then
+ * branch-and-bound on what is left, seeded with a greedy cover. When the
+ * node or time budget runs out the best cover found so far is returned
+ * and *optimal is cleared.
+ * 
+ * @return 0 on success, -4 if rows cannot be covered
  */
-static bool is_valid_4cell_group(uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t num_vars) {
-    (void)num_vars; /* Unused for now */
+int solve_cover(const uint64_t* columns, const uint16_t* costs, uint32_t count,
+                uint64_t rows, const kmap_options_t* opts,
+                uint32_t* selected, uint32_t* selected_count, bool* optimal) {
+    static __thread cover_search_t cs;
+    
+    if (count > MAX_CUBES) return -4;
     
-    /* Simple validation: all pairs should have consistent bit differences */
-    uint8_t diff1 = c1 ^ c2;
-    uint8_t diff2 = c1 ^ c3; 
-    uint8_t diff3 = c1 ^ c4;
+    cs.count = count;
+    for (uint32_t i = 0; i < count; i++) {
+        cs.cover[i] = columns[i] & rows;
+        cs.cost[i] = costs[i];
+        cs.index[i] = i;
+        cs.banned[i] = 0;
+    }
+    
+    *selected_count = 0;
+    *optimal = true;
+    
+    if (!reduce_cover(&cs, &rows, selected, selected_count)) return -4;
+    if (!rows) return 0;
+    
+    /* Largest columns first so good covers are found early */
+    for (uint32_t i = 1; i < cs.count; i++) {
+        uint64_t cov = cs.cover[i];
+        uint16_t cost = cs.cost[i];
+        uint32_t index = cs.index[i];
+        uint8_t size = popcount(cov);
+        uint32_t j = i;
+        
+        while (j > 0 && (popcount(cs.cover[j - 1]) < size ||
+                         (popcount(cs.cover[j - 1]) == size && cs.cost[j - 1] > cost))) {
+            cs.cover[j] = cs.cover[j - 1];
+            cs.cost[j] = cs.cost[j - 1];
+            cs.index[j] = cs.index[j - 1];
+            j--;
+        }
+        cs.cover[j] = cov;
+        cs.cost[j] = cost;
+        cs.index[j] = index;
+    }
     
-    /* For a valid rectangle, the differences should be consistent */
-    return (diff1 != 0) && (diff2 != 0) && (diff3 != 0) && 
-           ((diff1 & diff2) == 0 || (diff1 & diff3) == 0 || (diff2 & diff3) == 0);
+    greedy_cover(&cs, rows);
+    
+    cs.nodes = 0;
+    cs.node_limit = opts->cover_node_limit;
+    cs.deadline_ns = opts->cover_time_limit_us ?
+        monotonic_ns() + (uint64_t)opts->cover_time_limit_us * 1000ULL : 0;
+    cs.aborted = false;
+    
+    cover_search(&cs, rows, 0, 0);
+    KMAP_STAT_ADD(cover_nodes, cs.nodes);
+    
+    for (uint32_t i = 0; i < cs.best_len; i++) {
+        selected[(*selected_count)++] = cs.index[cs.best[i]];
+    }
+    *optimal = !cs.aborted;
+    
+    return 0;
 }
 
-
 /**
- * @brief Remove redundant implicants (those covered by larger ones)
+ * @brief Drop selected columns covered by the union of the others
+ * 
+ * Only needed when the exact search gave up and returned a greedy cover.
+ * Terms with the most literals are tried first.
  */
-static void remove_redundant_implicants(solution_t* solution) {
-    for (int i = 0; i < solution->implicant_count; i++) {
-        if (solution->implicants[i].size == 0) continue; /* Already removed */
-        
-        for (int j = 0; j < solution->implicant_count; j++) {
-            if (i == j || solution->implicants[j].size == 0) continue;
+static void remove_redundant_columns(const prime_set_t* set, uint32_t* selected,
+                                    uint32_t* selected_count) {
+    uint32_t count = *selected_count;
+    
+    for (uint8_t literals = MAX_VARIABLES + 1; literals-- > 0;) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (popcount(set->literal_mask[selected[i]]) != literals) continue;
             
-            /* Check if implicant i is covered by implicant j */
-            uint64_t i_minterms = solution->implicants[i].covered_minterms;
-            uint64_t j_minterms = solution->implicants[j].covered_minterms;
+            uint64_t others = 0;
+            for (uint32_t j = 0; j < count; j++) {
+                if (j != i) others |= set->covered[selected[j]];
+            }
             
-            if ((i_minterms & j_minterms) == i_minterms && 
-                solution->implicants[j].size > solution->implicants[i].size) {
-                /* Implicant i is redundant - mark for removal */
-                solution->implicants[i].size = 0;
-                break;
+            /* Column i is redundant - remove it, keeping the order */
+            if ((set->covered[selected[i]] & ~others) == 0) {
+                memmove(&selected[i], &selected[i + 1], (count - i - 1) * sizeof(uint32_t));
+                count--;
+                i--;
             }
         }
     }
     
-    /* Compact the array by removing marked implicants */
-    int write_pos = 0;
-    for (int read_pos = 0; read_pos < solution->implicant_count; read_pos++) {
-        if (solution->implicants[read_pos].size > 0) {
-            if (write_pos != read_pos) {
-                solution->implicants[write_pos] = solution->implicants[read_pos];
-            }
-            write_pos++;
-        }
-    }
-    solution->implicant_count = write_pos;
+    *selected_count = count;
 }
 
 /**
  * @brief Main prime implicant finding function
  */
 int find_prime_implicants(const truth_table_t* tt, solution_t* solution) {
+    return find_prime_implicants_ex(tt, solution, NULL);
+}
+
+int find_prime_implicants_ex(const truth_table_t* tt, solution_t* solution,
+                             const kmap_options_t* opts) {
     if (!tt || !solution) return -1;
     if (!validate_truth_table(tt)) return -2;
+    if (!opts) opts = &default_options;
+    
+    /* Shared cache file first; its misses come back here without the flag */
+    if ((opts->flags & (KMAP_OPT_DISK_CACHE | KMAP_OPT_ESPRESSO)) == KMAP_OPT_DISK_CACHE) {
+        return disk_cached_solve(tt, solution, opts);
+    }
+    KMAP_STAT_ADD(solves, 1);
+    
+    /* Heuristic mode skips the exact engine, unless its cover is too long for a solution_t */
+    if (opts->flags & KMAP_OPT_ESPRESSO) {
+        int result = espresso_solve(tt, solution);
+        if (result != -3) return result;
+    }
+    
+    /* 4 variables without don't cares: one table load once warm */
+    if ((opts->flags & KMAP_OPT_MEMO4) && tt->num_vars == 4 && tt->dont_cares == 0) {
+        uint16_t key = (uint16_t)tt->minterms;
+        if (memo4_lookup(key, solution)) {
+            KMAP_STAT_ADD(cache_hits, 1);
+            return 0;
+        }
+        KMAP_STAT_ADD(cache_misses, 1);
+        
+        int result = solve_uncached(tt, solution, opts);
+        if (result == 0) memo4_store(key, solution);
+        return result;
+    }
+    
+    /* 5-6 variables: shared cache keyed on the NP-canonical form */
+    if ((opts->flags & KMAP_OPT_NPN_CACHE) && tt->num_vars >= 5) {
+        return npn_cached_solve(tt, solution, opts);
+    }
+    
+    return solve_uncached(tt, solution, opts);
+}
+
+int complement_truth_table(const truth_table_t* tt, truth_table_t* off) {
+    if (!tt || !off) return -1;
+    if (!validate_truth_table(tt)) return -2;
+    
+    off->minterms = ~(tt->minterms | tt->dont_cares) & cell_mask(tt->num_vars);
+    off->dont_cares = tt->dont_cares;
+    off->num_vars = tt->num_vars;
+    off->minterm_count = popcount(off->minterms);
     
+    return 0;
+}
+
+int solve_kmap_dual(const truth_table_t* tt, solution_t* sop, solution_t* pos,
+                    const kmap_options_t* opts) {
+    if (!tt || (!sop && !pos)) return -1;
+    
+    truth_table_t off;
+    int result = complement_truth_table(tt, &off);
+    if (result != 0) return result;
+    
+    if (sop) {
+        result = find_prime_implicants_ex(tt, sop, opts);
+        if (result != 0) return result;
+        if (!validate_solution(tt, sop)) return -4;
+    }
+    
+    /* The POS clauses are the SOP of the off-set, complemented */
+    if (pos) {
+        result = find_prime_implicants_ex(&off, pos, opts);
+        if (result != 0) return result;
+        if (!validate_solution(&off, pos)) return -4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Uncached solve: primes, then minimum cover
+ */
+int solve_uncached(const truth_table_t* tt, solution_t* solution,
+                   const kmap_options_t* opts) {
     /* Initialize solution */
     memset(solution, 0, sizeof(solution_t));
+    solution->optimal = 1;
     
     /* Handle trivial cases */
     if (tt->minterm_count == 0) {
         return 0; /* No implicants needed */
     }
     
-    if (tt->minterm_count == 1) {
-        /* Single minterm - create single-cell implicant */
-        uint8_t minterm_pos = ctz(tt->minterms);
-        solution->implicants[0].covered_minterms = 1ULL << minterm_pos;
-        solution->implicants[0].literal_mask = (1 << tt->num_vars) - 1;
-        solution->implicants[0].literal_values = minterm_pos;
-        solution->implicants[0].size = 1;
+    if ((tt->minterms | tt->dont_cares) == cell_mask(tt->num_vars)) {
+        /* Every cell is 1 or don't care - constant 1 */
+        solution->implicants[0].covered_minterms = tt->minterms;
+        solution->implicants[0].literal_mask = 0;
+        solution->implicants[0].literal_values = 0;
+        solution->implicants[0].size = tt->minterm_count;
         solution->implicant_count = 1;
+        solution->term_count = 1;
         return 0;
     }
     
-    /* Use correct don't care aware grouping algorithm */
-    find_groups_with_dont_cares(tt->minterms, tt->dont_cares, tt->num_vars, 
-                                solution->implicants, &solution->implicant_count);
+    /* Exact prime implicants */
+    prime_set_t primes;
+    KMAP_STAGE_START(primes_start);
+    uint16_t prime_count = generate_prime_set(tt->minterms, tt->dont_cares, tt->num_vars,
+                                              &primes);
+    KMAP_STAGE_STOP(KMAP_STAGE_PRIMES, primes_start);
+    KMAP_STAT_ADD(primes_found, prime_count);
+    
+    /* Minimum cover straight over the coverage and cost arrays */
+    uint32_t selected[MAX_CELLS];
+    uint32_t selected_count;
+    bool optimal;
+    KMAP_STAGE_START(cover_start);
+    int result = solve_cover(primes.covered, primes.cost, prime_count, tt->minterms, opts,
+                             selected, &selected_count, &optimal);
+    KMAP_STAGE_STOP(KMAP_STAGE_COVER, cover_start);
+    if (result != 0) return result;
     
-    /* Remove redundant implicants */
-    remove_redundant_implicants(solution);
+    /* A budget-limited cover may still contain redundant terms */
+    if (!optimal) remove_redundant_columns(&primes, selected, &selected_count);
+    if (selected_count > MAX_GROUPS) return -4;
+    
+    /* Only the selected primes become implicant_t records */
+    for (uint32_t i = 0; i < selected_count; i++) {
+        implicant_t* imp = &solution->implicants[i];
+        imp->covered_minterms = primes.covered[selected[i]];
+        imp->literal_mask = primes.literal_mask[selected[i]];
+        imp->literal_values = primes.literal_values[selected[i]];
+        imp->size = popcount(imp->covered_minterms);
+    }
+    solution->implicant_count = selected_count;
+    solution->optimal = optimal;
     
     /* Calculate solution statistics */
     solution->term_count = solution->implicant_count;
@@ -536,78 +1373,120 @@ int find_prime_implicants(const truth_table_t* tt, solution_t* solution) {
 }
 
 /**
- * @brief Generate SOP (Sum of Products) expression from solution
+ * @brief Format one cube as a product term or as a sum clause
+ *
+ * A clause is built from a cube of the off-set, so its literals are the
+ * cube's literals complemented: ~A&B becomes A + ~B.
  */
-int generate_sop_expression(const solution_t* solution, uint8_t num_vars,
-                           char* output, int output_len) {
-    if (!solution || !output || output_len <= 0) return -1;
-    if (num_vars > 8) return -2; /* Safety check */
+size_t format_term(uint16_t literal_mask, uint16_t literal_values, uint8_t num_vars,
+                   bool clause, char* term) {
+    static const char var_names[] = "ABCDEFGHIJKLMNOP";
+    size_t term_len = 0;
     
-    /* Variable names */
-    const char var_names[] = "ABCDEFGH";
+    for (uint8_t var = 0; var < num_vars; var++) {
+        uint16_t var_bit = (uint16_t)(1U << var);
+        if (!(literal_mask & var_bit)) continue;
+        
+        if (term_len > 0 && clause) {
+            memcpy(term + term_len, " + ", 3);
+            term_len += 3;
+        } else if (term_len > 0) {
+            term[term_len++] = '&';
+        }
+        if (((literal_values & var_bit) != 0) == clause) term[term_len++] = '~';
+        term[term_len++] = var_names[var];
+    }
     
-    output[0] = '\0'; /* Start with empty string */
+    /* All variables eliminated: constant 1 term, constant 0 clause */
+    if (term_len == 0) term[term_len++] = clause ? '0' : '1';
+    
+    return term_len;
+}
+
+/**
+ * @brief Generate SOP (Sum of Products) expression with a write cursor
+ *
+ * Each product term is built in a small local buffer and copied once, so
+ * the cost is linear in the output length.
+ */
+int generate_sop_expression_n(const solution_t* solution, uint8_t num_vars,
+                              char* output, size_t output_len) {
+    if (!solution || (!output && output_len > 0)) return -1;
+    if (num_vars > MAX_VARIABLES || solution->implicant_count > MAX_GROUPS) return -2;
+    
+    size_t pos = 0;
     
     /* Handle empty solution */
     if (solution->implicant_count == 0) {
-        strncpy(output, "0", output_len - 1);
-        output[output_len - 1] = '\0';
-        return 0;
+        pos = emit_chars(output, output_len, pos, "0", 1);
     }
     
     /* Generate each term */
     for (int i = 0; i < solution->implicant_count; i++) {
         const implicant_t* imp = &solution->implicants[i];
+        char term[MAX_TERM_CHARS];
         
         /* Add OR operator between terms (except for first term) */
-        if (i > 0) {
-            if ((int)strlen(output) + 3 >= output_len) return -3; /* Buffer too small */
-            strcat(output, " + ");
-        }
+        if (i > 0) pos = emit_chars(output, output_len, pos, " + ", 3);
         
-        /* Generate the product term */
-        bool first_literal = true;
+        size_t term_len = format_term(imp->literal_mask, imp->literal_values, num_vars,
+                                      false, term);
+        pos = emit_chars(output, output_len, pos, term, term_len);
+    }
+    
+    if (output_len > 0) output[pos < output_len ? pos : output_len - 1] = '\0';
+    
+    return (int)pos;
+}
+
+/**
+ * @brief Generate SOP (Sum of Products) expression from solution
+ */
+int generate_sop_expression(const solution_t* solution, uint8_t num_vars,
+                           char* output, int output_len) {
+    if (!solution || !output || output_len <= 0) return -1;
+    
+    int needed = generate_sop_expression_n(solution, num_vars, output, (size_t)output_len);
+    if (needed < 0) return needed;
+    
+    return (needed < output_len) ? 0 : -3; /* Buffer too small */
+}
+
+/**
+ * @brief Generate POS (Product of Sums) expression with a write cursor
+ *
+ * Each off-set implicant becomes one clause; clauses with more than one
+ * literal are parenthesized so the result reads "(A + ~B)&~C".
+ */
+int generate_pos_expression_n(const solution_t* off_solution, uint8_t num_vars,
+                              char* output, size_t output_len) {
+    if (!off_solution || (!output && output_len > 0)) return -1;
+    if (num_vars > MAX_VARIABLES || off_solution->implicant_count > MAX_GROUPS) return -2;
+    
+    size_t pos = 0;
+    
+    /* No 0 cells: constant 1 */
+    if (off_solution->implicant_count == 0) {
+        pos = emit_chars(output, output_len, pos, "1", 1);
+    }
+    
+    for (int i = 0; i < off_solution->implicant_count; i++) {
+        const implicant_t* imp = &off_solution->implicants[i];
+        bool wrap = popcount(imp->literal_mask) > 1 && off_solution->implicant_count > 1;
+        char clause[MAX_TERM_CHARS];
         
-        for (uint8_t var = 0; var < num_vars; var++) {
-            uint8_t var_bit = 1 << var;
-            
-            /* Check if this variable is included in the implicant */
-            if (imp->literal_mask & var_bit) {
-                /* Add AND operator between literals (except for first) */
-                if (!first_literal) {
-                    if ((int)strlen(output) + 1 >= output_len) return -3;
-                    strcat(output, "&");
-                }
-                
-                /* Add variable (complemented if value is 0) */
-                if (!(imp->literal_values & var_bit)) {
-                    /* Complemented variable */
-                    if ((int)strlen(output) + 2 >= output_len) return -3;
-                    strcat(output, "~");
-                }
-                
-                /* Variable name */
-                if ((int)strlen(output) + 2 >= output_len) return -3;
-                char var_str[2] = {var_names[var], '\0'};
-                strcat(output, var_str);
-                
-                first_literal = false;
-            }
-        }
+        if (i > 0) pos = emit_chars(output, output_len, pos, "&", 1);
+        if (wrap) pos = emit_chars(output, output_len, pos, "(", 1);
         
-        /* Handle the case where all variables are eliminated (constant 1) */
-        if (first_literal) {
-            if ((int)strlen(output) + 2 >= output_len) return -3;
-            strcat(output, "1");
-        }
+        size_t clause_len = format_term(imp->literal_mask, imp->literal_values, num_vars,
+                                        true, clause);
+        pos = emit_chars(output, output_len, pos, clause, clause_len);
+        
+        if (wrap) pos = emit_chars(output, output_len, pos, ")", 1);
     }
     
-    /* Handle the case where we have an empty expression */
-    if (strlen(output) == 0) {
-        strncpy(output, "1", output_len - 1);
-        output[output_len - 1] = '\0';
-    }
+    if (output_len > 0) output[pos < output_len ? pos : output_len - 1] = '\0';
     
-    return 0;
+    return (int)pos;
 }
 
@@ -17,6 +17,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /* === CONSTANTS === */
 #define MAX_VARIABLES 6
@@ -24,6 +25,10 @@
 #define MAX_GROUPS 32                   // Reasonable limit for terminal display
 #define MAX_DONT_CARES 64              // Up to all cells can be don't cares
 #define MAX_EXPRESSION_LEN 1024        // Max length for SOP expression
+#define MAX_CUBES 729                   // 3^6 distinct cubes over 6 variables
+#define MAX_WIDE_VARIABLES 16           // Multi-word tables (kmap_wide_table_t)
+#define MAX_OUTPUTS 8                   // Functions per multi-output solve
+#define MAX_SHARED_TERMS (MAX_OUTPUTS * MAX_GROUPS)
 
 /* === COMPACT DATA STRUCTURES === */
 
@@ -60,8 +65,86 @@ typedef struct {
     uint8_t implicant_count;                    // Number of implicants
     uint8_t literal_count;                      // Total literals in expression
     uint8_t term_count;                         // Number of terms
+    uint8_t optimal;                            // 1 if the cover is proven minimum
 } solution_t;
 
+/**
+ * @brief Shared-term solution for several functions of the same inputs
+ * 
+ * Output i uses terms[t] when bit t of output_terms[i] is set; a term's
+ * covered_minterms spans the 1s of all outputs using it.
+ */
+typedef struct {
+    implicant_t terms[MAX_SHARED_TERMS];        // Shared term pool
+    uint64_t output_terms[MAX_OUTPUTS][MAX_SHARED_TERMS / 64]; // Per-output selections
+    uint64_t output_minterms[MAX_OUTPUTS];      // 1s of each output
+    uint16_t term_count;                        // Distinct terms in the pool
+    uint16_t literal_count;                     // Literals, each term counted once
+    uint8_t num_outputs;                        // Number of outputs
+    uint8_t num_vars;                           // Number of variables (2-6)
+    uint8_t optimal;                            // 1 if the shared cover is proven minimum
+} multi_solution_t;
+
+/**
+ * @brief Multi-word truth table for up to 16 variables
+ * 
+ * Cell c is bit c % 64 of word c / 64; both arrays hold
+ * kmap_wide_words(num_vars) words.
+ */
+typedef struct {
+    uint64_t* minterms;                         // Bit vector of 1s (minterms)
+    uint64_t* dont_cares;                       // Bit vector of don't cares
+    uint8_t num_vars;                           // Number of variables (2-16)
+} kmap_wide_table_t;
+
+/**
+ * @brief Product term over up to 16 variables
+ */
+typedef struct {
+    uint16_t mask;                              // Which variables are present
+    uint16_t values;                            // Values of present variables
+} kmap_cube_t;
+
+/**
+ * @brief Cover of a wide table (heap-allocated, see kmap_cover_free)
+ */
+typedef struct {
+    kmap_cube_t* cubes;                         // Selected product terms
+    uint32_t count;                             // Number of terms
+    uint32_t literal_count;                     // Total literals in expression
+    bool optimal;                               // true if the cover is proven minimum
+} kmap_cover_t;
+
+/**
+ * @brief Solver tuning options
+ * 
+ * Bounds the exact cover search so worst-case latency stays predictable.
+ * When a budget runs out the best cover found so far (at worst the
+ * greedy one) is returned with solution_t.optimal cleared.
+ */
+typedef struct {
+    uint32_t cover_node_limit;                  // Max search nodes (0 = unlimited)
+    uint32_t cover_time_limit_us;               // Max search time (0 = unlimited)
+    uint32_t flags;                             // KMAP_OPT_* feature bits
+} kmap_options_t;
+
+/* Option flags */
+#define KMAP_OPT_MEMO4 0x0001                  // Memoize 4-var functions without don't cares
+#define KMAP_OPT_NPN_CACHE 0x0002              // Cache 5-6 var functions by NP-canonical form
+#define KMAP_OPT_ESPRESSO 0x0004               // Heuristic cube-list minimizer (no exact cover)
+#define KMAP_OPT_DISK_CACHE 0x0008             // Shared cache file (kmap_disk_cache_open)
+
+/* Output forms for solve_kmap_form() */
+#define KMAP_FORM_SOP 0x0001                   // Sum of products
+#define KMAP_FORM_POS 0x0002                   // Product of sums
+#define KMAP_FORM_BOTH 0x0003                  // SOP, newline, POS
+#define KMAP_FORM_CHEAPEST 0x0004              // Fewer terms, then fewer literals (ties: SOP)
+#define KMAP_FORM_MAP 0x0008                   // Add-on: K-map grid and groups first (2-6 vars)
+
+#define KMAP_DEFAULT_NODE_LIMIT 100000
+#define KMAP_DEFAULT_TIME_LIMIT_US 10000
+#define KMAP_DEFAULT_FLAGS 0
+
 /* === CORE FUNCTION DECLARATIONS === */
 
 /**
@@ -73,6 +156,21 @@ typedef struct {
  */
 int solve_kmap(const char* input, char* output, int output_len);
 
+/**
+ * @brief solve_kmap() with a choice of output form
+ * 
+ * The input is parsed once; the POS form is the complemented cover of
+ * the off-set of the same table, so asking for both or the cheaper one
+ * costs one extra cover search and no extra parse.
+ * 
+ * @param input Input string (binary, minterm list, etc.)
+ * @param form KMAP_FORM_* value
+ * @param output Buffer for result expression(s)
+ * @param output_len Size of output buffer
+ * @return 0 on success, -3 if the buffer is too small, negative on error
+ */
+int solve_kmap_form(const char* input, int form, char* output, int output_len);
+
 /**
  * @brief Parse input string into truth table structure
  * @param input Input string
@@ -81,6 +179,68 @@ int solve_kmap(const char* input, char* output, int output_len);
  */
 int parse_input(const char* input, truth_table_t* tt);
 
+/**
+ * @brief Parse a (ptr, len) view without copying or allocating
+ * 
+ * Accepts binary strings ("10X1"), minterm lists with an optional
+ * don't care section ("1,2,5 d(0,4,6)") and Boolean expressions
+ * ("A&~B | C", see parse_expression_n). Stops at len bytes or a NUL,
+ * whichever comes first.
+ * 
+ * @param input Input characters
+ * @param len Number of characters (SIZE_MAX = NUL-terminated)
+ * @param tt Output truth table
+ * @return 0 on success, negative on error
+ */
+int parse_input_n(const char* input, size_t len, truth_table_t* tt);
+
+/**
+ * @brief Parse an exact binary string ("01Xx-" only, 4-64 characters)
+ * 
+ * Classifies 16-64 characters with SSE2/AVX2 compares (picked at runtime)
+ * instead of a per-character loop. No whitespace or list syntax.
+ * 
+ * @param input Input characters
+ * @param len Number of characters, must be a power of two
+ * @param tt Output truth table
+ * @return 0 on success, -1 on invalid input
+ */
+int parse_binary_n(const char* input, size_t len, truth_table_t* tt);
+
+/**
+ * @brief Compile a Boolean expression straight to a truth table
+ * 
+ * Variables are A-F; | or + is OR, ^ XOR, & or * or juxtaposition AND,
+ * ~ or ! or a trailing ' NOT, with 0, 1 and parentheses. A trailing
+ * "d(...)" lists don't care cells. The expression becomes a small
+ * bytecode run once on 64-bit variable masks, so every cell is computed
+ * at once. The table has as many variables as the highest letter used,
+ * at least 2.
+ * 
+ * @param input Input characters
+ * @param len Number of characters (SIZE_MAX = NUL-terminated)
+ * @param tt Output truth table
+ * @return 0 on success, -1 on invalid input or more than 6 variables
+ */
+int parse_expression_n(const char* input, size_t len, truth_table_t* tt);
+
+/**
+ * @brief Parse a dump of fixed-width binary records
+ * 
+ * Record i starts at data + i * stride and is record_len characters long,
+ * e.g. stride = record_len + 1 for newline-separated lines.
+ * 
+ * @param data Record buffer
+ * @param record_len Characters per record
+ * @param stride Bytes between record starts
+ * @param count Number of records
+ * @param tables Output truth tables (zeroed on error)
+ * @param status Per-record result codes (can be NULL)
+ * @return 0 if every record parsed, otherwise the first error
+ */
+int parse_binary_batch(const char* data, size_t record_len, size_t stride, size_t count,
+                       truth_table_t* tables, int* status);
+
 /**
  * @brief Find optimal prime implicants using bit manipulation
  * @param tt Truth table
@@ -89,6 +249,60 @@ int parse_input(const char* input, truth_table_t* tt);
  */
 int find_prime_implicants(const truth_table_t* tt, solution_t* solution);
 
+/**
+ * @brief find_prime_implicants() with explicit options
+ * @param tt Truth table
+ * @param solution Output solution structure
+ * @param opts Solver options (NULL = process-wide defaults)
+ * @return 0 on success, negative on error
+ */
+int find_prime_implicants_ex(const truth_table_t* tt, solution_t* solution,
+                             const kmap_options_t* opts);
+
+/**
+ * @brief Off-set of a truth table (0 cells become minterms, same don't cares)
+ * @param tt Truth table
+ * @param off Output complement
+ * @return 0 on success, negative on error
+ */
+int complement_truth_table(const truth_table_t* tt, truth_table_t* off);
+
+/**
+ * @brief Minimize both rails of one table
+ * 
+ * pos receives the cover of the off-set; pass it to
+ * generate_pos_expression_n(). Either output may be NULL to skip it.
+ * 
+ * @param tt Truth table
+ * @param sop Output cover of the 1 cells (can be NULL)
+ * @param pos Output cover of the 0 cells (can be NULL)
+ * @param opts Solver options (NULL = process-wide defaults)
+ * @return 0 on success, -4 if a cover fails validation, negative on error
+ */
+int solve_kmap_dual(const truth_table_t* tt, solution_t* sop, solution_t* pos,
+                    const kmap_options_t* opts);
+
+/**
+ * @brief Fill options with the built-in defaults
+ * @param opts Options to initialize
+ */
+void kmap_default_options(kmap_options_t* opts);
+
+/**
+ * @brief Set the process-wide defaults used when no options are passed
+ * 
+ * Not synchronized with running solves; call during startup.
+ * 
+ * @param opts New defaults (NULL = built-in defaults)
+ */
+void kmap_set_options(const kmap_options_t* opts);
+
+/**
+ * @brief Read the process-wide default options
+ * @param opts Output options
+ */
+void kmap_get_options(kmap_options_t* opts);
+
 /**
  * @brief Generate SOP expression from solution
  * @param solution Solution structure
@@ -100,6 +314,839 @@ int find_prime_implicants(const truth_table_t* tt, solution_t* solution);
 int generate_sop_expression(const solution_t* solution, uint8_t num_vars, 
                            char* output, int output_len);
 
+/**
+ * @brief Generate SOP expression, snprintf-style
+ * 
+ * Writes at most output_len - 1 characters plus a NUL and returns the
+ * full expression length, so a (NULL, 0) call sizes the buffer.
+ * 
+ * @param solution Solution structure
+ * @param num_vars Number of variables (at most MAX_VARIABLES)
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Expression length excluding the NUL, -2 past MAX_VARIABLES, negative on error
+ */
+int generate_sop_expression_n(const solution_t* solution, uint8_t num_vars,
+                              char* output, size_t output_len);
+
+/**
+ * @brief Generate POS expression from an off-set cover, snprintf-style
+ * 
+ * Each implicant of the off-set becomes one sum clause of complemented
+ * literals, e.g. "(A + ~B)&~C". An empty cover is "1".
+ * 
+ * @param off_solution Cover of the 0 cells (from solve_kmap_dual)
+ * @param num_vars Number of variables (at most MAX_VARIABLES)
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Expression length excluding the NUL, -2 past MAX_VARIABLES, negative on error
+ */
+int generate_pos_expression_n(const solution_t* off_solution, uint8_t num_vars,
+                              char* output, size_t output_len);
+
+/* === BATCH FUNCTIONS === */
+
+/**
+ * @brief Build a truth table directly from packed bit vectors
+ * @param minterms Bit vector of 1s
+ * @param dont_cares Bit vector of don't cares
+ * @param num_vars Number of variables (2-6)
+ * @param tt Output truth table
+ * @return 0 on success, negative on error
+ */
+int init_truth_table(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars,
+                     truth_table_t* tt);
+
+/**
+ * @brief Solve an array of truth tables in one call
+ * 
+ * Skips string parsing entirely; each table is validated once and solved
+ * straight into the caller's solution array.
+ * 
+ * @param tables Input truth tables
+ * @param count Number of tables
+ * @param solutions Output solutions (count entries)
+ * @param status Optional per-item result codes (count entries, may be NULL)
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch(const truth_table_t* tables, size_t count,
+                     solution_t* solutions, int* status);
+
+/**
+ * @brief Solve an array of truth tables into a caller-owned string arena
+ * 
+ * Expressions are appended NUL-terminated to the arena; offsets[i] is the
+ * start of item i, or (size_t)-1 if the item failed.
+ * 
+ * @param tables Input truth tables
+ * @param count Number of tables
+ * @param arena Output buffer shared by all expressions
+ * @param arena_len Size of arena
+ * @param offsets Output start offsets (count entries)
+ * @param status Optional per-item result codes (count entries, may be NULL);
+ *               -3 only when the arena ran out at that item
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch_sop(const truth_table_t* tables, size_t count,
+                         char* arena, size_t arena_len,
+                         size_t* offsets, int* status);
+
+/**
+ * @brief solve_kmap_batch_sop() writing packed records instead of strings
+ * 
+ * Records are laid back to back in the arena (see pack_solution);
+ * offsets[i] is the start of item i, or (size_t)-1 if the item failed.
+ * 
+ * @param tables Input truth tables
+ * @param count Number of tables
+ * @param arena Output buffer shared by all records
+ * @param arena_len Size of arena
+ * @param offsets Output start offsets (count entries)
+ * @param status Optional per-item result codes (count entries, may be NULL);
+ *               -3 only when the arena ran out at that item
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch_packed(const truth_table_t* tables, size_t count,
+                            uint8_t* arena, size_t arena_len,
+                            size_t* offsets, int* status);
+
+/**
+ * @brief Fixed-size result of solve_kmap_batch_arrays()
+ * 
+ * Plain bytes with no pointers, laid out to match a NumPy structured
+ * dtype: u1 term_count, u1 literal_count, u1 optimal, i1 status,
+ * (u2, 32) cubes.
+ */
+typedef struct {
+    uint8_t term_count;
+    uint8_t literal_count;
+    uint8_t optimal;                            // Proven minimum cover
+    int8_t status;                              // 0 or the item's error code
+    uint16_t cubes[MAX_GROUPS];                 // literal_mask | literal_values << 8
+} kmap_array_result_t;
+
+/**
+ * @brief Solve tables given as parallel bit-vector arrays
+ * 
+ * Made for array libraries: the inputs are plain uint64 arrays, so a
+ * NumPy array's data pointer can be passed straight in.
+ * 
+ * @param minterms Bit vectors of 1s (count entries)
+ * @param dont_cares Bit vectors of don't cares (count entries, NULL = none)
+ * @param count Number of tables
+ * @param num_vars Number of variables of every table (2-6)
+ * @param results Output results (count entries)
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch_arrays(const uint64_t* minterms, const uint64_t* dont_cares,
+                            size_t count, uint8_t num_vars, kmap_array_result_t* results);
+
+/* === PACKED SOLUTIONS === */
+
+/**
+ * @brief Encode a solution as a packed record
+ * 
+ * Byte 0 is num_vars, with 0x80 set if the cover is optimal; then a
+ * varint term count and a varint literal mask and literal values per
+ * term (LEB128). Writes only the bytes that fit and returns the full
+ * size, so a (NULL, 0) call sizes the buffer.
+ * 
+ * @param solution Solution structure
+ * @param num_vars Number of variables
+ * @param out Output buffer (may be NULL if out_len is 0)
+ * @param out_len Buffer size
+ * @return Record size in bytes, negative on error
+ */
+int pack_solution(const solution_t* solution, uint8_t num_vars, uint8_t* out, size_t out_len);
+
+/**
+ * @brief Encode a wide cover in the same packed record format
+ * @param cover Cover from solve_kmap_wide
+ * @param num_vars Number of variables
+ * @param out Output buffer (may be NULL if out_len is 0)
+ * @param out_len Buffer size
+ * @return Record size in bytes, negative on error
+ */
+int pack_cover(const kmap_cover_t* cover, uint8_t num_vars, uint8_t* out, size_t out_len);
+
+/**
+ * @brief Decode a packed record of at most 6 variables
+ * 
+ * covered_minterms is set to every cell of each term, since the record
+ * does not carry the table.
+ * 
+ * @param data Record bytes
+ * @param len Bytes available
+ * @param solution Output solution
+ * @param num_vars Output variable count (can be NULL)
+ * @return Bytes consumed, -2 if malformed, -3 if too many terms, negative on error
+ */
+int unpack_solution(const uint8_t* data, size_t len, solution_t* solution, uint8_t* num_vars);
+
+/* === MULTI-OUTPUT FUNCTIONS === */
+
+/**
+ * @brief Minimize several functions of the same inputs with shared terms
+ * 
+ * Primes are generated once for every product of outputs. Each output is
+ * covered exactly over them, with terms already used elsewhere priced
+ * low, repeating until the shared cost stops dropping.
+ * 
+ * @param tables Input truth tables (same num_vars)
+ * @param count Number of outputs (1 to MAX_OUTPUTS)
+ * @param solution Output shared solution
+ * @param opts Solver options (NULL = process defaults)
+ * @return 0 on success, negative on error
+ */
+int solve_kmap_multi(const truth_table_t* tables, uint8_t count,
+                     multi_solution_t* solution, const kmap_options_t* opts);
+
+/**
+ * @brief Extract one output as an ordinary solution
+ * 
+ * The result works with generate_sop_expression and validate_solution.
+ * 
+ * @param solution Shared solution
+ * @param output Output index
+ * @param single Output solution for that function
+ * @return 0 on success, -1 on bad index, -3 if it needs more than MAX_GROUPS terms
+ */
+int multi_solution_output(const multi_solution_t* solution, uint8_t output,
+                          solution_t* single);
+
+/* === WIDE TABLES (UP TO 16 VARIABLES) === */
+
+/**
+ * @brief Number of 64-bit words in a wide table
+ * @param num_vars Number of variables
+ * @return Words per bit vector (at least 1)
+ */
+size_t kmap_wide_words(uint8_t num_vars);
+
+/**
+ * @brief Allocate an all-zero wide table
+ * @param tt Table to initialize
+ * @param num_vars Number of variables (2-16)
+ * @return 0 on success, -1 on invalid size or allocation failure
+ */
+int kmap_wide_table_init(kmap_wide_table_t* tt, uint8_t num_vars);
+
+/**
+ * @brief Release a table from kmap_wide_table_init or parse_input_wide
+ */
+void kmap_wide_table_free(kmap_wide_table_t* tt);
+
+/**
+ * @brief Release the terms of a cover from solve_kmap_wide
+ */
+void kmap_cover_free(kmap_cover_t* cover);
+
+/**
+ * @brief Allocate the off-set of a wide table (free with kmap_wide_table_free)
+ * @param tt Wide table
+ * @param off Output complement
+ * @return 0 on success, negative on error
+ */
+int kmap_wide_table_complement(const kmap_wide_table_t* tt, kmap_wide_table_t* off);
+
+/**
+ * @brief Parse input with up to 16 variables into a new wide table
+ * 
+ * Same formats as parse_input_n; binary strings may be up to 65536
+ * characters, list cells up to 65535 and expressions may use A-P.
+ * Free with kmap_wide_table_free.
+ * 
+ * @param input Input characters
+ * @param len Number of characters (SIZE_MAX = NUL-terminated)
+ * @param tt Output table
+ * @return 0 on success, -1 on invalid input, -2 if a cell is both a
+ *         minterm and a don't care
+ */
+int parse_input_wide(const char* input, size_t len, kmap_wide_table_t* tt);
+
+/**
+ * @brief parse_expression_n() with variables A-P into a new wide table
+ * 
+ * Runs the bytecode once per 64-cell word. Free with kmap_wide_table_free.
+ * 
+ * @return 0 on success, -1 on invalid input, -4 on allocation failure
+ */
+int parse_expression_wide(const char* input, size_t len, kmap_wide_table_t* tt);
+
+/**
+ * @brief Minimize a wide table
+ * 
+ * Tables of 6 or fewer variables use the 64-bit solver. Larger ones take
+ * essential primes, then the exact cover when at most 64 1s remain, and a
+ * greedy cover with an irredundancy pass otherwise.
+ * 
+ * @param tt Input table
+ * @param cover Output cover (free with kmap_cover_free)
+ * @param opts Solver options (NULL = process defaults)
+ * @return 0 on success, negative on error
+ */
+int solve_kmap_wide(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                    const kmap_options_t* opts);
+
+/**
+ * @brief Generate SOP expression for a wide cover (variables A-P), snprintf-style
+ * @param cover Cover from solve_kmap_wide
+ * @param num_vars Number of variables
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Expression length excluding the NUL, negative on error
+ */
+int generate_sop_expression_wide(const kmap_cover_t* cover, uint8_t num_vars,
+                                 char* output, size_t output_len);
+
+/**
+ * @brief Generate POS expression from a wide off-set cover, snprintf-style
+ * @param off_cover Cover of the off-set (see kmap_wide_table_complement)
+ * @param num_vars Number of variables
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Expression length excluding the NUL, negative on error
+ */
+int generate_pos_expression_wide(const kmap_cover_t* off_cover, uint8_t num_vars,
+                                 char* output, size_t output_len);
+
+/* === ARENA ALLOCATION === */
+
+/**
+ * @brief Opaque bump arena for solver scratch and results
+ * 
+ * Blocks are chained as needed and kept across resets, so an arena that
+ * has reached a workload's peak size serves every later solve without
+ * touching malloc. An arena is not thread-safe; use one per thread.
+ */
+typedef struct kmap_arena kmap_arena_t;
+
+/**
+ * @brief Create a heap arena
+ * @param block_size Minimum size of each block (0 = 64 KB)
+ * @return Arena, NULL on allocation failure
+ */
+kmap_arena_t* kmap_arena_create(size_t block_size);
+
+/**
+ * @brief Place an arena in caller memory
+ * 
+ * The arena header and first block live in the buffer; when it fills,
+ * further blocks come from malloc and are freed by kmap_arena_destroy.
+ * 
+ * @param buffer Caller memory, outliving the arena (any alignment)
+ * @param len Buffer size in bytes
+ * @return Arena, NULL if the buffer is too small for the header
+ */
+kmap_arena_t* kmap_arena_init(void* buffer, size_t len);
+
+/**
+ * @brief Free an arena and every block it allocated
+ * @param arena Arena (may be NULL)
+ */
+void kmap_arena_destroy(kmap_arena_t* arena);
+
+/**
+ * @brief Free everything allocated from the arena, keeping its blocks
+ * @param arena Arena (may be NULL)
+ */
+void kmap_arena_reset(kmap_arena_t* arena);
+
+/**
+ * @brief Allocate from the arena (16-byte aligned)
+ * @return Memory valid until the next reset, NULL on allocation failure
+ */
+void* kmap_arena_alloc(kmap_arena_t* arena, size_t size);
+
+/**
+ * @brief Allocate zeroed memory from the arena
+ * @return Memory valid until the next reset, NULL on failure or overflow
+ */
+void* kmap_arena_calloc(kmap_arena_t* arena, size_t count, size_t size);
+
+/**
+ * @brief Total usable bytes of the blocks the arena holds
+ */
+size_t kmap_arena_capacity(const kmap_arena_t* arena);
+
+/**
+ * @brief Arena private to the calling thread, created on first use
+ * 
+ * Used as scratch by solve_kmap_wide(); callers may use it too, but must
+ * not keep allocations across calls into the solver.
+ * 
+ * @return Arena, NULL on allocation failure
+ */
+kmap_arena_t* kmap_thread_arena(void);
+
+/**
+ * @brief Free the calling thread's arena (e.g. before the thread exits)
+ */
+void kmap_thread_arena_free(void);
+
+/**
+ * @brief Minimize a wide table into an arena
+ * 
+ * Same result as solve_kmap_wide() with no cap on the number of terms,
+ * but the primes, cover scratch and result terms all come from the
+ * arena: reset it between solves instead of calling kmap_cover_free.
+ * 
+ * @param tt Input table
+ * @param cover Output cover (terms valid until the arena is reset)
+ * @param opts Solver options (NULL = process defaults)
+ * @param arena Arena to allocate from
+ * @return 0 on success, negative on error
+ */
+int solve_kmap_wide_arena(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                          const kmap_options_t* opts, kmap_arena_t* arena);
+
+/* === INCREMENTAL SOLVING === */
+
+/**
+ * @brief Opaque solver state for a table edited one cell at a time
+ */
+typedef struct kmap_handle kmap_handle_t;
+
+/* Cell values for kmap_handle_update_cell() */
+#define KMAP_CELL_ZERO 0
+#define KMAP_CELL_ONE 1
+#define KMAP_CELL_DONT_CARE 2
+
+/**
+ * @brief Create a handle over a copy of a table (2-16 variables)
+ * 
+ * The handle keeps the prime set and the last cover; edits only touch
+ * the primes through the edited cell.
+ * 
+ * @param tt Initial table
+ * @param opts Solver options, copied (NULL = process-wide defaults)
+ * @return Handle, NULL on invalid table or allocation failure
+ */
+kmap_handle_t* kmap_handle_create(const kmap_wide_table_t* tt, const kmap_options_t* opts);
+
+/**
+ * @brief Free a handle and its cover
+ * @param h Handle (may be NULL)
+ */
+void kmap_handle_destroy(kmap_handle_t* h);
+
+/**
+ * @brief Set one cell and update the affected primes
+ * @param h Handle
+ * @param cell Cell index (bit v = variable v)
+ * @param value KMAP_CELL_ZERO, KMAP_CELL_ONE or KMAP_CELL_DONT_CARE
+ * @return 0 on success, -1 on invalid arguments
+ */
+int kmap_handle_update_cell(kmap_handle_t* h, uint32_t cell, int value);
+
+/**
+ * @brief Current minimal cover, re-covered only if a cell changed
+ * @param h Handle
+ * @param cover Output: cover owned by the handle, valid until the next edit
+ * @return 0 on success, negative on error
+ */
+int kmap_handle_get_solution(kmap_handle_t* h, const kmap_cover_t** cover);
+
+/**
+ * @brief Current table of a handle (owned by the handle)
+ */
+const kmap_wide_table_t* kmap_handle_table(const kmap_handle_t* h);
+
+/**
+ * @brief Number of primes the handle is tracking (0 while they are being rebuilt)
+ */
+uint32_t kmap_handle_prime_count(const kmap_handle_t* h);
+
+/* === HEURISTIC MINIMIZER === */
+
+/**
+ * @brief Espresso-style minimization of a cube list
+ * 
+ * EXPAND / IRREDUNDANT / REDUCE loops with tautology-based containment.
+ * Memory grows with the number of cubes, not 2^n. The result is an
+ * irredundant prime cover; optimal is only set for trivial covers. Also
+ * selected for table inputs of any size by KMAP_OPT_ESPRESSO. A 2-6
+ * variable solution_t holds at most MAX_GROUPS terms, so there a longer
+ * heuristic cover is replaced by the exact one (at most 32 terms).
+ * 
+ * @param on Cubes of the on-set (may overlap dc)
+ * @param on_count Number of on-set cubes
+ * @param dc Cubes of the don't care set
+ * @param dc_count Number of don't care cubes
+ * @param num_vars Number of variables (2-16)
+ * @param cover Output cover (free with kmap_cover_free)
+ * @return 0 on success, negative on error
+ */
+int espresso_minimize(const kmap_cube_t* on, uint32_t on_count,
+                      const kmap_cube_t* dc, uint32_t dc_count,
+                      uint8_t num_vars, kmap_cover_t* cover);
+
+/* === SOLUTION CACHES === */
+
+/**
+ * @brief Solve and memoize all 65536 4-variable functions up front
+ * 
+ * Afterwards every KMAP_OPT_MEMO4 lookup without don't cares is a hit.
+ * Safe to call while other threads solve.
+ * 
+ * @return 0 on success, negative on error
+ */
+int kmap_memo4_prewarm(void);
+
+/**
+ * @brief Number of filled 4-variable memo entries
+ * @return Entry count (0 to 65536)
+ */
+size_t kmap_memo4_count(void);
+
+/**
+ * @brief Counters for sizing a solution cache
+ */
+typedef struct {
+    uint64_t lookups;                           // Cached solves attempted
+    uint64_t hits;                              // Served from the cache
+    uint64_t misses;                            // Solved and inserted
+    uint64_t evictions;                         // Live entries overwritten
+    size_t entries;                             // Table capacity
+    size_t used;                                // Occupied entries
+    size_t memory_bytes;                        // Table size in bytes
+} kmap_cache_stats_t;
+
+/**
+ * @brief Allocate the NP-canonical cache used by KMAP_OPT_NPN_CACHE
+ * 
+ * Functions equal up to input permutation and negation share one entry.
+ * Replaces any existing table; call before solving starts.
+ * 
+ * @param entries Capacity, rounded up to a power of two
+ * @return 0 on success, negative on error
+ */
+int kmap_npn_cache_init(size_t entries);
+
+/**
+ * @brief Free the NP-canonical cache (solves then bypass it)
+ */
+void kmap_npn_cache_free(void);
+
+/**
+ * @brief Read NP-canonical cache counters
+ * @param stats Output counters
+ */
+void kmap_npn_cache_stats(kmap_cache_stats_t* stats);
+
+/**
+ * @brief Canonicalize inputs under permutation and negation
+ * 
+ * Heuristic semi-canonical form: inputs are negated so each positive
+ * cofactor is the heavier one, sorted by cofactor weight, and ties are
+ * resolved by trying the candidates and keeping the smallest table.
+ * 
+ * @param tt Input truth table
+ * @param canonical Output canonical truth table
+ * @param perm Output: canonical variable i is original variable perm[i]
+ * @param negate Output: original variables complemented before permuting
+ */
+void kmap_np_canonicalize(const truth_table_t* tt, truth_table_t* canonical,
+                          uint8_t perm[MAX_VARIABLES], uint8_t* negate);
+
+/**
+ * @brief Map the cache file used by KMAP_OPT_DISK_CACHE
+ * 
+ * A fixed-size hash table of NP-canonical 2-6 variable truth tables and
+ * their solutions, shared by every process that maps the same file.
+ * Lookups take no lock; an insert claims an empty slot with a CAS and
+ * the slot is never rewritten, so a full table just stops growing. A
+ * missing file is created sparse; an existing one keeps its capacity.
+ * Replaces any open cache; call before solving starts.
+ * 
+ * @param path Cache file
+ * @param entries Capacity of a new file, rounded up to a power of two (0 = default)
+ * @return 0 on success, -1 on invalid arguments, -3 if the file is not a
+ *         compatible cache, -4 on I/O failure
+ */
+int kmap_disk_cache_open(const char* path, size_t entries);
+
+/**
+ * @brief Unmap the cache file (solves then bypass it)
+ */
+void kmap_disk_cache_close(void);
+
+/**
+ * @brief Read cache file counters
+ * 
+ * lookups, hits and misses count this process; used counts the entries
+ * every process has inserted. Nothing is ever evicted.
+ * 
+ * @param stats Output counters
+ */
+void kmap_disk_cache_stats(kmap_cache_stats_t* stats);
+
+/* === THREADED BATCH FUNCTIONS === */
+
+/**
+ * @brief Opaque work-stealing thread pool
+ */
+typedef struct kmap_pool kmap_pool_t;
+
+/**
+ * @brief Task callback processing items [begin, end)
+ */
+typedef void (*kmap_task_fn)(void* ctx, size_t begin, size_t end);
+
+/**
+ * @brief Create a pool of worker threads
+ * 
+ * The calling thread of kmap_pool_run() acts as one of the workers, so a
+ * pool of N workers spawns N-1 background threads.
+ * 
+ * @param num_threads Total workers (0 = number of online CPUs)
+ * @return Pool handle, NULL on failure
+ */
+kmap_pool_t* kmap_pool_create(unsigned num_threads);
+
+/**
+ * @brief Stop all workers and free the pool
+ * @param pool Pool handle (may be NULL)
+ */
+void kmap_pool_destroy(kmap_pool_t* pool);
+
+/**
+ * @brief Number of workers in the pool
+ * @param pool Pool handle
+ * @return Worker count including the caller
+ */
+unsigned kmap_pool_size(const kmap_pool_t* pool);
+
+/**
+ * @brief Run a task over [0, count) and wait for completion
+ * 
+ * One run at a time per pool: do not call it from two threads at once on
+ * the same pool, nor from inside one of that pool's tasks.
+ * 
+ * @param pool Pool handle
+ * @param count Number of items
+ * @param grain Items per chunk (0 = automatic)
+ * @param fn Task callback
+ * @param ctx Callback context
+ * @return 0 on success, negative on error
+ */
+int kmap_pool_run(kmap_pool_t* pool, size_t count, size_t grain,
+                  kmap_task_fn fn, void* ctx);
+
+/**
+ * @brief Multithreaded solve_kmap_batch()
+ * @param pool Pool handle (NULL = solve on the calling thread)
+ * @param tables Input truth tables
+ * @param count Number of tables
+ * @param solutions Output solutions (count entries)
+ * @param status Optional per-item result codes (count entries, may be NULL)
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch_mt(kmap_pool_t* pool, const truth_table_t* tables, size_t count,
+                        solution_t* solutions, int* status);
+
+/**
+ * @brief Multithreaded solve_kmap_batch_arrays()
+ * @param pool Pool handle (NULL = solve on the calling thread)
+ * @return 0 if every item was solved, otherwise the first item error code
+ */
+int solve_kmap_batch_arrays_mt(kmap_pool_t* pool, const uint64_t* minterms,
+                               const uint64_t* dont_cares, size_t count, uint8_t num_vars,
+                               kmap_array_result_t* results);
+
+/* === STREAMING === */
+
+/* Input formats for kmap_stream_file() */
+#define KMAP_STREAM_LINES 0                    // One solve_kmap input per line
+#define KMAP_STREAM_RECORDS 1                  // Binary {uint64 minterms, uint64 dont_cares}
+
+/**
+ * @brief Streaming solver configuration
+ */
+typedef struct {
+    uint32_t format;                            // KMAP_STREAM_LINES or KMAP_STREAM_RECORDS
+    uint8_t num_vars;                           // Variables per binary record (2-6)
+    int form;                                   // KMAP_FORM_* per output line
+    size_t batch_records;                       // Records per pipeline batch (0 = default)
+} kmap_stream_options_t;
+
+/**
+ * @brief Streaming solver counters
+ */
+typedef struct {
+    uint64_t records;                           // Records solved or failed
+    uint64_t failed;                            // Records written as "error <code>"
+    uint64_t bytes_written;                     // Output bytes
+} kmap_stream_stats_t;
+
+/**
+ * @brief Fill stream options with defaults (lines, SOP, 6-variable records)
+ * @param opts Options to initialize
+ */
+void kmap_stream_default_options(kmap_stream_options_t* opts);
+
+/**
+ * @brief Solve every record of a file, one output line per record
+ * 
+ * The file is memory-mapped and parsed in place; batches flow through
+ * parse, solve (on the pool) and write stages concurrently, and consumed
+ * pages are released, so memory use does not grow with the file size.
+ * A record that fails becomes the line "error <code>"; KMAP_FORM_BOTH
+ * separates SOP and POS with a tab.
+ * 
+ * @param path Input file
+ * @param out_fd Output file descriptor
+ * @param pool Worker pool (NULL = solve on the calling thread)
+ * @param opts Stream options (NULL = defaults)
+ * @param stats Output counters (may be NULL)
+ * @return 0 on success, -1 on invalid arguments or unreadable input,
+ *         -4 on allocation or write failure
+ */
+int kmap_stream_file(const char* path, int out_fd, kmap_pool_t* pool,
+                     const kmap_stream_options_t* opts, kmap_stream_stats_t* stats);
+
+/**
+ * @brief kmap_stream_file() over a buffer already in memory
+ * @param data Input bytes
+ * @param len Number of bytes
+ * @param out_fd Output file descriptor
+ * @param pool Worker pool (NULL = solve on the calling thread)
+ * @param opts Stream options (NULL = defaults)
+ * @param stats Output counters (may be NULL)
+ * @return 0 on success, negative on error
+ */
+int kmap_stream_buffer(const char* data, size_t len, int out_fd, kmap_pool_t* pool,
+                       const kmap_stream_options_t* opts, kmap_stream_stats_t* stats);
+
+/* === SOLVER DAEMON === */
+
+typedef struct kmap_server kmap_server_t;
+
+/**
+ * @brief Solver daemon configuration
+ */
+typedef struct {
+    int form;                                   // KMAP_FORM_* for requests that name none
+    size_t max_connections;                     // Clients served at once (0 = default)
+    size_t max_batch;                           // Requests solved per batch (0 = default)
+} kmap_serve_options_t;
+
+/**
+ * @brief Daemon counters
+ */
+typedef struct {
+    uint64_t connections;                       // Clients accepted
+    uint64_t requests;                          // Requests answered
+    uint64_t failed;                            // Requests answered "error <code>"
+    uint64_t batches;                           // Solver batches run
+} kmap_serve_stats_t;
+
+/**
+ * @brief Fill daemon options with defaults (SOP, 256 clients, 4096 per batch)
+ * @param opts Options to initialize
+ */
+void kmap_serve_default_options(kmap_serve_options_t* opts);
+
+/**
+ * @brief Listen on a Unix socket for solve requests
+ * 
+ * Clients pipeline requests on a stream connection and get the answers
+ * back in order. A request is either a line ("both:1X01" and friends name
+ * the form) or a frame: byte 0x00, a KMAP_FORM_* byte (0 = default), a
+ * little-endian uint32 length and the input. Line answers are one line,
+ * KMAP_FORM_BOTH separated by a tab; frame answers are 0x00, a uint32
+ * length and the text, KMAP_FORM_BOTH separated by a newline. Failures
+ * are answered "error <code>". A stale socket at the path is replaced;
+ * any other file there is an error.
+ * 
+ * @param socket_path Path to bind
+ * @param pool Worker pool for solving batches (NULL = the serving thread)
+ * @param opts Daemon options (NULL = defaults)
+ * @return Server, or NULL if the socket cannot be set up
+ */
+kmap_server_t* kmap_server_create(const char* socket_path, kmap_pool_t* pool,
+                                  const kmap_serve_options_t* opts);
+
+/**
+ * @brief Serve clients until kmap_server_stop() is called
+ * @return 0 when stopped, -1 on invalid arguments, -4 if polling fails
+ */
+int kmap_server_run(kmap_server_t* server);
+
+/**
+ * @brief Make kmap_server_run() return (async-signal-safe, any thread)
+ */
+void kmap_server_stop(kmap_server_t* server);
+
+/**
+ * @brief Read daemon counters
+ * @param stats Output counters
+ */
+void kmap_server_stats(const kmap_server_t* server, kmap_serve_stats_t* stats);
+
+/**
+ * @brief Close every connection, remove the socket and free the server
+ */
+void kmap_server_destroy(kmap_server_t* server);
+
+/* === STATISTICS === */
+
+/* Stages timed by kmap_stats_t.stage_ns */
+#define KMAP_STAGE_PARSE 0
+#define KMAP_STAGE_PRIMES 1
+#define KMAP_STAGE_COVER 2
+#define KMAP_STAGE_EMIT 3
+#define KMAP_STAGE_COUNT 4
+
+/**
+ * @brief Solver counters, summed over all threads
+ * 
+ * Only collected when the library is built with -DKMAP_STATS; otherwise
+ * the hooks compile to nothing.
+ */
+typedef struct {
+    uint64_t solves;                            // Tables minimized, cache hits included
+    uint64_t cubes_examined;                    // Implicant cubes tested for primality
+    uint64_t primes_found;
+    uint64_t cover_nodes;                       // Branch-and-bound nodes searched
+    uint64_t cache_hits;                        // memo4 and NPN cache
+    uint64_t cache_misses;
+    uint64_t stage_calls[KMAP_STAGE_COUNT];
+    uint64_t stage_ns[KMAP_STAGE_COUNT];        // Wall time per stage
+} kmap_stats_t;
+
+/**
+ * @brief Read the counters
+ * @param stats Output (zeroed if statistics are compiled out)
+ * @return 0 on success, -1 if built without KMAP_STATS
+ */
+int kmap_get_stats(kmap_stats_t* stats);
+
+/**
+ * @brief Zero the counters (increments racing with the reset may be lost)
+ */
+void kmap_reset_stats(void);
+
+/* === K-MAP RENDERING === */
+
+/**
+ * @brief Draw a table as a Gray-code K-map grid annotated with its groups
+ * 
+ * Columns are the low half of the variables, rows the high half. Each
+ * cell shows 0, 1 or X followed by the letters (a-z, A-F) of the groups
+ * containing it; a legend line per group follows the grid. No trailing
+ * newline. KMAP_FORM_MAP puts this in front of the solve output.
+ * 
+ * @param tt Truth table (2-6 variables)
+ * @param groups Cover to annotate (NULL = grid only)
+ * @param clauses Groups are off-set cubes: legend shows POS clauses
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Output length excluding the NUL (snprintf-style), negative on error
+ */
+int render_kmap(const truth_table_t* tt, const solution_t* groups, bool clauses,
+                char* output, size_t output_len);
+
 /* === UTILITY FUNCTIONS === */
 
 /**
@@ -127,6 +1174,35 @@ uint8_t gray_to_linear(uint8_t gray, uint8_t num_vars);
  */
 bool are_adjacent(uint8_t cell1, uint8_t cell2, uint8_t num_vars);
 
+/**
+ * @brief Base-3 cube encoding used by the coverage table
+ * 
+ * One digit per variable: 0 = complemented, 1 = true, 2 = absent.
+ * 
+ * @param literal_mask Which variables are present
+ * @param literal_values Values of present variables
+ * @return Cube index (0 to MAX_CUBES-1)
+ */
+uint16_t cube_index(uint8_t literal_mask, uint8_t literal_values);
+
+/**
+ * @brief Look up the cells covered by a cube
+ * @param literal_mask Which variables are present
+ * @param literal_values Values of present variables
+ * @param num_vars Number of variables
+ * @return Bit vector of covered cells
+ */
+uint64_t cube_coverage(uint8_t literal_mask, uint8_t literal_values, uint8_t num_vars);
+
+/**
+ * @brief Check whether a cube lies entirely inside minterms | dont_cares
+ * @param tt Truth table
+ * @param literal_mask Which variables are present
+ * @param literal_values Values of present variables
+ * @return true if the cube is an implicant
+ */
+bool is_implicant(const truth_table_t* tt, uint8_t literal_mask, uint8_t literal_values);
+
 /**
  * @brief Count number of set bits (population count)
  * @param value 64-bit value
@@ -162,6 +1238,21 @@ bool validate_truth_table(const truth_table_t* tt);
  */
 bool validate_solution(const truth_table_t* tt, const solution_t* solution);
 
+/**
+ * @brief Validate wide table structure
+ * @param tt Wide table to validate
+ * @return true if valid
+ */
+bool validate_wide_table(const kmap_wide_table_t* tt);
+
+/**
+ * @brief Validate a wide cover: every term is an implicant, all 1s covered
+ * @param tt Original wide table
+ * @param cover Cover to validate
+ * @return true if cover is complete and correct
+ */
+bool validate_wide_cover(const kmap_wide_table_t* tt, const kmap_cover_t* cover);
+
 /* === DEBUG/TESTING FUNCTIONS === */
 #ifdef DEBUG
 /**
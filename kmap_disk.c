@@ -0,0 +1,296 @@
+/**
+ * @file kmap_disk.c
+ * @brief Solution cache in a memory-mapped file shared across processes
+ *
+ * The file is a header followed by a fixed-size open-addressed table of
+ * NP-canonical truth tables and their solutions. Every process maps it
+ * MAP_SHARED, so a solve done by one short-lived CLI run serves all later
+ * ones from the page cache.
+ *
+ * Slots go EMPTY -> BUSY -> READY exactly once: a writer claims an empty
+ * slot with a CAS, fills it and publishes it with a release store. A
+ * READY slot is never rewritten, so readers take no lock. A writer that
+ * dies mid-insert only leaves one dead BUSY slot behind.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "kmap_internal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DISK_MAGIC 0x3130434450414D4BULL       // "KMAPDC01"
+#define DISK_VERSION 1
+#define DISK_PROBE 8                            // Slots searched per lookup
+#define DISK_DEFAULT_ENTRIES (1 << 18)          // 22 MB file, sparse until filled
+
+/* Slot states */
+#define DISK_EMPTY 0
+#define DISK_BUSY 1
+#define DISK_READY 2
+
+/**
+ * @brief File header, 64 bytes
+ */
+typedef struct {
+    uint64_t magic;                             // DISK_MAGIC
+    uint32_t version;                           // DISK_VERSION
+    uint32_t entry_size;                        // sizeof(disk_entry_t) of the creator
+    uint64_t capacity;                          // Slots, power of two
+    uint64_t used;                              // READY slots (atomic, shared)
+    uint8_t reserved[32];
+} disk_header_t;
+
+/**
+ * @brief One cached solution in canonical variable order, 88 bytes
+ */
+typedef struct {
+    uint32_t state;                             // DISK_* (atomic)
+    uint8_t num_vars;
+    uint8_t term_count;
+    uint8_t optimal;
+    uint8_t reserved;
+    uint64_t minterms;                          // Canonical key
+    uint64_t dont_cares;
+    uint16_t terms[MAX_GROUPS];                 // literal_mask << 8 | literal_values
+} disk_entry_t;
+
+static disk_header_t* disk_map;
+static disk_entry_t* disk_table;
+static size_t disk_capacity;
+static size_t disk_map_size;
+
+/* Counters of this process (atomic) */
+static uint64_t disk_lookups;
+static uint64_t disk_hits;
+static uint64_t disk_misses;
+
+/**
+ * @brief Slot hash (splitmix64 finalizer)
+ *
+ * Part of the file format: every process must probe the same slots, so
+ * this must not change without bumping DISK_VERSION.
+ */
+static inline uint64_t disk_hash(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars) {
+    uint64_t h = minterms ^ (dont_cares * 0x9E3779B97F4A7C15ULL) ^ num_vars;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+static inline bool entry_matches(const disk_entry_t* entry, const truth_table_t* canon) {
+    return entry->num_vars == canon->num_vars && entry->minterms == canon->minterms &&
+           entry->dont_cares == canon->dont_cares && entry->term_count <= MAX_GROUPS;
+}
+
+/**
+ * @brief Claim a slot in the probe window and publish a solution in it
+ */
+static void disk_insert(const truth_table_t* canon, uint64_t hash, const solution_t* solution) {
+    size_t mask = disk_capacity - 1;
+    
+    for (size_t p = 0; p < DISK_PROBE; p++) {
+        disk_entry_t* entry = &disk_table[(hash + p) & mask];
+        uint32_t expected = DISK_EMPTY;
+        
+        if (!__atomic_compare_exchange_n(&entry->state, &expected, DISK_BUSY, false,
+                                         __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            /* Another process got there first with the same table */
+            if (expected == DISK_READY && entry_matches(entry, canon)) return;
+            continue;
+        }
+        
+        entry->num_vars = canon->num_vars;
+        entry->term_count = solution->implicant_count;
+        entry->optimal = solution->optimal;
+        entry->minterms = canon->minterms;
+        entry->dont_cares = canon->dont_cares;
+        for (uint8_t i = 0; i < solution->implicant_count; i++) {
+            entry->terms[i] = (uint16_t)((solution->implicants[i].literal_mask << 8) |
+                                         solution->implicants[i].literal_values);
+        }
+        
+        __atomic_store_n(&entry->state, DISK_READY, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&disk_map->used, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    /* Probe window full: the table keeps what it has */
+}
+
+int disk_cached_solve(const truth_table_t* tt, solution_t* solution,
+                      const kmap_options_t* opts) {
+    kmap_options_t inner = *opts;
+    inner.flags &= ~KMAP_OPT_DISK_CACHE;
+    if (!disk_table) return find_prime_implicants_ex(tt, solution, &inner);
+    
+    truth_table_t canon;
+    uint8_t perm[MAX_VARIABLES];
+    uint8_t negate;
+    kmap_np_canonicalize(tt, &canon, perm, &negate);
+    
+    uint64_t hash = disk_hash(canon.minterms, canon.dont_cares, canon.num_vars);
+    size_t mask = disk_capacity - 1;
+    __atomic_fetch_add(&disk_lookups, 1, __ATOMIC_RELAXED);
+    
+    for (size_t p = 0; p < DISK_PROBE; p++) {
+        const disk_entry_t* entry = &disk_table[(hash + p) & mask];
+        uint32_t state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+        
+        if (state == DISK_EMPTY) break;
+        if (state != DISK_READY || !entry_matches(entry, &canon)) continue;
+        
+        np_expand_solution(tt, entry->terms, entry->term_count, entry->optimal, perm, negate,
+                           solution);
+        
+        /* The file is shared with other writers: never trust it blindly */
+        if (!validate_solution(tt, solution)) break;
+        
+        __atomic_fetch_add(&disk_hits, 1, __ATOMIC_RELAXED);
+        KMAP_STAT_ADD(solves, 1);
+        KMAP_STAT_ADD(cache_hits, 1);
+        return 0;
+    }
+    
+    KMAP_STAT_ADD(cache_misses, 1);
+    __atomic_fetch_add(&disk_misses, 1, __ATOMIC_RELAXED);
+    
+    int result = find_prime_implicants_ex(&canon, solution, &inner);
+    if (result != 0) return result;
+    
+    /* A cover cut short by a budget must not outlive this run */
+    if (solution->optimal) disk_insert(&canon, hash, solution);
+    
+    uint16_t terms[MAX_GROUPS];
+    uint8_t term_count = solution->implicant_count;
+    for (uint8_t i = 0; i < term_count; i++) {
+        terms[i] = (uint16_t)((solution->implicants[i].literal_mask << 8) |
+                              solution->implicants[i].literal_values);
+    }
+    np_expand_solution(tt, terms, term_count, solution->optimal, perm, negate, solution);
+    
+    return 0;
+}
+
+/* === FILE MANAGEMENT === */
+
+/**
+ * @brief Lock or unlock the whole file (fcntl record lock)
+ */
+static int lock_file(int fd, short type) {
+    struct flock lock;
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = type;
+    lock.l_whence = SEEK_SET;
+    
+    while (fcntl(fd, F_SETLKW, &lock) != 0) {
+        if (errno != EINTR) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Check an existing header, or write one into an empty file
+ * @return Capacity on success, 0 on failure (result in *status)
+ */
+static size_t prepare_file(int fd, size_t entries, int* status) {
+    struct stat st;
+    disk_header_t header;
+    
+    if (fstat(fd, &st) != 0) {
+        *status = -4;
+        return 0;
+    }
+    
+    if (st.st_size == 0) {
+        size_t capacity = DISK_PROBE;
+        while (capacity < entries) capacity <<= 1;
+        
+        memset(&header, 0, sizeof(header));
+        header.magic = DISK_MAGIC;
+        header.version = DISK_VERSION;
+        header.entry_size = sizeof(disk_entry_t);
+        header.capacity = capacity;
+        
+        /* ftruncate leaves the table sparse and zeroed: every slot EMPTY */
+        off_t size = (off_t)(sizeof(disk_header_t) + capacity * sizeof(disk_entry_t));
+        if (ftruncate(fd, size) != 0 ||
+            pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+            *status = -4;
+            return 0;
+        }
+        return capacity;
+    }
+    
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        header.magic != DISK_MAGIC || header.version != DISK_VERSION ||
+        header.entry_size != sizeof(disk_entry_t) || header.capacity < DISK_PROBE ||
+        (header.capacity & (header.capacity - 1)) != 0 ||
+        (uint64_t)st.st_size < sizeof(disk_header_t) + header.capacity * sizeof(disk_entry_t)) {
+        *status = -3;
+        return 0;
+    }
+    return (size_t)header.capacity;
+}
+
+int kmap_disk_cache_open(const char* path, size_t entries) {
+    if (!path) return -1;
+    if (entries == 0) entries = DISK_DEFAULT_ENTRIES;
+    if (entries > SIZE_MAX / 2 / sizeof(disk_entry_t)) return -1;
+    
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -4;
+    
+    /* Serialize creation against other processes opening the same file */
+    int status = 0;
+    if (lock_file(fd, F_WRLCK) != 0) {
+        close(fd);
+        return -4;
+    }
+    size_t capacity = prepare_file(fd, entries, &status);
+    lock_file(fd, F_UNLCK);
+    
+    if (capacity == 0) {
+        close(fd);
+        return status;
+    }
+    
+    size_t size = sizeof(disk_header_t) + capacity * sizeof(disk_entry_t);
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -4;
+    
+    kmap_disk_cache_close();
+    disk_map = (disk_header_t*)map;
+    disk_table = (disk_entry_t*)(disk_map + 1);
+    disk_capacity = capacity;
+    disk_map_size = size;
+    
+    return 0;
+}
+
+void kmap_disk_cache_close(void) {
+    if (disk_map) munmap(disk_map, disk_map_size);
+    disk_map = NULL;
+    disk_table = NULL;
+    disk_capacity = 0;
+    disk_map_size = 0;
+    
+    disk_lookups = disk_hits = disk_misses = 0;
+}
+
+void kmap_disk_cache_stats(kmap_cache_stats_t* stats) {
+    if (!stats) return;
+    
+    stats->lookups = __atomic_load_n(&disk_lookups, __ATOMIC_RELAXED);
+    stats->hits = __atomic_load_n(&disk_hits, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&disk_misses, __ATOMIC_RELAXED);
+    stats->evictions = 0;
+    stats->entries = disk_capacity;
+    stats->used = disk_map ? (size_t)__atomic_load_n(&disk_map->used, __ATOMIC_RELAXED) : 0;
+    stats->memory_bytes = disk_map_size;
+}
@@ -0,0 +1,674 @@
+/**
+ * @file kmap_espresso.c
+ * @brief Espresso-style heuristic minimizer on cube lists
+ *
+ * Works on lists of kmap_cube_t instead of cell bitmaps, so memory grows
+ * with the number of cubes rather than 2^n. The loop is the classic one:
+ * EXPAND against the off-set, IRREDUNDANT via tautology checks, then
+ * REDUCE / EXPAND / IRREDUNDANT while the cost keeps dropping. The result
+ * is an irredundant prime cover, not a proven minimum.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* Passes of REDUCE / EXPAND / IRREDUNDANT after the first cover */
+#define MAX_ESPRESSO_PASSES 16
+
+/**
+ * @brief Growable cube list
+ */
+typedef struct {
+    kmap_cube_t* cubes;
+    uint32_t count;
+    uint32_t capacity;
+} cube_list_t;
+
+/* === CUBE OPERATIONS === */
+
+static inline bool cubes_intersect(kmap_cube_t a, kmap_cube_t b) {
+    return ((a.values ^ b.values) & a.mask & b.mask) == 0;
+}
+
+/**
+ * @brief true if every cell of b is in a
+ */
+static inline bool cube_contains(kmap_cube_t a, kmap_cube_t b) {
+    return (a.mask & ~b.mask) == 0 && ((a.values ^ b.values) & a.mask) == 0;
+}
+
+/**
+ * @brief Cofactor of b with respect to an intersecting cube c
+ */
+static inline kmap_cube_t cube_cofactor(kmap_cube_t b, kmap_cube_t c) {
+    kmap_cube_t r;
+    r.mask = (uint16_t)(b.mask & ~c.mask);
+    r.values = (uint16_t)(b.values & r.mask);
+    return r;
+}
+
+static inline uint32_t cube_cost(kmap_cube_t c) {
+    return TERM_COST + (uint32_t)__builtin_popcount(c.mask);
+}
+
+static inline uint32_t cube_key(kmap_cube_t c) {
+    return ((uint32_t)c.mask << 16) | c.values;
+}
+
+static int compare_cubes(const void* a, const void* b) {
+    uint32_t ka = cube_key(*(const kmap_cube_t*)a);
+    uint32_t kb = cube_key(*(const kmap_cube_t*)b);
+    return (ka > kb) - (ka < kb);
+}
+
+/* === CUBE LISTS === */
+
+static bool list_push(cube_list_t* list, kmap_cube_t c) {
+    if (list->count == list->capacity) {
+        uint32_t capacity = list->capacity ? list->capacity * 2 : 16;
+        kmap_cube_t* grown = realloc(list->cubes, capacity * sizeof(kmap_cube_t));
+        if (!grown) return false;
+        list->cubes = grown;
+        list->capacity = capacity;
+    }
+    
+    list->cubes[list->count++] = c;
+    return true;
+}
+
+static void list_free(cube_list_t* list) {
+    free(list->cubes);
+    memset(list, 0, sizeof(cube_list_t));
+}
+
+static uint32_t list_cost(const cube_list_t* list) {
+    uint32_t cost = 0;
+    for (uint32_t i = 0; i < list->count; i++) cost += cube_cost(list->cubes[i]);
+    return cost;
+}
+
+/**
+ * @brief Append the cofactors of every cube in src that meets c
+ * @param skip Index in src to leave out (UINT32_MAX = none)
+ */
+static bool list_cofactor(cube_list_t* dst, const cube_list_t* src, kmap_cube_t c,
+                          uint32_t skip) {
+    for (uint32_t i = 0; i < src->count; i++) {
+        if (i == skip || !cubes_intersect(src->cubes[i], c)) continue;
+        if (!list_push(dst, cube_cofactor(src->cubes[i], c))) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Binate variable that appears in the most cubes (any variable if unate)
+ */
+static uint8_t split_variable(const kmap_cube_t* cubes, uint32_t count, bool* binate) {
+    uint32_t occurrences[MAX_WIDE_VARIABLES] = {0};
+    uint16_t pos = 0, neg = 0;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t mask = cubes[i].mask;
+        pos |= mask & cubes[i].values;
+        neg |= mask & ~cubes[i].values;
+        while (mask) {
+            occurrences[ctz(mask)]++;
+            mask &= mask - 1;
+        }
+    }
+    
+    uint16_t candidates = pos & neg;
+    *binate = candidates != 0;
+    if (!candidates) candidates = pos | neg;
+    
+    uint8_t best = ctz(candidates);
+    for (uint16_t rest = candidates; rest; rest &= rest - 1) {
+        uint8_t v = ctz(rest);
+        if (occurrences[v] > occurrences[best]) best = v;
+    }
+    return best;
+}
+
+/**
+ * @brief Cubes of a list on one side of variable v, with v dropped
+ */
+static bool list_shannon(cube_list_t* dst, const kmap_cube_t* cubes, uint32_t count,
+                         uint8_t v, bool value) {
+    uint16_t bit = (uint16_t)(1U << v);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        kmap_cube_t c = cubes[i];
+        if ((c.mask & bit) && ((c.values & bit) != 0) != value) continue;
+        
+        c.mask &= (uint16_t)~bit;
+        c.values &= (uint16_t)~bit;
+        if (!list_push(dst, c)) return false;
+    }
+    return true;
+}
+
+/* === TAUTOLOGY AND COMPLEMENT === */
+
+/**
+ * @brief Does the union of the cubes cover the whole space of free_count variables?
+ *
+ * Cube masks must lie inside the free variables. Shortcuts: a universal
+ * cube, too little total volume, or a unate list without a universal cube.
+ *
+ * @return 1 if tautology, 0 if not, -4 on allocation failure
+ */
+static int tautology(const kmap_cube_t* cubes, uint32_t count, uint8_t free_count) {
+    if (count == 0) return 0;
+    
+    uint64_t volume = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (cubes[i].mask == 0) return 1;
+        volume += 1ULL << (free_count - popcount(cubes[i].mask));
+    }
+    if (volume < (1ULL << free_count)) return 0;
+    
+    bool binate;
+    uint8_t v = split_variable(cubes, count, &binate);
+    if (!binate) return 0;
+    
+    int result = 1;
+    for (int side = 0; side < 2 && result == 1; side++) {
+        cube_list_t half = {0};
+        if (!list_shannon(&half, cubes, count, v, side != 0)) {
+            result = -4;
+        } else {
+            result = tautology(half.cubes, half.count, (uint8_t)(free_count - 1));
+        }
+        list_free(&half);
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Append the complement of a cube list to out
+ *
+ * Shannon expansion on the most binate variable; the two halves are
+ * sorted and identical cubes merged back without the split literal.
+ *
+ * @return 0 on success, -4 on allocation failure
+ */
+static int complement(const kmap_cube_t* cubes, uint32_t count, cube_list_t* out) {
+    if (count == 0) {
+        kmap_cube_t universe = {0, 0};
+        return list_push(out, universe) ? 0 : -4;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        if (cubes[i].mask == 0) return 0;
+    }
+    
+    if (count == 1) {
+        /* De Morgan as disjoint cubes: ~a, a&~b, a&b&~c, ... */
+        kmap_cube_t prefix = {0, 0};
+        for (uint16_t rest = cubes[0].mask; rest; rest &= rest - 1) {
+            uint16_t bit = rest & (uint16_t)-rest;
+            kmap_cube_t c;
+            c.mask = prefix.mask | bit;
+            c.values = prefix.values | (~cubes[0].values & bit);
+            if (!list_push(out, c)) return -4;
+            
+            prefix.mask |= bit;
+            prefix.values |= cubes[0].values & bit;
+        }
+        return 0;
+    }
+    
+    bool binate;
+    uint8_t v = split_variable(cubes, count, &binate);
+    uint16_t bit = (uint16_t)(1U << v);
+    
+    cube_list_t half[2] = {{0}, {0}};
+    cube_list_t comp[2] = {{0}, {0}};
+    int result = 0;
+    
+    for (int side = 0; side < 2 && result == 0; side++) {
+        if (!list_shannon(&half[side], cubes, count, v, side != 0)) {
+            result = -4;
+        } else {
+            result = complement(half[side].cubes, half[side].count, &comp[side]);
+        }
+    }
+    
+    if (result == 0) {
+        for (int side = 0; side < 2; side++) {
+            if (comp[side].count > 1) {
+                qsort(comp[side].cubes, comp[side].count, sizeof(kmap_cube_t), compare_cubes);
+            }
+        }
+        
+        uint32_t i = 0, j = 0;
+        while ((i < comp[0].count || j < comp[1].count) && result == 0) {
+            kmap_cube_t c;
+            if (j == comp[1].count ||
+                (i < comp[0].count && cube_key(comp[0].cubes[i]) < cube_key(comp[1].cubes[j]))) {
+                c = comp[0].cubes[i++];
+                c.mask |= bit;
+            } else if (i == comp[0].count ||
+                       cube_key(comp[1].cubes[j]) < cube_key(comp[0].cubes[i])) {
+                c = comp[1].cubes[j++];
+                c.mask |= bit;
+                c.values |= bit;
+            } else {
+                /* Same cube on both sides: the literal drops out */
+                c = comp[0].cubes[i++];
+                j++;
+            }
+            if (!list_push(out, c)) result = -4;
+        }
+    }
+    
+    for (int side = 0; side < 2; side++) {
+        list_free(&half[side]);
+        list_free(&comp[side]);
+    }
+    return result;
+}
+
+/* === ESPRESSO STEPS === */
+
+/**
+ * @brief Order cubes by literal count (ascending = largest cubes first)
+ */
+static int compare_by_size(const void* a, const void* b) {
+    int la = __builtin_popcount(((const kmap_cube_t*)a)->mask);
+    int lb = __builtin_popcount(((const kmap_cube_t*)b)->mask);
+    if (la != lb) return la - lb;
+    return compare_cubes(a, b);
+}
+
+/**
+ * @brief Remove cubes flagged in dropped and compact the list
+ */
+static void list_compact(cube_list_t* list, const bool* dropped) {
+    uint32_t write = 0;
+    for (uint32_t i = 0; i < list->count; i++) {
+        if (!dropped[i]) list->cubes[write++] = list->cubes[i];
+    }
+    list->count = write;
+}
+
+/**
+ * @brief EXPAND: grow every cube into a prime that avoids the off-set
+ *
+ * conflict[r] holds the variables separating the cube from off-set cube r;
+ * a variable is blocked while it is the only conflict of some r.
+ * need[k] holds the literals still to raise before the cube swallows
+ * cube k of f. Like Espresso, raise the literal needed by the most cubes
+ * that can still be swallowed; with none left, raise the one that leaves
+ * the fewest off-set cubes a single conflict away.
+ */
+static int expand(cube_list_t* f, const cube_list_t* off) {
+    uint32_t f_size = f->count ? f->count : 1;
+    uint16_t* conflict = malloc((off->count ? off->count : 1) * sizeof(uint16_t));
+    uint16_t* need = malloc(f_size * sizeof(uint16_t));
+    uint32_t* feasible = malloc(f_size * sizeof(uint32_t));
+    bool* dropped = calloc(f_size, sizeof(bool));
+    if (!conflict || !need || !feasible || !dropped) {
+        free(conflict);
+        free(need);
+        free(feasible);
+        free(dropped);
+        return -4;
+    }
+    
+    if (f->count > 1) qsort(f->cubes, f->count, sizeof(kmap_cube_t), compare_by_size);
+    
+    for (uint32_t i = 0; i < f->count; i++) {
+        if (dropped[i]) continue;
+        
+        kmap_cube_t c = f->cubes[i];
+        for (uint32_t r = 0; r < off->count; r++) {
+            kmap_cube_t o = off->cubes[r];
+            conflict[r] = (uint16_t)((c.values ^ o.values) & c.mask & o.mask);
+        }
+        
+        uint32_t feasible_count = 0;
+        bool first_step = true;
+        
+        for (;;) {
+            uint16_t blocked = 0;
+            uint32_t near[MAX_WIDE_VARIABLES] = {0};
+            
+            for (uint32_t r = 0; r < off->count; r++) {
+                uint16_t conf = conflict[r];
+                uint16_t rest = conf & (conf - 1);
+                if (rest == 0) {
+                    blocked |= conf;
+                } else if ((rest & (rest - 1)) == 0) {
+                    near[ctz(conf)]++;
+                    near[ctz(rest)]++;
+                }
+            }
+            
+            uint16_t raisable = c.mask & ~blocked;
+            if (!raisable) break;
+            
+            /* Already-prime cubes stop above without touching f */
+            if (first_step) {
+                for (uint32_t k = 0; k < f->count; k++) {
+                    if (k == i || dropped[k]) continue;
+                    kmap_cube_t o = f->cubes[k];
+                    need[k] = (uint16_t)(((c.values ^ o.values) & c.mask & o.mask) |
+                                         (c.mask & ~o.mask));
+                    feasible[feasible_count++] = k;
+                }
+                first_step = false;
+            }
+            
+            /* Blocked literals never come free again, so prune for good */
+            uint32_t wanted[MAX_WIDE_VARIABLES] = {0};
+            uint32_t write = 0;
+            for (uint32_t j = 0; j < feasible_count; j++) {
+                uint16_t literals = need[feasible[j]];
+                if (literals & blocked) continue;
+                feasible[write++] = feasible[j];
+                for (; literals; literals &= literals - 1) wanted[ctz(literals)]++;
+            }
+            feasible_count = write;
+            
+            uint8_t best = ctz(raisable);
+            for (uint16_t rest = raisable; rest; rest &= rest - 1) {
+                uint8_t v = ctz(rest);
+                if (wanted[v] > wanted[best] ||
+                    (wanted[v] == wanted[best] && near[v] < near[best])) {
+                    best = v;
+                }
+            }
+            
+            uint16_t bit = (uint16_t)(1U << best);
+            c.mask &= (uint16_t)~bit;
+            c.values &= (uint16_t)~bit;
+            for (uint32_t r = 0; r < off->count; r++) conflict[r] &= (uint16_t)~bit;
+            for (uint32_t j = 0; j < feasible_count; j++) need[feasible[j]] &= (uint16_t)~bit;
+        }
+        
+        /* Unchanged primes leave absorption to IRREDUNDANT */
+        if (first_step) continue;
+        
+        f->cubes[i] = c;
+        for (uint32_t k = 0; k < f->count; k++) {
+            if (k != i && !dropped[k] && cube_contains(c, f->cubes[k])) dropped[k] = true;
+        }
+    }
+    
+    list_compact(f, dropped);
+    
+    free(conflict);
+    free(need);
+    free(feasible);
+    free(dropped);
+    return 0;
+}
+
+/**
+ * @brief true if cube i of f is covered by the rest of f plus dc
+ * @return 1 if covered, 0 if not, -4 on allocation failure
+ */
+static int cube_covered(const cube_list_t* f, uint32_t i, const bool* dropped,
+                        const cube_list_t* dc, uint8_t num_vars) {
+    kmap_cube_t c = f->cubes[i];
+    cube_list_t rest = {0};
+    int result = 0;
+    
+    for (uint32_t k = 0; k < f->count && result == 0; k++) {
+        if (k == i || dropped[k] || !cubes_intersect(f->cubes[k], c)) continue;
+        if (!list_push(&rest, cube_cofactor(f->cubes[k], c))) result = -4;
+    }
+    if (result == 0 && !list_cofactor(&rest, dc, c, UINT32_MAX)) result = -4;
+    
+    if (result == 0) {
+        result = tautology(rest.cubes, rest.count, (uint8_t)(num_vars - popcount(c.mask)));
+    }
+    
+    list_free(&rest);
+    return result;
+}
+
+/**
+ * @brief IRREDUNDANT: drop cubes covered by the others, smallest first
+ */
+static int irredundant(cube_list_t* f, const cube_list_t* dc, uint8_t num_vars) {
+    bool* dropped = calloc(f->count ? f->count : 1, sizeof(bool));
+    if (!dropped) return -4;
+    
+    if (f->count > 1) qsort(f->cubes, f->count, sizeof(kmap_cube_t), compare_by_size);
+    
+    for (uint32_t i = f->count; i-- > 0;) {
+        int covered = cube_covered(f, i, dropped, dc, num_vars);
+        if (covered < 0) {
+            free(dropped);
+            return covered;
+        }
+        if (covered) dropped[i] = true;
+    }
+    
+    list_compact(f, dropped);
+    free(dropped);
+    return 0;
+}
+
+/**
+ * @brief REDUCE: shrink each cube to the supercube of what only it covers
+ *
+ * Largest cubes first. The part of c nobody else covers is the complement
+ * of the cofactor of (f - c) + dc; c becomes c & supercube(that part).
+ */
+static int reduce(cube_list_t* f, const cube_list_t* dc) {
+    bool* dropped = calloc(f->count ? f->count : 1, sizeof(bool));
+    if (!dropped) return -4;
+    
+    if (f->count > 1) qsort(f->cubes, f->count, sizeof(kmap_cube_t), compare_by_size);
+    int result = 0;
+    
+    for (uint32_t i = 0; i < f->count && result == 0; i++) {
+        kmap_cube_t c = f->cubes[i];
+        cube_list_t rest = {0};
+        cube_list_t only = {0};
+        
+        for (uint32_t k = 0; k < f->count && result == 0; k++) {
+            if (k == i || dropped[k] || !cubes_intersect(f->cubes[k], c)) continue;
+            if (!list_push(&rest, cube_cofactor(f->cubes[k], c))) result = -4;
+        }
+        if (result == 0 && !list_cofactor(&rest, dc, c, UINT32_MAX)) result = -4;
+        if (result == 0) result = complement(rest.cubes, rest.count, &only);
+        
+        if (result == 0) {
+            if (only.count == 0) {
+                dropped[i] = true;
+            } else {
+                /* Supercube of the uncovered part */
+                uint16_t mask = only.cubes[0].mask;
+                uint16_t values = only.cubes[0].values;
+                for (uint32_t k = 1; k < only.count; k++) {
+                    mask &= only.cubes[k].mask & ~(values ^ only.cubes[k].values);
+                }
+                f->cubes[i].mask = c.mask | mask;
+                f->cubes[i].values = (uint16_t)(c.values | (values & mask));
+            }
+        }
+        
+        list_free(&rest);
+        list_free(&only);
+    }
+    
+    if (result == 0) list_compact(f, dropped);
+    free(dropped);
+    return result;
+}
+
+/**
+ * @brief Full Espresso loop on f in place
+ */
+static int espresso_loop(cube_list_t* f, const cube_list_t* dc, uint8_t num_vars) {
+    cube_list_t on_dc = {0};
+    cube_list_t off = {0};
+    cube_list_t best = {0};
+    int result = 0;
+    
+    for (uint32_t i = 0; i < f->count && result == 0; i++) {
+        if (!list_push(&on_dc, f->cubes[i])) result = -4;
+    }
+    for (uint32_t i = 0; i < dc->count && result == 0; i++) {
+        if (!list_push(&on_dc, dc->cubes[i])) result = -4;
+    }
+    if (result == 0) result = complement(on_dc.cubes, on_dc.count, &off);
+    list_free(&on_dc);
+    
+    if (result == 0) result = expand(f, &off);
+    if (result == 0) result = irredundant(f, dc, num_vars);
+    
+    uint32_t cost = list_cost(f);
+    for (int pass = 0; pass < MAX_ESPRESSO_PASSES && result == 0; pass++) {
+        best.count = 0;
+        for (uint32_t i = 0; i < f->count && result == 0; i++) {
+            if (!list_push(&best, f->cubes[i])) result = -4;
+        }
+        
+        if (result == 0) result = reduce(f, dc);
+        if (result == 0) result = expand(f, &off);
+        if (result == 0) result = irredundant(f, dc, num_vars);
+        if (result != 0) break;
+        
+        uint32_t new_cost = list_cost(f);
+        if (new_cost >= cost) {
+            /* No gain: keep the previous cover */
+            if (new_cost > cost) {
+                memcpy(f->cubes, best.cubes, best.count * sizeof(kmap_cube_t));
+                f->count = best.count;
+            }
+            break;
+        }
+        cost = new_cost;
+    }
+    
+    list_free(&off);
+    list_free(&best);
+    return result;
+}
+
+/* === PUBLIC ENTRY POINTS === */
+
+static bool valid_cube(kmap_cube_t c, uint16_t all) {
+    return (c.mask & ~all) == 0 && (c.values & ~c.mask) == 0;
+}
+
+int espresso_minimize(const kmap_cube_t* on, uint32_t on_count,
+                      const kmap_cube_t* dc, uint32_t dc_count,
+                      uint8_t num_vars, kmap_cover_t* cover) {
+    if (!cover) return -1;
+    memset(cover, 0, sizeof(kmap_cover_t));
+    if ((!on && on_count > 0) || (!dc && dc_count > 0)) return -1;
+    if (num_vars < 2 || num_vars > MAX_WIDE_VARIABLES) return -1;
+    
+    uint16_t all = (uint16_t)((1U << num_vars) - 1);
+    cube_list_t f = {0};
+    cube_list_t d = {0};
+    int result = 0;
+    
+    for (uint32_t i = 0; i < on_count && result == 0; i++) {
+        if (!valid_cube(on[i], all)) result = -2;
+        else if (!list_push(&f, on[i])) result = -4;
+    }
+    for (uint32_t i = 0; i < dc_count && result == 0; i++) {
+        if (!valid_cube(dc[i], all)) result = -2;
+        else if (!list_push(&d, dc[i])) result = -4;
+    }
+    
+    if (result == 0 && f.count > 0) result = espresso_loop(&f, &d, num_vars);
+    
+    if (result == 0) {
+        /* Empty and constant-1 covers are trivially minimum */
+        cover->optimal = (f.count == 0) || (f.count == 1 && f.cubes[0].mask == 0);
+        cover->count = f.count;
+        for (uint32_t i = 0; i < f.count; i++) {
+            cover->literal_count += popcount(f.cubes[i].mask);
+        }
+        
+        /* Hand the list over, shrunk to fit */
+        cover->cubes = f.count ? realloc(f.cubes, f.count * sizeof(kmap_cube_t)) : NULL;
+        if (f.count && !cover->cubes) cover->cubes = f.cubes;
+        f.cubes = NULL;
+    }
+    
+    list_free(&f);
+    list_free(&d);
+    return result;
+}
+
+/**
+ * @brief One minterm cube per set cell of a word array
+ */
+static int cells_to_cubes(const uint64_t* words, size_t word_count, uint8_t num_vars,
+                          cube_list_t* out) {
+    uint16_t all = (uint16_t)((1U << num_vars) - 1);
+    
+    for (size_t w = 0; w < word_count; w++) {
+        for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+            kmap_cube_t c;
+            c.mask = all;
+            c.values = (uint16_t)(w * 64 + ctz(bits));
+            if (!list_push(out, c)) return -4;
+        }
+    }
+    return 0;
+}
+
+int espresso_solve_wide(const kmap_wide_table_t* tt, kmap_cover_t* cover) {
+    size_t words = kmap_wide_words(tt->num_vars);
+    cube_list_t on = {0};
+    cube_list_t dc = {0};
+    
+    int result = cells_to_cubes(tt->minterms, words, tt->num_vars, &on);
+    if (result == 0) result = cells_to_cubes(tt->dont_cares, words, tt->num_vars, &dc);
+    if (result == 0) {
+        result = espresso_minimize(on.cubes, on.count, dc.cubes, dc.count,
+                                   tt->num_vars, cover);
+    }
+    
+    list_free(&on);
+    list_free(&dc);
+    return result;
+}
+
+int espresso_solve(const truth_table_t* tt, solution_t* solution) {
+    uint64_t minterms = tt->minterms;
+    uint64_t dont_cares = tt->dont_cares;
+    kmap_wide_table_t wide;
+    kmap_cover_t cover;
+    
+    wide.minterms = &minterms;
+    wide.dont_cares = &dont_cares;
+    wide.num_vars = tt->num_vars;
+    
+    int result = espresso_solve_wide(&wide, &cover);
+    if (result != 0) return result;
+    
+    if (cover.count > MAX_GROUPS) {
+        kmap_cover_free(&cover);
+        return -3;
+    }
+    
+    memset(solution, 0, sizeof(solution_t));
+    for (uint32_t i = 0; i < cover.count; i++) {
+        implicant_t* imp = &solution->implicants[i];
+        imp->literal_mask = (uint8_t)cover.cubes[i].mask;
+        imp->literal_values = (uint8_t)cover.cubes[i].values;
+        imp->covered_minterms = cube_coverage(imp->literal_mask, imp->literal_values,
+                                              tt->num_vars) & tt->minterms;
+        imp->size = popcount(imp->covered_minterms);
+    }
+    solution->implicant_count = (uint8_t)cover.count;
+    solution->term_count = (uint8_t)cover.count;
+    solution->literal_count = (uint8_t)cover.literal_count;
+    solution->optimal = cover.optimal;
+    
+    kmap_cover_free(&cover);
+    return 0;
+}
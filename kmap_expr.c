@@ -0,0 +1,331 @@
+/**
+ * @file kmap_expr.c
+ * @brief Boolean expression input compiled to bit-parallel bytecode
+ *
+ * An expression such as "A&~B | C" is compiled once into a postfix
+ * program for a small stack machine. The program is then run on 64-bit
+ * words instead of single bits: variable v < 6 loads its projection
+ * mask (VAR_MASK_v, the cells where v is 1), so one run evaluates all 64
+ * assignments of a 6-variable table at once. Variables past F are
+ * constant within a word, so a wide table takes one run per word.
+ *
+ * Syntax, loosest binding first:
+ *   a | b, a + b      OR
+ *   a ^ b             XOR
+ *   a & b, a * b, ab  AND (juxtaposition too: "AB + ~CD")
+ *   ~a, !a, a'        NOT
+ *   A-P, 0, 1, (...)  variables, constants, grouping
+ * An optional trailing "d(0,3,...)" lists don't care cells, as in a
+ * minterm list. The table has as many variables as the highest letter
+ * used (at least 2) or the highest don't care cell needs.
+ */
+
+#include "kmap_internal.h"
+#include <ctype.h>
+#include <string.h>
+
+#define EXPR_MAX_OPS 512                        // Bytecode length limit
+#define EXPR_MAX_DEPTH 64                       // Evaluation stack limit
+#define EXPR_MAX_NESTING 64                     // Parenthesis / prefix depth limit
+
+/* Opcodes: 0-15 push variable v, then constants and operators */
+#define OP_ZERO 0x10
+#define OP_ONE 0x11
+#define OP_NOT 0x20
+#define OP_AND 0x21
+#define OP_OR 0x22
+#define OP_XOR 0x23
+
+/**
+ * @brief Compiled expression
+ */
+typedef struct {
+    uint8_t code[EXPR_MAX_OPS];
+    uint16_t length;
+    uint8_t num_vars;                           // Highest variable used + 1 (0 = none)
+} expr_program_t;
+
+/**
+ * @brief Recursive-descent compiler state
+ */
+typedef struct {
+    const char* input;
+    size_t len;
+    size_t pos;
+    expr_program_t* prog;
+    uint8_t depth;                              // Stack depth after the code so far
+    uint8_t nesting;
+    bool ok;
+} expr_parser_t;
+
+/* === COMPILER === */
+
+static char peek(expr_parser_t* p) {
+    while (p->pos < p->len && p->input[p->pos] != '\0' &&
+           isspace((unsigned char)p->input[p->pos])) {
+        p->pos++;
+    }
+    return (p->pos < p->len) ? p->input[p->pos] : '\0';
+}
+
+/**
+ * @brief Append an opcode; delta is its effect on the stack depth
+ */
+static void emit_op(expr_parser_t* p, uint8_t op, int delta) {
+    if (p->prog->length >= EXPR_MAX_OPS || p->depth + delta > EXPR_MAX_DEPTH) {
+        p->ok = false;
+        return;
+    }
+    p->prog->code[p->prog->length++] = op;
+    p->depth = (uint8_t)(p->depth + delta);
+}
+
+/* Juxtaposition never starts at a digit, so "101" stays a bad binary string */
+static inline bool starts_implicit_and(char c) {
+    return (c >= 'A' && c <= 'P') || c == '(' || c == '~' || c == '!';
+}
+
+static void compile_or(expr_parser_t* p);
+
+static void compile_unary(expr_parser_t* p) {
+    if (!p->ok) return;
+    if (++p->nesting > EXPR_MAX_NESTING) {
+        p->ok = false;
+        return;
+    }
+    
+    char c = peek(p);
+    if (c == '~' || c == '!') {
+        p->pos++;
+        compile_unary(p);
+        emit_op(p, OP_NOT, 0);
+    } else if (c >= 'A' && c <= 'P') {
+        uint8_t var = (uint8_t)(c - 'A');
+        p->pos++;
+        emit_op(p, var, 1);
+        if (var + 1 > p->prog->num_vars) p->prog->num_vars = (uint8_t)(var + 1);
+    } else if (c == '0' || c == '1') {
+        p->pos++;
+        emit_op(p, c == '1' ? OP_ONE : OP_ZERO, 1);
+    } else if (c == '(') {
+        p->pos++;
+        compile_or(p);
+        if (peek(p) == ')') {
+            p->pos++;
+        } else {
+            p->ok = false;
+        }
+    } else {
+        p->ok = false;
+    }
+    
+    /* Postfix complement: A' and (A+B)'' */
+    while (p->ok && peek(p) == '\'') {
+        p->pos++;
+        emit_op(p, OP_NOT, 0);
+    }
+    
+    p->nesting--;
+}
+
+static void compile_and(expr_parser_t* p) {
+    compile_unary(p);
+    
+    for (;;) {
+        char c = peek(p);
+        if (c == '&' || c == '*' || c == '.') {
+            p->pos++;
+        } else if (!starts_implicit_and(c)) {
+            return;
+        }
+        compile_unary(p);
+        emit_op(p, OP_AND, -1);
+        if (!p->ok) return;
+    }
+}
+
+static void compile_xor(expr_parser_t* p) {
+    compile_and(p);
+    
+    while (p->ok && peek(p) == '^') {
+        p->pos++;
+        compile_and(p);
+        emit_op(p, OP_XOR, -1);
+    }
+}
+
+static void compile_or(expr_parser_t* p) {
+    compile_xor(p);
+    
+    for (;;) {
+        char c = peek(p);
+        if (!p->ok || (c != '|' && c != '+')) return;
+        p->pos++;
+        compile_xor(p);
+        emit_op(p, OP_OR, -1);
+    }
+}
+
+/**
+ * @brief Scan a trailing "d(...)" list, setting each cell in words
+ * @param words Don't care words to fill (NULL = only find the highest cell)
+ * @param word_count Number of words (cells beyond them are an error)
+ * @param max_cell Output highest cell listed (0 if none)
+ * @return 0 on success, -1 on a malformed list
+ */
+static int scan_dont_cares(expr_parser_t* p, uint64_t* words, size_t word_count,
+                           uint32_t* max_cell) {
+    *max_cell = 0;
+    
+    char c = peek(p);
+    if (c == '\0') return 0;
+    if (c != 'd') return -1;
+    p->pos++;
+    if (peek(p) != '(') return -1;
+    p->pos++;
+    
+    bool expect_number = true;
+    for (;;) {
+        c = peek(p);
+        if (c == ')' && !expect_number) break;
+        
+        if (c == ',' && !expect_number) {
+            expect_number = true;
+            p->pos++;
+            continue;
+        }
+        if (!isdigit((unsigned char)c) || !expect_number) return -1;
+        
+        uint32_t cell = 0;
+        while (p->pos < p->len && isdigit((unsigned char)p->input[p->pos])) {
+            cell = cell * 10 + (uint32_t)(p->input[p->pos++] - '0');
+            if (cell >= (1U << MAX_WIDE_VARIABLES)) return -1;
+        }
+        
+        if (cell > *max_cell) *max_cell = cell;
+        if (words) {
+            if (cell / 64 >= word_count) return -1;
+            words[cell / 64] |= 1ULL << (cell % 64);
+        }
+        expect_number = false;
+    }
+    
+    p->pos++;
+    return (peek(p) == '\0') ? 0 : -1;
+}
+
+/**
+ * @brief Compile the expression part and size the table
+ * @param parser Output parser, positioned after the expression
+ * @param num_vars Output table size
+ * @return 0 on success, -1 if the input is not an expression
+ */
+static int compile_expression(const char* input, size_t len, expr_program_t* prog,
+                              expr_parser_t* parser, uint8_t* num_vars) {
+    memset(parser, 0, sizeof(expr_parser_t));
+    parser->input = input;
+    parser->len = len;
+    parser->prog = prog;
+    parser->ok = true;
+    prog->length = 0;
+    prog->num_vars = 0;
+    
+    compile_or(parser);
+    if (!parser->ok || parser->depth != 1) return -1;
+    
+    /* The don't care cells can make the table wider than its letters */
+    expr_parser_t tail = *parser;
+    uint32_t max_cell;
+    if (scan_dont_cares(&tail, NULL, 0, &max_cell) != 0) return -1;
+    
+    uint8_t n = prog->num_vars < 2 ? 2 : prog->num_vars;
+    while ((1U << n) <= max_cell) n++;
+    *num_vars = n;
+    return 0;
+}
+
+/* === EVALUATOR === */
+
+/**
+ * @brief Run the program on one word of cells
+ * @param vars Value word of each variable (projection mask or constant)
+ */
+static uint64_t run_program(const expr_program_t* prog, const uint64_t* vars) {
+    uint64_t stack[EXPR_MAX_DEPTH];
+    uint32_t top = 0;
+    
+    for (uint16_t i = 0; i < prog->length; i++) {
+        uint8_t op = prog->code[i];
+        
+        switch (op) {
+            case OP_ZERO: stack[top++] = 0; break;
+            case OP_ONE: stack[top++] = ~0ULL; break;
+            case OP_NOT: stack[top - 1] = ~stack[top - 1]; break;
+            case OP_AND: top--; stack[top - 1] &= stack[top]; break;
+            case OP_OR: top--; stack[top - 1] |= stack[top]; break;
+            case OP_XOR: top--; stack[top - 1] ^= stack[top]; break;
+            default: stack[top++] = vars[op]; break;
+        }
+    }
+    
+    return stack[0];
+}
+
+static const uint64_t projection_masks[MAX_VARIABLES] = {
+    VAR_MASK_0, VAR_MASK_1, VAR_MASK_2, VAR_MASK_3, VAR_MASK_4, VAR_MASK_5
+};
+
+/* === PUBLIC API === */
+
+int parse_expression_n(const char* input, size_t len, truth_table_t* tt) {
+    if (!input || !tt) return -1;
+    
+    expr_program_t prog;
+    expr_parser_t parser;
+    uint8_t num_vars;
+    if (compile_expression(input, len, &prog, &parser, &num_vars) != 0) return -1;
+    if (num_vars > MAX_VARIABLES) return -1;
+    
+    uint64_t dont_cares = 0;
+    uint32_t max_cell;
+    if (scan_dont_cares(&parser, &dont_cares, 1, &max_cell) != 0) return -1;
+    
+    uint64_t cells = (num_vars == MAX_VARIABLES) ? ~0ULL : (1ULL << (1U << num_vars)) - 1;
+    uint64_t ones = run_program(&prog, projection_masks) & cells;
+    
+    return init_truth_table(ones & ~dont_cares, dont_cares, num_vars, tt);
+}
+
+int parse_expression_wide(const char* input, size_t len, kmap_wide_table_t* tt) {
+    if (!input || !tt) return -1;
+    memset(tt, 0, sizeof(kmap_wide_table_t));
+    
+    expr_program_t prog;
+    expr_parser_t parser;
+    uint8_t num_vars;
+    if (compile_expression(input, len, &prog, &parser, &num_vars) != 0) return -1;
+    if (num_vars > MAX_WIDE_VARIABLES) return -1;
+    
+    if (kmap_wide_table_init(tt, num_vars) != 0) return -4;
+    
+    size_t words = kmap_wide_words(num_vars);
+    uint32_t max_cell;
+    if (scan_dont_cares(&parser, tt->dont_cares, words, &max_cell) != 0) {
+        kmap_wide_table_free(tt);
+        return -1;
+    }
+    
+    /* Variables past F are constant across a word: bit v - 6 of its index */
+    uint64_t vars[MAX_WIDE_VARIABLES];
+    memcpy(vars, projection_masks, sizeof(projection_masks));
+    uint64_t cells = (num_vars >= MAX_VARIABLES) ? ~0ULL : (1ULL << (1U << num_vars)) - 1;
+    
+    for (size_t w = 0; w < words; w++) {
+        for (uint8_t v = MAX_VARIABLES; v < num_vars; v++) {
+            vars[v] = ((w >> (v - MAX_VARIABLES)) & 1) ? ~0ULL : 0;
+        }
+        tt->minterms[w] = run_program(&prog, vars) & cells & ~tt->dont_cares[w];
+    }
+    
+    return 0;
+}
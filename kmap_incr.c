@@ -0,0 +1,348 @@
+/**
+ * @file kmap_incr.c
+ * @brief Incremental re-minimization for single-cell edits
+ *
+ * A handle keeps every prime of the allowed set (1s and don't cares,
+ * including primes over don't cares only) next to the table. Changing
+ * one cell c only touches the primes through c:
+ *   - c joins the allowed set: every new prime contains c, so they are
+ *     the maximal implicants among the cubes through c, and the old
+ *     primes they swallow are dropped.
+ *   - c leaves the allowed set: primes through c die, and every new prime
+ *     is the half of a dead prime on the far side of c along one of its
+ *     free variables.
+ *   - 1 <-> don't care: the primes stay; only the cover changes.
+ * The cover is rebuilt lazily by the next kmap_handle_get_solution().
+ */
+
+#include "kmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Growable cube array
+ */
+typedef struct {
+    kmap_cube_t* cubes;
+    uint32_t count;
+    uint32_t capacity;
+} cube_vec_t;
+
+struct kmap_handle {
+    kmap_wide_table_t table;
+    uint64_t* allowed;                          // minterms | dont_cares
+    cube_vec_t primes;                          // Every prime of allowed
+    cube_vec_t dead;                            // Scratch: primes through the edited cell
+    cube_vec_t found;                           // Scratch: primes replacing them
+    kmap_cover_t cover;                         // Terms in arena
+    kmap_arena_t* arena;                        // Cover scratch, reset per re-cover
+    kmap_options_t opts;
+    bool primes_stale;                          // Regenerate from scratch on next read
+    bool cover_stale;                           // Re-cover on next read
+};
+
+/* === CUBE HELPERS === */
+
+static int cube_vec_push(cube_vec_t* vec, kmap_cube_t cube) {
+    if (vec->count == vec->capacity) {
+        uint32_t capacity = vec->capacity ? vec->capacity * 2 : 64;
+        kmap_cube_t* grown = realloc(vec->cubes, capacity * sizeof(kmap_cube_t));
+        if (!grown) return -4;
+        vec->cubes = grown;
+        vec->capacity = capacity;
+    }
+    
+    vec->cubes[vec->count++] = cube;
+    return 0;
+}
+
+static inline bool cube_has_cell(kmap_cube_t cube, uint32_t cell) {
+    return ((cell ^ cube.values) & cube.mask) == 0;
+}
+
+static inline bool cube_contains(kmap_cube_t outer, kmap_cube_t inner) {
+    return (outer.mask & ~inner.mask) == 0 && ((inner.values ^ outer.values) & outer.mask) == 0;
+}
+
+/**
+ * @brief Cube through cell with the given variables free
+ */
+static inline kmap_cube_t cube_through(uint32_t cell, uint16_t free_vars, uint8_t num_vars) {
+    kmap_cube_t cube;
+    cube.mask = (uint16_t)(~free_vars & ((1U << num_vars) - 1));
+    cube.values = (uint16_t)(cell & cube.mask);
+    return cube;
+}
+
+/* === PRIME MAINTENANCE === */
+
+/**
+ * @brief Collect the maximal implicants through cell into h->found
+ *
+ * Implicant free sets through a cell are closed under subsets, so a
+ * depth-first walk adding variables in increasing order reaches each of
+ * them once; a set is maximal when no variable at all can be added.
+ */
+static int grow_through(kmap_handle_t* h, uint32_t cell, uint16_t free_vars, uint8_t next_var) {
+    uint8_t n = h->table.num_vars;
+    bool maximal = true;
+    
+    for (uint8_t v = 0; v < n; v++) {
+        uint16_t var_bit = (uint16_t)(1U << v);
+        if (free_vars & var_bit) continue;
+        
+        uint16_t grown = (uint16_t)(free_vars | var_bit);
+        if (!wide_cube_within(cube_through(cell, grown, n), n, h->allowed)) continue;
+        
+        maximal = false;
+        if (v >= next_var) {
+            int result = grow_through(h, cell, grown, (uint8_t)(v + 1));
+            if (result != 0) return result;
+        }
+    }
+    
+    return maximal ? cube_vec_push(&h->found, cube_through(cell, free_vars, n)) : 0;
+}
+
+/**
+ * @brief Cell joined the allowed set
+ */
+static int add_allowed_cell(kmap_handle_t* h, uint32_t cell) {
+    h->found.count = 0;
+    int result = grow_through(h, cell, 0, 0);
+    if (result != 0) return result;
+    
+    /* Old primes inside a new one are no longer maximal */
+    uint32_t write = 0;
+    for (uint32_t i = 0; i < h->primes.count; i++) {
+        bool swallowed = false;
+        for (uint32_t k = 0; k < h->found.count && !swallowed; k++) {
+            swallowed = cube_contains(h->found.cubes[k], h->primes.cubes[i]);
+        }
+        if (!swallowed) h->primes.cubes[write++] = h->primes.cubes[i];
+    }
+    h->primes.count = write;
+    
+    for (uint32_t k = 0; k < h->found.count; k++) {
+        result = cube_vec_push(&h->primes, h->found.cubes[k]);
+        if (result != 0) return result;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief A half of a dead prime is prime unless it grows along another variable
+ */
+static bool half_is_prime(const kmap_handle_t* h, kmap_cube_t half, uint16_t split_bit) {
+    uint8_t n = h->table.num_vars;
+    
+    for (uint8_t u = 0; u < n; u++) {
+        uint16_t var_bit = (uint16_t)(1U << u);
+        if (!(half.mask & var_bit) || var_bit == split_bit) continue;
+        
+        kmap_cube_t grown;
+        grown.mask = (uint16_t)(half.mask & ~var_bit);
+        grown.values = (uint16_t)(half.values & ~var_bit);
+        if (wide_cube_within(grown, n, h->allowed)) return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Cell left the allowed set
+ */
+static int remove_allowed_cell(kmap_handle_t* h, uint32_t cell) {
+    uint16_t all = (uint16_t)((1U << h->table.num_vars) - 1);
+    
+    /* Primes avoiding the cell are still prime */
+    h->dead.count = 0;
+    uint32_t write = 0;
+    for (uint32_t i = 0; i < h->primes.count; i++) {
+        kmap_cube_t cube = h->primes.cubes[i];
+        if (!cube_has_cell(cube, cell)) {
+            h->primes.cubes[write++] = cube;
+        } else if (cube_vec_push(&h->dead, cube) != 0) {
+            return -4;
+        }
+    }
+    h->primes.count = write;
+    
+    h->found.count = 0;
+    for (uint32_t d = 0; d < h->dead.count; d++) {
+        kmap_cube_t cube = h->dead.cubes[d];
+        uint16_t free_vars = (uint16_t)(~cube.mask & all);
+        
+        while (free_vars) {
+            uint16_t split_bit = (uint16_t)(free_vars & -free_vars);
+            free_vars &= (uint16_t)(free_vars - 1);
+            
+            kmap_cube_t half;
+            half.mask = (uint16_t)(cube.mask | split_bit);
+            half.values = (uint16_t)(cube.values | (~cell & split_bit));
+            if (!half_is_prime(h, half, split_bit)) continue;
+            
+            /* Neighbouring dead primes can share a half */
+            bool seen = false;
+            for (uint32_t k = 0; k < h->found.count && !seen; k++) {
+                seen = (h->found.cubes[k].mask == half.mask &&
+                        h->found.cubes[k].values == half.values);
+            }
+            if (!seen && cube_vec_push(&h->found, half) != 0) return -4;
+        }
+    }
+    
+    for (uint32_t k = 0; k < h->found.count; k++) {
+        if (cube_vec_push(&h->primes, h->found.cubes[k]) != 0) return -4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Full prime generation over the allowed set
+ */
+static int regenerate_primes(kmap_handle_t* h) {
+    /* Every allowed cell counts as a 1 so primes over don't cares are kept */
+    kmap_wide_table_t view;
+    view.minterms = h->allowed;
+    view.dont_cares = h->allowed;
+    view.num_vars = h->table.num_vars;
+    
+    /* Generation scratch is dropped; the primes are copied out to grow in place */
+    kmap_arena_t* arena = kmap_thread_arena();
+    if (!arena) return -4;
+    
+    kmap_arena_mark_t mark = kmap_arena_mark(arena);
+    kmap_cube_t* primes = NULL;
+    uint32_t prime_count = 0;
+    int result = generate_wide_primes(&view, arena, &primes, &prime_count);
+    
+    if (result == 0 && prime_count > h->primes.capacity) {
+        kmap_cube_t* grown = realloc(h->primes.cubes, prime_count * sizeof(kmap_cube_t));
+        if (grown) {
+            h->primes.cubes = grown;
+            h->primes.capacity = prime_count;
+        } else {
+            result = -4;
+        }
+    }
+    
+    if (result == 0) {
+        if (prime_count) memcpy(h->primes.cubes, primes, prime_count * sizeof(kmap_cube_t));
+        h->primes.count = prime_count;
+        h->primes_stale = false;
+    }
+    
+    kmap_arena_release(arena, mark);
+    return result;
+}
+
+/* === HANDLE API === */
+
+kmap_handle_t* kmap_handle_create(const kmap_wide_table_t* tt, const kmap_options_t* opts) {
+    if (!validate_wide_table(tt)) return NULL;
+    
+    kmap_handle_t* h = calloc(1, sizeof(kmap_handle_t));
+    if (!h) return NULL;
+    
+    size_t words = kmap_wide_words(tt->num_vars);
+    h->allowed = malloc(words * sizeof(uint64_t));
+    h->arena = kmap_arena_create(0);
+    if (!h->allowed || !h->arena || kmap_wide_table_init(&h->table, tt->num_vars) != 0) {
+        kmap_handle_destroy(h);
+        return NULL;
+    }
+    
+    for (size_t w = 0; w < words; w++) {
+        h->table.minterms[w] = tt->minterms[w];
+        h->table.dont_cares[w] = tt->dont_cares[w];
+        h->allowed[w] = tt->minterms[w] | tt->dont_cares[w];
+    }
+    
+    if (opts) {
+        h->opts = *opts;
+    } else {
+        kmap_get_options(&h->opts);
+    }
+    
+    h->cover_stale = true;
+    if (regenerate_primes(h) != 0) {
+        kmap_handle_destroy(h);
+        return NULL;
+    }
+    
+    return h;
+}
+
+void kmap_handle_destroy(kmap_handle_t* h) {
+    if (!h) return;
+    
+    kmap_wide_table_free(&h->table);
+    kmap_arena_destroy(h->arena);
+    free(h->allowed);
+    free(h->primes.cubes);
+    free(h->dead.cubes);
+    free(h->found.cubes);
+    free(h);
+}
+
+int kmap_handle_update_cell(kmap_handle_t* h, uint32_t cell, int value) {
+    if (!h || cell >= (1U << h->table.num_vars)) return -1;
+    if (value != KMAP_CELL_ZERO && value != KMAP_CELL_ONE && value != KMAP_CELL_DONT_CARE) {
+        return -1;
+    }
+    
+    size_t w = cell / 64;
+    uint64_t bit = 1ULL << (cell % 64);
+    bool was_allowed = (h->allowed[w] & bit) != 0;
+    bool was_one = (h->table.minterms[w] & bit) != 0;
+    bool is_one = (value == KMAP_CELL_ONE);
+    bool is_allowed = (value != KMAP_CELL_ZERO);
+    
+    if (was_one == is_one && was_allowed == is_allowed) return 0;
+    
+    h->table.minterms[w] = is_one ? h->table.minterms[w] | bit : h->table.minterms[w] & ~bit;
+    h->table.dont_cares[w] = (value == KMAP_CELL_DONT_CARE) ? h->table.dont_cares[w] | bit :
+                                                               h->table.dont_cares[w] & ~bit;
+    h->allowed[w] = is_allowed ? h->allowed[w] | bit : h->allowed[w] & ~bit;
+    h->cover_stale = true;
+    
+    if (was_allowed == is_allowed || h->primes_stale) return 0;
+    
+    /* On failure the prime set is rebuilt on the next read */
+    int result = is_allowed ? add_allowed_cell(h, cell) : remove_allowed_cell(h, cell);
+    if (result != 0) h->primes_stale = true;
+    
+    return 0;
+}
+
+int kmap_handle_get_solution(kmap_handle_t* h, const kmap_cover_t** cover) {
+    if (!h || !cover) return -1;
+    
+    if (h->primes_stale) {
+        int result = regenerate_primes(h);
+        if (result != 0) return result;
+    }
+    
+    if (h->cover_stale) {
+        /* The previous cover is the only thing in the arena */
+        kmap_arena_reset(h->arena);
+        int result = cover_wide_primes(&h->table, h->primes.cubes, h->primes.count,
+                                       &h->opts, h->arena, &h->cover);
+        if (result != 0) return result;
+        h->cover_stale = false;
+    }
+    
+    *cover = &h->cover;
+    return 0;
+}
+
+const kmap_wide_table_t* kmap_handle_table(const kmap_handle_t* h) {
+    return h ? &h->table : NULL;
+}
+
+uint32_t kmap_handle_prime_count(const kmap_handle_t* h) {
+    return (h && !h->primes_stale) ? h->primes.count : 0;
+}
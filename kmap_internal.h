@@ -0,0 +1,447 @@
+/**
+ * @file kmap_internal.h
+ * @brief Private hooks shared between the K-map solver translation units
+ * 
+ * Not installed; nothing here is part of the public API.
+ */
+
+#ifndef KMAP_INTERNAL_H
+#define KMAP_INTERNAL_H
+
+#include "kmap_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Cells where each variable is 1 (variable 0 = A = least significant bit) */
+#define VAR_MASK_0 0xAAAAAAAAAAAAAAAAULL
+#define VAR_MASK_1 0xCCCCCCCCCCCCCCCCULL
+#define VAR_MASK_2 0xF0F0F0F0F0F0F0F0ULL
+#define VAR_MASK_3 0xFF00FF00FF00FF00ULL
+#define VAR_MASK_4 0xFFFF0000FFFF0000ULL
+#define VAR_MASK_5 0xFFFFFFFF00000000ULL
+
+/* One term outweighs any literal count: minimise terms, then literals */
+#define TERM_COST 256
+
+/* Longest formatted term: "~A + ~B + ..." is at most 5 chars per literal */
+#define MAX_TERM_CHARS (5 * MAX_WIDE_VARIABLES)
+
+/**
+ * @brief Append len bytes at pos, keeping whatever fits plus room for a NUL
+ * @return New cursor position (may run past output_len)
+ */
+static inline size_t emit_chars(char* output, size_t output_len, size_t pos,
+                                const char* chars, size_t len) {
+    if (pos + 1 < output_len) {
+        size_t room = output_len - 1 - pos;
+        memcpy(output + pos, chars, len < room ? len : room);
+    }
+    return pos + len;
+}
+
+/**
+ * @brief Form is SOP, POS, both or cheapest, optionally with KMAP_FORM_MAP
+ */
+static inline bool kmap_form_valid(int form) {
+    int base = form & ~KMAP_FORM_MAP;
+    return base > 0 && !(base & ~(KMAP_FORM_BOTH | KMAP_FORM_CHEAPEST));
+}
+
+/* === OUTPUT BUFFERS (kmap_stream.c, kmap_serve.c) === */
+
+/* Space kept free before each solve, so most answers fit the first time */
+#define LINE_RESERVE 256
+
+/**
+ * @brief Growable byte buffer (data is freed by its owner)
+ */
+typedef struct {
+    char* data;
+    size_t len;
+    size_t capacity;
+} kmap_buffer_t;
+
+/**
+ * @brief Keep more than extra bytes free, doubling from 4 KB
+ * @return false if the buffer could not grow
+ */
+static inline bool buffer_reserve(kmap_buffer_t* buffer, size_t extra) {
+    if (buffer->capacity - buffer->len > extra) return true;
+    
+    size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+    while (capacity - buffer->len <= extra) capacity *= 2;
+    
+    char* grown = realloc(buffer->data, capacity);
+    if (!grown) return false;
+    buffer->data = grown;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static inline bool buffer_append(kmap_buffer_t* buffer, const void* bytes, size_t len) {
+    if (!buffer_reserve(buffer, len)) return false;
+    memcpy(buffer->data + buffer->len, bytes, len);
+    buffer->len += len;
+    return true;
+}
+
+/**
+ * @brief Write one answer into dst, snprintf-style
+ * @return Length excluding the NUL, negative on error
+ */
+typedef int (*solve_into_fn)(const void* ctx, char* dst, size_t room);
+
+/**
+ * @brief Append one answer, growing the buffer and solving again if it is long
+ * @return 0 on success, the solver's error, or -4 if the buffer could not grow
+ */
+static inline int solve_into_buffer(kmap_buffer_t* buffer, solve_into_fn solve,
+                                    const void* ctx) {
+    for (;;) {
+        if (!buffer_reserve(buffer, LINE_RESERVE)) return -4;
+        
+        size_t room = buffer->capacity - buffer->len;
+        int needed = solve(ctx, buffer->data + buffer->len, room);
+        if (needed < 0) return needed;
+        if ((size_t)needed < room) {
+            buffer->len += (size_t)needed;
+            return 0;
+        }
+        
+        /* Too long for the reserve: grow to fit and solve again */
+        if (!buffer_reserve(buffer, (size_t)needed + 1)) return -4;
+    }
+}
+
+/* === SOLVER CORE (kmap_core.c) === */
+
+/**
+ * @brief Prime implicants as parallel arrays
+ * 
+ * Cover reduction and search scan only the coverage words, so those get
+ * a dense, cache-line-aligned array of their own (8 columns per line)
+ * that vector subset tests can stream through. solution_t stays the
+ * public form; terms are converted only once they are selected.
+ */
+typedef struct {
+    uint64_t covered[MAX_CUBES] __attribute__((aligned(64))); // Minterms of each prime
+    uint16_t cost[MAX_CUBES];                   // TERM_COST + literals
+    uint8_t literal_mask[MAX_CUBES];            // Which variables are present
+    uint8_t literal_values[MAX_CUBES];          // Values of present variables
+} prime_set_t;
+
+/**
+ * @brief Bit-parallel prime implicants, straight into parallel arrays
+ * @param minterms Cells that must be covered
+ * @param dont_cares Cells that may be covered
+ * @param num_vars Number of variables (2-6)
+ * @param set Output primes
+ * @return Number of primes
+ */
+uint16_t generate_prime_set(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars,
+                            prime_set_t* set);
+
+/**
+ * @brief Exact solve bypassing every cache
+ * @param tt Validated truth table
+ * @param solution Output solution
+ * @param opts Solver options (not NULL)
+ * @return 0 on success, negative on error
+ */
+int solve_uncached(const truth_table_t* tt, solution_t* solution,
+                   const kmap_options_t* opts);
+
+/**
+ * @brief Bit-parallel prime implicants of minterms | dont_cares
+ * 
+ * Primes covering only don't cares are dropped.
+ * 
+ * @param minterms Cells that must be covered
+ * @param dont_cares Cells that may be covered
+ * @param num_vars Number of variables (2-6)
+ * @param primes Output primes (MAX_CUBES entries)
+ * @return Number of primes
+ */
+uint16_t generate_prime_implicants(uint64_t minterms, uint64_t dont_cares,
+                                   uint8_t num_vars, implicant_t* primes);
+
+/**
+ * @brief Solve a (ptr, len) input into the requested form(s), snprintf-style
+ * @param input Input characters (any solve_kmap syntax, up to 16 variables)
+ * @param len Number of characters (SIZE_MAX = NUL-terminated)
+ * @param form KMAP_FORM_* value
+ * @param separator Written between SOP and POS for KMAP_FORM_BOTH
+ * @param output Output buffer (may be NULL if output_len is 0)
+ * @param output_len Buffer size
+ * @return Output length excluding the NUL, negative on error
+ */
+int solve_forms_n(const char* input, size_t len, int form, char separator,
+                  char* output, size_t output_len);
+
+/**
+ * @brief solve_forms_n() for a table that is already built, skipping the parse
+ * @param tt Table of 2-16 variables (up to 6 take the cached 64-bit path)
+ * @return Output length excluding the NUL, negative on error
+ */
+int solve_table_forms(const kmap_wide_table_t* tt, int form, char separator,
+                      char* output, size_t output_len);
+
+/**
+ * @brief Write the requested form(s) of solved rails, snprintf-style
+ * 
+ * KMAP_FORM_CHEAPEST needs both rails; otherwise only the requested one
+ * is read. With KMAP_FORM_MAP the grid of the first form written comes
+ * first, then a newline.
+ * 
+ * @param tt Table the rails were solved from
+ * @return Output length excluding the NUL, negative on error
+ */
+int emit_forms(const solution_t* sop, const solution_t* pos, const truth_table_t* tt, int form,
+               char separator, char* output, size_t output_len);
+
+/**
+ * @brief Format a cube as "A&~B" or, as a clause of the off-set, "~A + B"
+ * @param literal_mask Variables present
+ * @param literal_values Their values in the cube
+ * @param num_vars Number of variables (up to 16)
+ * @param clause Complement the literals and join them with " + "
+ * @param term Output characters (MAX_TERM_CHARS, not NUL-terminated)
+ * @return Number of characters written
+ */
+size_t format_term(uint16_t literal_mask, uint16_t literal_values, uint8_t num_vars,
+                   bool clause, char* term);
+
+/**
+ * @brief Exact minimum cover of up to 64 rows
+ * 
+ * @param columns Rows covered by each column
+ * @param costs Column costs
+ * @param count Number of columns (at most MAX_CUBES)
+ * @param rows Rows to cover
+ * @param opts Search budget (not NULL)
+ * @param selected Output column indices (up to 64)
+ * @param selected_count Output count
+ * @param optimal Cleared if the search budget ran out
+ * @return 0 on success, -4 if rows cannot be covered
+ */
+int solve_cover(const uint64_t* columns, const uint16_t* costs, uint32_t count,
+                uint64_t rows, const kmap_options_t* opts,
+                uint32_t* selected, uint32_t* selected_count, bool* optimal);
+
+/* === VECTOR KERNELS (kmap_simd.c) === */
+
+/**
+ * @brief First column at or after start that contains every given cell
+ * 
+ * Tests 4 (AVX2) or 8 (AVX-512) columns per step, picked at runtime.
+ * 
+ * @param columns Column coverage masks (64-byte aligned is fastest)
+ * @param start First column to test
+ * @param count Number of columns
+ * @param cells Cells that must all be present
+ * @return Column index, or count if there is none
+ */
+uint32_t find_superset_column(const uint64_t* columns, uint32_t start, uint32_t count,
+                              uint64_t cells);
+
+/**
+ * @brief Kernel sets for kmap_simd_force
+ */
+typedef enum {
+    KMAP_SIMD_AUTO = 0,                         // Widest the CPU supports
+    KMAP_SIMD_SCALAR,
+    KMAP_SIMD_SSE2,
+    KMAP_SIMD_AVX2,
+    KMAP_SIMD_AVX512
+} kmap_simd_level_t;
+
+/**
+ * @brief Pin the dispatched kernels to one instruction set (tests, benchmarks)
+ * 
+ * Not safe while other threads parse or reduce covers.
+ * 
+ * @param level Kernel set; KMAP_SIMD_AUTO restores runtime detection
+ * @return 0 on success, -1 if this build or CPU lacks the instruction set
+ */
+int kmap_simd_force(kmap_simd_level_t level);
+
+/* === STATISTICS HOOKS (kmap_stats.c) === */
+
+#ifdef KMAP_STATS
+
+extern __thread kmap_stats_t* kmap_stats_self;
+
+/**
+ * @brief Allocate and register the calling thread's counter block
+ */
+kmap_stats_t* kmap_stats_register(void);
+
+/**
+ * @brief Monotonic clock in nanoseconds
+ */
+uint64_t kmap_stats_now(void);
+
+/**
+ * @brief Charge the time since start_ns to a stage
+ */
+void kmap_stage_add(int stage, uint64_t start_ns);
+
+static inline kmap_stats_t* kmap_stats_local(void) {
+    return kmap_stats_self ? kmap_stats_self : kmap_stats_register();
+}
+
+/* Only the owning thread writes a block; readers load relaxed */
+static inline void kmap_stat_add(uint64_t* counter, uint64_t n) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+#define KMAP_STAT_ADD(field, n) kmap_stat_add(&kmap_stats_local()->field, (uint64_t)(n))
+#define KMAP_STAGE_START(name) uint64_t name = kmap_stats_now()
+#define KMAP_STAGE_STOP(stage, name) kmap_stage_add(stage, name)
+
+#else
+
+#define KMAP_STAT_ADD(field, n) ((void)0)
+#define KMAP_STAGE_START(name) ((void)0)
+#define KMAP_STAGE_STOP(stage, name) ((void)0)
+
+#endif /* KMAP_STATS */
+
+/* === ARENA SCOPES (kmap_arena.c) === */
+
+/**
+ * @brief Arena position to roll back to
+ */
+typedef struct {
+    void* block;
+    size_t used;
+} kmap_arena_mark_t;
+
+/**
+ * @brief Current position of the arena
+ */
+kmap_arena_mark_t kmap_arena_mark(const kmap_arena_t* arena);
+
+/**
+ * @brief Free everything allocated since the mark (blocks are kept)
+ */
+void kmap_arena_release(kmap_arena_t* arena, kmap_arena_mark_t mark);
+
+/**
+ * @brief Resize an allocation, in place when it is the newest one
+ * @return Resized allocation (contents kept), NULL on failure
+ */
+void* kmap_arena_grow(kmap_arena_t* arena, void* ptr, size_t old_size, size_t new_size);
+
+/* === WIDE ENGINE (kmap_wide.c) === */
+
+/**
+ * @brief All primes of minterms | dont_cares that cover some minterm
+ * @param tt Validated wide table
+ * @param arena Arena for scratch and the result
+ * @param primes Output array (in arena)
+ * @param prime_count Output count
+ * @return 0 on success, -4 on allocation failure or too many primes
+ */
+int generate_wide_primes(const kmap_wide_table_t* tt, kmap_arena_t* arena,
+                         kmap_cube_t** primes, uint32_t* prime_count);
+
+/**
+ * @brief Minimum (or, past the exact core, greedy) cover over given primes
+ * 
+ * Primes that cover no minterm are allowed and simply never picked.
+ * 
+ * @param tt Validated wide table
+ * @param primes Candidate primes
+ * @param prime_count Number of candidates
+ * @param opts Solver options (not NULL)
+ * @param arena Arena for scratch and the result
+ * @param cover Output cover (terms in arena, not for kmap_cover_free)
+ * @return 0 on success, negative on error
+ */
+int cover_wide_primes(const kmap_wide_table_t* tt, const kmap_cube_t* primes,
+                      uint32_t prime_count, const kmap_options_t* opts,
+                      kmap_arena_t* arena, kmap_cover_t* cover);
+
+/**
+ * @brief Every cell of a cube is set in a multi-word cell mask
+ */
+bool wide_cube_within(kmap_cube_t cube, uint8_t num_vars, const uint64_t* cells);
+
+/* === HEURISTIC MINIMIZER (kmap_espresso.c) === */
+
+/**
+ * @brief Espresso on a validated 64-bit table
+ * @param tt Validated truth table
+ * @param solution Output solution
+ * @return 0 on success, -3 if the cover has more than MAX_GROUPS terms,
+ *         negative on error
+ */
+int espresso_solve(const truth_table_t* tt, solution_t* solution);
+
+/**
+ * @brief Espresso on a validated wide table
+ * @param tt Validated wide table
+ * @param cover Output cover
+ * @return 0 on success, negative on error
+ */
+int espresso_solve_wide(const kmap_wide_table_t* tt, kmap_cover_t* cover);
+
+/* === SOLUTION CACHES (kmap_cache.c) === */
+
+/**
+ * @brief Look up a memoized 4-variable solution
+ * @param minterms 16-bit truth table (no don't cares)
+ * @param solution Output solution on hit
+ * @return true on hit
+ */
+bool memo4_lookup(uint16_t minterms, solution_t* solution);
+
+/**
+ * @brief Memoize a 4-variable solution
+ * @param minterms 16-bit truth table (no don't cares)
+ * @param solution Solution to store; skipped unless proven optimal
+ */
+void memo4_store(uint16_t minterms, const solution_t* solution);
+
+/**
+ * @brief Solve through the NP-canonical cache
+ * @param tt Validated 5-6 variable truth table
+ * @param solution Output solution in the caller's variable order
+ * @param opts Solver options (not NULL)
+ * @return 0 on success, negative on error
+ */
+int npn_cached_solve(const truth_table_t* tt, solution_t* solution,
+                     const kmap_options_t* opts);
+
+/**
+ * @brief Map canonical terms back to the caller's variable order
+ * @param tt Original truth table
+ * @param terms Canonical terms (literal_mask << 8 | literal_values)
+ * @param term_count Number of terms
+ * @param optimal Cover is proven minimum
+ * @param perm Canonical variable i is original variable perm[i]
+ * @param negate Original variables complemented before permuting
+ * @param solution Output solution
+ */
+void np_expand_solution(const truth_table_t* tt, const uint16_t* terms, uint8_t term_count,
+                        uint8_t optimal, const uint8_t* perm, uint8_t negate,
+                        solution_t* solution);
+
+/* === PERSISTENT CACHE (kmap_disk.c) === */
+
+/**
+ * @brief Solve through the mapped cache file, inserting on a miss
+ * 
+ * Misses are solved with KMAP_OPT_DISK_CACHE cleared, so the in-memory
+ * caches still apply. Without an open cache file this is a plain solve.
+ * 
+ * @param tt Validated truth table
+ * @param solution Output solution in the caller's variable order
+ * @param opts Solver options (not NULL)
+ * @return 0 on success, negative on error
+ */
+int disk_cached_solve(const truth_table_t* tt, solution_t* solution,
+                      const kmap_options_t* opts);
+
+#endif /* KMAP_INTERNAL_H */
@@ -0,0 +1,249 @@
+/**
+ * @file kmap_multi.c
+ * @brief Multi-output minimization with a shared term pool
+ *
+ * Candidates are the multi-output primes: primes of every product of
+ * outputs, generated once per output subset with the bit-parallel QM
+ * kernel. Each output is then covered exactly over its candidates, with
+ * terms already used by other outputs priced at a fraction of a new
+ * term, and the passes repeat until the shared cost stops dropping.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+
+/* Price of wiring an existing shared term into one more output */
+#define REUSE_COST (TERM_COST / 4)
+
+/* Re-solve passes over all outputs after the first one */
+#define MAX_MULTI_PASSES 4
+
+/**
+ * @brief Candidate term with the outputs it may serve
+ */
+typedef struct {
+    uint64_t cells;                             // All cells of the cube
+    uint8_t literal_mask;
+    uint8_t literal_values;
+    uint8_t tag;                                // Outputs it is an implicant of
+    uint8_t users;                              // Outputs currently using it
+} multi_prime_t;
+
+/**
+ * @brief Shared cost: every used term once, plus its literals
+ */
+static uint32_t pool_cost(const multi_prime_t* primes, uint16_t count) {
+    uint32_t cost = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (primes[i].users) cost += TERM_COST + popcount(primes[i].literal_mask);
+    }
+    return cost;
+}
+
+/**
+ * @brief Collect the distinct primes of every output product
+ *
+ * Product T has allowed cells AND(f_i | d_i) over i in T; a prime of it
+ * is kept only if it covers a 1 of some output in T. Each distinct cube
+ * is then tagged with every output it is a useful implicant of.
+ */
+static uint16_t generate_multi_primes(const truth_table_t* tables, uint8_t count,
+                                      multi_prime_t* primes) {
+    static __thread implicant_t product_primes[MAX_CUBES];
+    static __thread int16_t slot[MAX_CUBES];
+    uint8_t num_vars = tables[0].num_vars;
+    uint16_t prime_count = 0;
+    
+    memset(slot, -1, sizeof(slot));
+    
+    for (uint16_t subset = 1; subset < (1U << count); subset++) {
+        uint64_t allowed = ~0ULL, ones = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            if (!(subset & (1U << i))) continue;
+            allowed &= tables[i].minterms | tables[i].dont_cares;
+            ones |= tables[i].minterms;
+        }
+        
+        ones &= allowed;
+        if (!ones) continue;
+        
+        uint16_t n = generate_prime_implicants(ones, allowed & ~ones, num_vars, product_primes);
+        for (uint16_t p = 0; p < n; p++) {
+            uint16_t key = cube_index(product_primes[p].literal_mask, product_primes[p].literal_values);
+            if (slot[key] >= 0) continue;
+            
+            slot[key] = (int16_t)prime_count;
+            primes[prime_count].literal_mask = product_primes[p].literal_mask;
+            primes[prime_count].literal_values = product_primes[p].literal_values;
+            primes[prime_count].cells = cube_coverage(product_primes[p].literal_mask,
+                                                      product_primes[p].literal_values, num_vars);
+            primes[prime_count].tag = 0;
+            primes[prime_count].users = 0;
+            prime_count++;
+        }
+    }
+    
+    for (uint16_t p = 0; p < prime_count; p++) {
+        for (uint8_t i = 0; i < count; i++) {
+            uint64_t allowed = tables[i].minterms | tables[i].dont_cares;
+            if (!(primes[p].cells & ~allowed) && (primes[p].cells & tables[i].minterms)) {
+                primes[p].tag |= (uint8_t)(1U << i);
+            }
+        }
+    }
+    
+    return prime_count;
+}
+
+/**
+ * @brief Cover one output over its candidates, pricing shared terms low
+ * @return 0 on success, negative on error
+ */
+static int cover_output(multi_prime_t* primes, uint16_t prime_count,
+                        const truth_table_t* tt, uint8_t output,
+                        const kmap_options_t* opts, bool* optimal) {
+    uint64_t columns[MAX_CUBES];
+    uint16_t costs[MAX_CUBES];
+    uint16_t index[MAX_CUBES];
+    uint32_t column_count = 0;
+    uint8_t bit = (uint8_t)(1U << output);
+    
+    for (uint16_t p = 0; p < prime_count; p++) {
+        primes[p].users &= (uint8_t)~bit;
+    }
+    
+    *optimal = true;
+    if (!tt->minterms) return 0;
+    
+    for (uint16_t p = 0; p < prime_count; p++) {
+        if (!(primes[p].tag & bit)) continue;
+        
+        columns[column_count] = primes[p].cells & tt->minterms;
+        costs[column_count] = (uint16_t)(primes[p].users ? REUSE_COST :
+                                         TERM_COST + popcount(primes[p].literal_mask));
+        index[column_count] = p;
+        column_count++;
+    }
+    
+    uint32_t selected[MAX_CELLS];
+    uint32_t selected_count;
+    int result = solve_cover(columns, costs, column_count, tt->minterms, opts,
+                             selected, &selected_count, optimal);
+    if (result != 0) return result;
+    
+    for (uint32_t i = 0; i < selected_count; i++) {
+        primes[index[selected[i]]].users |= bit;
+    }
+    
+    return 0;
+}
+
+int solve_kmap_multi(const truth_table_t* tables, uint8_t count,
+                     multi_solution_t* solution, const kmap_options_t* opts) {
+    static __thread multi_prime_t primes[MAX_CUBES];
+    static __thread uint8_t best_users[MAX_CUBES];
+    
+    if (!tables || !solution || count == 0 || count > MAX_OUTPUTS) return -1;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!validate_truth_table(&tables[i])) return -2;
+        if (tables[i].num_vars != tables[0].num_vars) return -2;
+    }
+    
+    kmap_options_t defaults;
+    if (!opts) {
+        kmap_get_options(&defaults);
+        opts = &defaults;
+    }
+    
+    memset(solution, 0, sizeof(multi_solution_t));
+    solution->num_outputs = count;
+    solution->num_vars = tables[0].num_vars;
+    for (uint8_t i = 0; i < count; i++) solution->output_minterms[i] = tables[i].minterms;
+    
+    uint16_t prime_count = generate_multi_primes(tables, count, primes);
+    
+    /* Biggest outputs first: they set up the terms others can reuse */
+    uint8_t order[MAX_OUTPUTS];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        while (j > 0 && tables[order[j - 1]].minterm_count < tables[i].minterm_count) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    
+    uint32_t best_cost = UINT32_MAX;
+    bool all_optimal = true;
+    
+    for (int pass = 0; pass <= MAX_MULTI_PASSES; pass++) {
+        bool pass_optimal = true;
+        
+        for (uint8_t k = 0; k < count; k++) {
+            bool optimal;
+            int result = cover_output(primes, prime_count, &tables[order[k]], order[k],
+                                      opts, &optimal);
+            if (result != 0) return result;
+            pass_optimal = pass_optimal && optimal;
+        }
+        
+        /* Later passes only re-solve against what the others settled on */
+        uint32_t cost = pool_cost(primes, prime_count);
+        if (cost >= best_cost) break;
+        
+        best_cost = cost;
+        all_optimal = pass_optimal;
+        for (uint16_t p = 0; p < prime_count; p++) best_users[p] = primes[p].users;
+    }
+    
+    /* Emit the pool and per-output selections */
+    for (uint16_t p = 0; p < prime_count; p++) {
+        if (!best_users[p]) continue;
+        if (solution->term_count == MAX_SHARED_TERMS) return -4;
+        
+        uint16_t t = solution->term_count++;
+        implicant_t* term = &solution->terms[t];
+        uint64_t ones = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            if (!(best_users[p] & (1U << i))) continue;
+            solution->output_terms[i][t / 64] |= 1ULL << (t % 64);
+            ones |= tables[i].minterms;
+        }
+        
+        term->literal_mask = primes[p].literal_mask;
+        term->literal_values = primes[p].literal_values;
+        term->covered_minterms = primes[p].cells & ones;
+        term->size = popcount(term->covered_minterms);
+        solution->literal_count += popcount(term->literal_mask);
+    }
+    
+    /* Exact per output, but the shared optimum is not proven */
+    solution->optimal = (count == 1) && all_optimal;
+    
+    return 0;
+}
+
+int multi_solution_output(const multi_solution_t* solution, uint8_t output,
+                          solution_t* single) {
+    if (!solution || !single || output >= solution->num_outputs) return -1;
+    
+    memset(single, 0, sizeof(solution_t));
+    
+    for (uint16_t t = 0; t < solution->term_count; t++) {
+        if (!(solution->output_terms[output][t / 64] & (1ULL << (t % 64)))) continue;
+        if (single->implicant_count == MAX_GROUPS) return -3;
+        
+        /* Shared terms record the 1s of all their users; keep this output's */
+        implicant_t* imp = &single->implicants[single->implicant_count++];
+        *imp = solution->terms[t];
+        imp->covered_minterms = cube_coverage(imp->literal_mask, imp->literal_values,
+                                              solution->num_vars) &
+                                solution->output_minterms[output];
+        imp->size = popcount(imp->covered_minterms);
+        single->literal_count += popcount(imp->literal_mask);
+    }
+    
+    single->term_count = single->implicant_count;
+    single->optimal = solution->optimal;
+    return 0;
+}
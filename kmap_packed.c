@@ -0,0 +1,123 @@
+/**
+ * @file kmap_packed.c
+ * @brief Packed binary solution format
+ *
+ * One record per solution, little-endian base-128 varints throughout:
+ *   byte 0          num_vars | 0x80 if the cover is proven optimal
+ *   varint          term count
+ *   varint, varint  literal mask, literal values (per term)
+ * Up to 7 variables every term is two bytes, so a record is usually
+ * smaller than its SOP string and needs no parsing to consume.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+
+#define PACKED_OPTIMAL 0x80
+
+/**
+ * @brief Append a varint at pos, writing only the bytes that fit
+ * @return New cursor position (may run past out_len)
+ */
+static size_t write_varint(uint8_t* out, size_t out_len, size_t pos, uint32_t value) {
+    do {
+        uint8_t byte = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value) byte |= 0x80;
+        if (pos < out_len) out[pos] = byte;
+        pos++;
+    } while (value);
+    
+    return pos;
+}
+
+/**
+ * @brief Read a varint of at most 32 bits
+ * 
+ * write_varint never emits a trailing zero group or bits past 32, so
+ * either one marks a corrupt record rather than a value to accept.
+ * 
+ * @return New cursor position, 0 if truncated or overlong
+ */
+static size_t read_varint(const uint8_t* data, size_t len, size_t pos, uint32_t* value) {
+    *value = 0;
+    
+    for (unsigned shift = 0; shift < 35 && pos < len; shift += 7) {
+        uint8_t byte = data[pos++];
+        if (shift == 28 && (byte & 0x70)) return 0;
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return (byte == 0 && shift > 0) ? 0 : pos;
+    }
+    
+    return 0;
+}
+
+int pack_solution(const solution_t* solution, uint8_t num_vars, uint8_t* out, size_t out_len) {
+    if (!solution || (!out && out_len > 0)) return -1;
+    if (num_vars > MAX_VARIABLES || solution->implicant_count > MAX_GROUPS) return -2;
+    
+    size_t pos = 0;
+    if (out_len > 0) out[0] = (uint8_t)(num_vars | (solution->optimal ? PACKED_OPTIMAL : 0));
+    pos++;
+    
+    pos = write_varint(out, out_len, pos, solution->implicant_count);
+    for (int i = 0; i < solution->implicant_count; i++) {
+        pos = write_varint(out, out_len, pos, solution->implicants[i].literal_mask);
+        pos = write_varint(out, out_len, pos, solution->implicants[i].literal_values);
+    }
+    
+    return (int)pos;
+}
+
+int pack_cover(const kmap_cover_t* cover, uint8_t num_vars, uint8_t* out, size_t out_len) {
+    if (!cover || (!out && out_len > 0)) return -1;
+    if (num_vars > MAX_WIDE_VARIABLES || (cover->count > 0 && !cover->cubes)) return -2;
+    
+    size_t pos = 0;
+    if (out_len > 0) out[0] = (uint8_t)(num_vars | (cover->optimal ? PACKED_OPTIMAL : 0));
+    pos++;
+    
+    pos = write_varint(out, out_len, pos, cover->count);
+    for (uint32_t i = 0; i < cover->count; i++) {
+        pos = write_varint(out, out_len, pos, cover->cubes[i].mask);
+        pos = write_varint(out, out_len, pos, cover->cubes[i].values);
+    }
+    
+    return (int)pos;
+}
+
+int unpack_solution(const uint8_t* data, size_t len, solution_t* solution, uint8_t* num_vars) {
+    if (!data || !solution || len == 0) return -1;
+    
+    uint8_t vars = data[0] & (uint8_t)~PACKED_OPTIMAL;
+    if (vars > MAX_VARIABLES) return -2;
+    
+    uint32_t count;
+    size_t pos = read_varint(data, len, 1, &count);
+    if (pos == 0) return -2;
+    if (count > MAX_GROUPS) return -3;
+    
+    memset(solution, 0, sizeof(solution_t));
+    uint8_t all = (uint8_t)((1U << vars) - 1);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t mask, values;
+        pos = read_varint(data, len, pos, &mask);
+        if (pos != 0) pos = read_varint(data, len, pos, &values);
+        if (pos == 0 || (mask & ~all) || (values & ~mask)) return -2;
+        
+        implicant_t* imp = &solution->implicants[i];
+        imp->literal_mask = (uint8_t)mask;
+        imp->literal_values = (uint8_t)values;
+        imp->covered_minterms = cube_coverage(imp->literal_mask, imp->literal_values, vars);
+        imp->size = popcount(imp->covered_minterms);
+        solution->literal_count += popcount(imp->literal_mask);
+    }
+    
+    solution->implicant_count = (uint8_t)count;
+    solution->term_count = (uint8_t)count;
+    solution->optimal = (data[0] & PACKED_OPTIMAL) != 0;
+    if (num_vars) *num_vars = vars;
+    
+    return (int)pos;
+}
@@ -0,0 +1,394 @@
+/**
+ * @file kmap_pool.c
+ * @brief Work-stealing thread pool for batch solving
+ *
+ * Each worker owns a deque holding a contiguous index range. Owners pop
+ * small chunks from the front; idle workers steal the back half of a
+ * victim's range. Cheap 2-variable items and dense 6-variable items can
+ * live in the same batch without leaving cores idle.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kmap_core.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Grain bounds for automatic chunk sizing */
+#define MIN_GRAIN 1
+#define MAX_GRAIN 256
+#define CHUNKS_PER_WORKER 16
+
+/**
+ * @brief Per-worker deque of item indices [begin, end)
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t begin;
+    size_t end;
+} work_deque_t;
+
+struct kmap_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;                  // Signals a new job generation
+    pthread_cond_t work_done;                   // Signals job completion
+    
+    pthread_t* threads;                         // Background workers (size - 1)
+    work_deque_t* deques;                       // One per worker, 0 = caller
+    unsigned size;                              // Total workers incl. caller
+    
+    /* Current job */
+    kmap_task_fn fn;
+    void* ctx;
+    size_t grain;
+    size_t remaining;                           // Items not yet processed
+    unsigned active;                            // Workers inside the job
+    unsigned long generation;                   // Bumped per job
+    bool shutdown;
+};
+
+typedef struct {
+    kmap_pool_t* pool;
+    unsigned index;
+} worker_arg_t;
+
+/* === DEQUE OPERATIONS === */
+
+/**
+ * @brief Pop up to grain items from the front of a worker's own deque
+ */
+static bool pop_local(work_deque_t* dq, size_t grain, size_t* begin, size_t* end) {
+    bool found = false;
+    
+    pthread_mutex_lock(&dq->lock);
+    if (dq->begin < dq->end) {
+        *begin = dq->begin;
+        *end = (dq->end - dq->begin > grain) ? dq->begin + grain : dq->end;
+        dq->begin = *end;
+        found = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    
+    return found;
+}
+
+/**
+ * @brief Steal the back half of another worker's range into our deque
+ */
+static bool steal_work(kmap_pool_t* pool, unsigned self) {
+    for (unsigned step = 1; step < pool->size; step++) {
+        work_deque_t* victim = &pool->deques[(self + step) % pool->size];
+        size_t begin = 0, end = 0;
+        
+        pthread_mutex_lock(&victim->lock);
+        if (victim->begin < victim->end) {
+            size_t avail = victim->end - victim->begin;
+            begin = (avail > pool->grain) ? victim->begin + avail / 2 : victim->begin;
+            end = victim->end;
+            victim->end = begin;
+        }
+        pthread_mutex_unlock(&victim->lock);
+        
+        if (begin < end) {
+            work_deque_t* own = &pool->deques[self];
+            pthread_mutex_lock(&own->lock);
+            own->begin = begin;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Process items until no deque has work left
+ */
+static void run_job(kmap_pool_t* pool, unsigned self) {
+    work_deque_t* own = &pool->deques[self];
+    size_t begin, end;
+    
+    for (;;) {
+        if (!pop_local(own, pool->grain, &begin, &end)) {
+            if (!steal_work(pool, self)) break;
+            continue;
+        }
+        
+        pool->fn(pool->ctx, begin, end);
+        
+        if (__atomic_sub_fetch(&pool->remaining, end - begin, __ATOMIC_ACQ_REL) == 0) {
+            pthread_mutex_lock(&pool->lock);
+            pthread_cond_broadcast(&pool->work_done);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+}
+
+static void* worker_main(void* arg) {
+    worker_arg_t* wa = (worker_arg_t*)arg;
+    kmap_pool_t* pool = wa->pool;
+    unsigned self = wa->index;
+    unsigned long seen = 0;
+    
+    free(wa);
+    
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        
+        seen = pool->generation;
+        pool->active++;
+        pthread_mutex_unlock(&pool->lock);
+        
+        run_job(pool, self);
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) pthread_cond_broadcast(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    /* Wide solves on this worker left a scratch arena behind */
+    kmap_thread_arena_free();
+    return NULL;
+}
+
+/* === POOL LIFECYCLE === */
+
+kmap_pool_t* kmap_pool_create(unsigned num_threads) {
+    if (num_threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (online > 0) ? (unsigned)online : 1;
+    }
+    
+    kmap_pool_t* pool = calloc(1, sizeof(kmap_pool_t));
+    if (!pool) return NULL;
+    
+    pool->size = num_threads;
+    pool->deques = calloc(num_threads, sizeof(work_deque_t));
+    pool->threads = calloc(num_threads, sizeof(pthread_t));
+    if (!pool->deques || !pool->threads) {
+        free(pool->deques);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    for (unsigned i = 0; i < num_threads; i++) {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+    }
+    
+    /* Worker 0 is the calling thread; spawn the rest */
+    for (unsigned i = 1; i < num_threads; i++) {
+        worker_arg_t* wa = malloc(sizeof(worker_arg_t));
+        if (wa) {
+            wa->pool = pool;
+            wa->index = i;
+        }
+        if (!wa || pthread_create(&pool->threads[i], NULL, worker_main, wa) != 0) {
+            free(wa);
+            /* Run with however many workers started; destroy only sees those */
+            for (unsigned j = i; j < num_threads; j++) {
+                pthread_mutex_destroy(&pool->deques[j].lock);
+            }
+            pool->size = i;
+            break;
+        }
+    }
+    
+    return pool;
+}
+
+void kmap_pool_destroy(kmap_pool_t* pool) {
+    if (!pool) return;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (unsigned i = 1; i < pool->size; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    
+    for (unsigned i = 0; i < pool->size; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+    }
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    
+    free(pool->threads);
+    free(pool->deques);
+    free(pool);
+}
+
+unsigned kmap_pool_size(const kmap_pool_t* pool) {
+    return pool ? pool->size : 0;
+}
+
+int kmap_pool_run(kmap_pool_t* pool, size_t count, size_t grain,
+                  kmap_task_fn fn, void* ctx) {
+    if (!pool || !fn) return -1;
+    if (count == 0) return 0;
+    
+    if (grain == 0) {
+        grain = count / ((size_t)pool->size * CHUNKS_PER_WORKER);
+        if (grain < MIN_GRAIN) grain = MIN_GRAIN;
+        if (grain > MAX_GRAIN) grain = MAX_GRAIN;
+    }
+    
+    /* Single worker - no point in waking anyone */
+    if (pool->size == 1) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            fn(ctx, begin, (count - begin > grain) ? begin + grain : count);
+        }
+        return 0;
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->grain = grain;
+    pool->remaining = count;
+    
+    /* Seed every deque with an equal contiguous share */
+    size_t share = count / pool->size;
+    size_t extra = count % pool->size;
+    size_t next = 0;
+    for (unsigned i = 0; i < pool->size; i++) {
+        size_t len = share + (i < extra ? 1 : 0);
+        pthread_mutex_lock(&pool->deques[i].lock);
+        pool->deques[i].begin = next;
+        pool->deques[i].end = next + len;
+        pthread_mutex_unlock(&pool->deques[i].lock);
+        next += len;
+    }
+    
+    pool->generation++;
+    pool->active++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    
+    /* The caller works as worker 0 */
+    run_job(pool, 0);
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->active--;
+    while (__atomic_load_n(&pool->remaining, __ATOMIC_ACQUIRE) != 0 || pool->active != 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    return 0;
+}
+
+/* === THREADED BATCH SOLVING === */
+
+typedef struct {
+    const truth_table_t* tables;
+    solution_t* solutions;
+    int* status;
+    
+    pthread_mutex_t error_lock;
+    size_t error_index;                         // Lowest failing item
+    int error_code;
+} batch_job_t;
+
+static void solve_batch_range(void* ctx, size_t begin, size_t end) {
+    batch_job_t* job = (batch_job_t*)ctx;
+    
+    for (size_t i = begin; i < end; i++) {
+        int result = solve_kmap_batch(&job->tables[i], 1, &job->solutions[i],
+                                      job->status ? &job->status[i] : NULL);
+        
+        if (result != 0) {
+            pthread_mutex_lock(&job->error_lock);
+            if (i < job->error_index) {
+                job->error_index = i;
+                job->error_code = result;
+            }
+            pthread_mutex_unlock(&job->error_lock);
+        }
+    }
+}
+
+int solve_kmap_batch_mt(kmap_pool_t* pool, const truth_table_t* tables, size_t count,
+                        solution_t* solutions, int* status) {
+    if (!pool) return solve_kmap_batch(tables, count, solutions, status);
+    if ((!tables || !solutions) && count > 0) return -1;
+    
+    batch_job_t job;
+    job.tables = tables;
+    job.solutions = solutions;
+    job.status = status;
+    job.error_index = (size_t)-1;
+    job.error_code = 0;
+    pthread_mutex_init(&job.error_lock, NULL);
+    
+    int result = kmap_pool_run(pool, count, 0, solve_batch_range, &job);
+    
+    pthread_mutex_destroy(&job.error_lock);
+    
+    return (result != 0) ? result : job.error_code;
+}
+
+typedef struct {
+    const uint64_t* minterms;
+    const uint64_t* dont_cares;
+    uint8_t num_vars;
+    kmap_array_result_t* results;
+    
+    pthread_mutex_t error_lock;
+    size_t error_index;                         // Lowest failing item
+    int error_code;
+} array_job_t;
+
+static void solve_array_range(void* ctx, size_t begin, size_t end) {
+    array_job_t* job = (array_job_t*)ctx;
+    
+    int result = solve_kmap_batch_arrays(job->minterms + begin,
+                                         job->dont_cares ? job->dont_cares + begin : NULL,
+                                         end - begin, job->num_vars, job->results + begin);
+    if (result == 0) return;
+    
+    size_t first = begin;
+    while (job->results[first].status == 0) first++;
+    
+    pthread_mutex_lock(&job->error_lock);
+    if (first < job->error_index) {
+        job->error_index = first;
+        job->error_code = result;
+    }
+    pthread_mutex_unlock(&job->error_lock);
+}
+
+int solve_kmap_batch_arrays_mt(kmap_pool_t* pool, const uint64_t* minterms,
+                               const uint64_t* dont_cares, size_t count, uint8_t num_vars,
+                               kmap_array_result_t* results) {
+    if (!pool) return solve_kmap_batch_arrays(minterms, dont_cares, count, num_vars, results);
+    if ((!minterms || !results) && count > 0) return -1;
+    
+    array_job_t job;
+    job.minterms = minterms;
+    job.dont_cares = dont_cares;
+    job.num_vars = num_vars;
+    job.results = results;
+    job.error_index = (size_t)-1;
+    job.error_code = 0;
+    pthread_mutex_init(&job.error_lock, NULL);
+    
+    int result = kmap_pool_run(pool, count, 0, solve_array_range, &job);
+    
+    pthread_mutex_destroy(&job.error_lock);
+    
+    return (result != 0) ? result : job.error_code;
+}
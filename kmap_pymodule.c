@@ -0,0 +1,614 @@
+/**
+ * @file kmap_pymodule.c
+ * @brief Native CPython extension `_kmapper`
+ *
+ * Calls the solver directly instead of through ctypes: no buffer object
+ * per call, no argument marshalling, and tables given as integer cell
+ * masks skip string parsing entirely. solve_many() converts its whole
+ * input while holding the GIL, then solves with the GIL released.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "kmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Inputs at least this long are wide enough to be worth releasing the GIL */
+#define RELEASE_GIL_INPUT 64
+
+#define STACK_OUTPUT 1024
+
+/**
+ * @brief One item of solve_many(): a string, or a table over pooled words
+ */
+typedef struct {
+    const char* input;                          // NULL for tables
+    size_t len;
+    size_t word_offset;                         // Minterm words, dont-care words follow
+    kmap_wide_table_t table;
+} batch_item_t;
+
+/* === ERRORS === */
+
+static PyObject* raise_solve_error(int code) {
+    const char* message;
+    
+    switch (code) {
+        case -1: message = "Invalid input format"; break;
+        case -2: message = "Invalid truth table structure"; break;
+        case -3: message = "Output buffer too small"; break;
+        case -4: message = "Solving algorithm failed"; break;
+        default: message = "Unknown error"; break;
+    }
+    
+    PyErr_Format(PyExc_ValueError, "K-map solving failed: %s (code %d)", message, code);
+    return NULL;
+}
+
+static int check_form(int form) {
+    if (kmap_form_valid(form)) return 0;
+    PyErr_Format(PyExc_ValueError, "invalid output form %d", form);
+    return -1;
+}
+
+/* === CONVERSION === */
+
+/**
+ * @brief Split a non-negative int into count little-endian 64-bit words
+ * @return 0 on success, -1 with an exception set
+ */
+static int int_to_words(PyObject* value, uint64_t* words, size_t count) {
+    if (!PyLong_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "cell masks must be ints");
+        return -1;
+    }
+    
+    if (count == 1) {
+        words[0] = PyLong_AsUnsignedLongLong(value);
+        if (words[0] == (uint64_t)-1 && PyErr_Occurred()) goto out_of_range;
+        return 0;
+    }
+    
+    PyObject* shift = PyLong_FromLong(64);
+    if (!shift) return -1;
+    
+    Py_INCREF(value);
+    PyObject* rest = value;
+    for (size_t w = 0; w < count && rest; w++) {
+        words[w] = PyLong_AsUnsignedLongLongMask(rest);
+        PyObject* next = PyNumber_Rshift(rest, shift);
+        Py_DECREF(rest);
+        rest = next;
+    }
+    Py_DECREF(shift);
+    if (!rest) return -1;
+    
+    /* Leftover bits, or -1 for a negative value */
+    int leftover = PyObject_IsTrue(rest);
+    Py_DECREF(rest);
+    if (leftover < 0) return -1;
+    if (leftover) goto out_of_range;
+    return 0;
+
+out_of_range:
+    PyErr_Clear();
+    PyErr_SetString(PyExc_ValueError, "cell masks must be non-negative and fit the table");
+    return -1;
+}
+
+/**
+ * @brief Variable count argument, checked before any words are sized from it
+ */
+static int check_num_vars(int num_vars, int max_vars) {
+    if (num_vars >= 2 && num_vars <= max_vars) return 0;
+    PyErr_Format(PyExc_ValueError, "num_vars must be 2-%d, got %d", max_vars, num_vars);
+    return -1;
+}
+
+/* === SOLVING === */
+
+/**
+ * @brief Solve a string input into a Python str
+ */
+static PyObject* solve_string(const char* input, size_t len, int form) {
+    char stack[STACK_OUTPUT];
+    int needed;
+    
+    if (len >= RELEASE_GIL_INPUT) {
+        Py_BEGIN_ALLOW_THREADS
+        needed = solve_forms_n(input, len, form, '\n', stack, sizeof(stack));
+        Py_END_ALLOW_THREADS
+    } else {
+        needed = solve_forms_n(input, len, form, '\n', stack, sizeof(stack));
+    }
+    if (needed < 0) return raise_solve_error(needed);
+    if ((size_t)needed < sizeof(stack)) return PyUnicode_FromStringAndSize(stack, needed);
+    
+    /* Wide covers: solve again into an exact-size buffer */
+    char* output = malloc((size_t)needed + 1);
+    if (!output) return PyErr_NoMemory();
+    
+    Py_BEGIN_ALLOW_THREADS
+    needed = solve_forms_n(input, len, form, '\n', output, (size_t)needed + 1);
+    Py_END_ALLOW_THREADS
+    
+    PyObject* result = (needed < 0) ? raise_solve_error(needed) :
+                                      PyUnicode_FromStringAndSize(output, needed);
+    free(output);
+    return result;
+}
+
+/**
+ * @brief Solve every item into one growing buffer (GIL not held)
+ * @return 0 on success, else the first error with its index in *failed
+ */
+static int solve_items(const batch_item_t* items, size_t count, int form,
+                       char** output, size_t* capacity, size_t* offsets, size_t* failed) {
+    size_t used = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        for (;;) {
+            size_t room = *capacity - used;
+            int needed = items[i].input ?
+                solve_forms_n(items[i].input, items[i].len, form, '\n', *output + used, room) :
+                solve_table_forms(&items[i].table, form, '\n', *output + used, room);
+            
+            if (needed < 0) {
+                *failed = i;
+                return needed;
+            }
+            if ((size_t)needed < room) {
+                offsets[i] = used;
+                used += (size_t)needed;
+                break;
+            }
+            
+            size_t grown = *capacity * 2;
+            if (grown < used + (size_t)needed + 1) grown = used + (size_t)needed + 1;
+            char* larger = realloc(*output, grown);
+            if (!larger) {
+                *failed = i;
+                return -4;
+            }
+            *output = larger;
+            *capacity = grown;
+        }
+    }
+    
+    offsets[count] = used;
+    return 0;
+}
+
+/**
+ * @brief Fill items from a tuple of str inputs and (minterms, dont_cares, num_vars)
+ * @return Pooled table words (caller frees), NULL with an exception set
+ */
+static uint64_t* gather_sequence(PyObject* sequence, batch_item_t* items, Py_ssize_t count) {
+    PyObject** objects = PySequence_Fast_ITEMS(sequence);
+    size_t words = 0;
+    
+    /* First pass: types and table sizes */
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = objects[i];
+        memset(&items[i], 0, sizeof(batch_item_t));
+        
+        if (PyUnicode_Check(item)) {
+            Py_ssize_t len;
+            items[i].input = PyUnicode_AsUTF8AndSize(item, &len);
+            if (!items[i].input) return NULL;
+            items[i].len = (size_t)len;
+            continue;
+        }
+        
+        int num_vars;
+        PyObject *minterms, *dont_cares;
+        if (!PyTuple_Check(item) ||
+            !PyArg_ParseTuple(item, "OOi;items must be str or (minterms, dont_cares, num_vars)",
+                              &minterms, &dont_cares, &num_vars)) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError,
+                                "items must be str or (minterms, dont_cares, num_vars)");
+            }
+            return NULL;
+        }
+        if (check_num_vars(num_vars, MAX_WIDE_VARIABLES) != 0) return NULL;
+        
+        items[i].table.num_vars = (uint8_t)num_vars;
+        items[i].word_offset = words;
+        words += 2 * kmap_wide_words((uint8_t)num_vars);
+    }
+    
+    uint64_t* pool = malloc((words ? words : 1) * sizeof(uint64_t));
+    if (!pool) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    
+    /* Second pass: cell masks (the pool no longer moves) */
+    for (Py_ssize_t i = 0; i < count; i++) {
+        if (items[i].input) continue;
+        
+        PyObject* item = objects[i];
+        size_t table_words = kmap_wide_words(items[i].table.num_vars);
+        uint64_t* minterms = pool + items[i].word_offset;
+        
+        if (int_to_words(PyTuple_GET_ITEM(item, 0), minterms, table_words) != 0 ||
+            int_to_words(PyTuple_GET_ITEM(item, 1), minterms + table_words, table_words) != 0) {
+            free(pool);
+            return NULL;
+        }
+        items[i].table.minterms = minterms;
+        items[i].table.dont_cares = minterms + table_words;
+    }
+    
+    return pool;
+}
+
+/**
+ * @brief Point items at (minterms, dont_cares) uint64 pairs of a buffer
+ * @return 0 on success, -1 with an exception set
+ */
+static int gather_buffer(const Py_buffer* view, int num_vars, batch_item_t* items,
+                         Py_ssize_t count) {
+    if (check_num_vars(num_vars, MAX_VARIABLES) != 0) return -1;
+    
+    uint64_t* pairs = (uint64_t*)view->buf;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        memset(&items[i], 0, sizeof(batch_item_t));
+        items[i].table.minterms = &pairs[2 * i];
+        items[i].table.dont_cares = &pairs[2 * i + 1];
+        items[i].table.num_vars = (uint8_t)num_vars;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Accept native uint64 formats ('Q' or 'L' on LP64), any byte order marker
+ */
+static bool is_uint64_format(const char* format) {
+    if (!format) return true;
+    if (*format == '@' || *format == '=' || *format == '<') format++;
+    if (format[1] != '\0') return false;
+    return *format == 'Q' || (*format == 'L' && sizeof(unsigned long) == 8);
+}
+
+/* === MODULE FUNCTIONS === */
+
+PyDoc_STRVAR(solve_doc,
+"solve(input, form=FORM_SOP) -> str\n\n"
+"Minimize a binary string, minterm list or other solve_kmap() input.");
+
+static PyObject* py_solve(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"input", "form", NULL};
+    const char* input;
+    Py_ssize_t len;
+    int form = KMAP_FORM_SOP;
+    (void)self;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|i:solve", keywords, &input, &len, &form)) {
+        return NULL;
+    }
+    if (check_form(form) != 0) return NULL;
+    
+    return solve_string(input, (size_t)len, form);
+}
+
+PyDoc_STRVAR(solve_table_doc,
+"solve_table(minterms, dont_cares, num_vars, form=FORM_SOP) -> str\n\n"
+"Minimize a table given as int cell masks (bit i = cell i), skipping the\n"
+"parser. Up to 16 variables.");
+
+static PyObject* py_solve_table(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"minterms", "dont_cares", "num_vars", "form", NULL};
+    PyObject *minterms, *dont_cares;
+    int num_vars;
+    int form = KMAP_FORM_SOP;
+    (void)self;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOi|i:solve_table", keywords,
+                                     &minterms, &dont_cares, &num_vars, &form)) {
+        return NULL;
+    }
+    if (check_form(form) != 0 || check_num_vars(num_vars, MAX_WIDE_VARIABLES) != 0) return NULL;
+    
+    size_t words = kmap_wide_words((uint8_t)num_vars);
+    uint64_t narrow[2];
+    uint64_t* cells = (words == 1) ? narrow : malloc(2 * words * sizeof(uint64_t));
+    if (!cells) return PyErr_NoMemory();
+    
+    PyObject* result = NULL;
+    if (int_to_words(minterms, cells, words) == 0 &&
+        int_to_words(dont_cares, cells + words, words) == 0) {
+        kmap_wide_table_t tt;
+        tt.minterms = cells;
+        tt.dont_cares = cells + words;
+        tt.num_vars = (uint8_t)num_vars;
+        
+        char stack[STACK_OUTPUT];
+        char* output = stack;
+        size_t output_len = sizeof(stack);
+        int needed = solve_table_forms(&tt, form, '\n', output, output_len);
+        
+        /* Wide covers: solve again into an exact-size buffer */
+        if (needed >= 0 && (size_t)needed >= output_len) {
+            output_len = (size_t)needed + 1;
+            output = malloc(output_len);
+            if (output) {
+                Py_BEGIN_ALLOW_THREADS
+                needed = solve_table_forms(&tt, form, '\n', output, output_len);
+                Py_END_ALLOW_THREADS
+            } else {
+                needed = -4;
+            }
+        }
+        
+        result = (needed < 0) ? raise_solve_error(needed) :
+                                PyUnicode_FromStringAndSize(output, needed);
+        if (output != stack) free(output);
+    }
+    
+    if (cells != narrow) free(cells);
+    return result;
+}
+
+PyDoc_STRVAR(solve_many_doc,
+"solve_many(items, form=FORM_SOP, num_vars=0) -> list[str]\n\n"
+"Minimize a list of str inputs and/or (minterms, dont_cares, num_vars)\n"
+"tuples, or a C-contiguous uint64 buffer of (minterms, dont_cares) pairs\n"
+"such as an (N, 2) ndarray, whose tables all have num_vars (2-6)\n"
+"variables. The solving runs with the GIL released.");
+
+static PyObject* py_solve_many(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"items", "form", "num_vars", NULL};
+    PyObject* source;
+    int form = KMAP_FORM_SOP;
+    int num_vars = 0;
+    (void)self;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|ii:solve_many", keywords,
+                                     &source, &form, &num_vars)) {
+        return NULL;
+    }
+    if (check_form(form) != 0) return NULL;
+    
+    Py_buffer view;
+    PyObject* sequence = NULL;
+    uint64_t* pool = NULL;
+    bool have_view = false;
+    Py_ssize_t count;
+    
+    if (PyObject_CheckBuffer(source) && !PyBytes_Check(source) && !PyByteArray_Check(source)) {
+        if (PyObject_GetBuffer(source, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) return NULL;
+        have_view = true;
+        
+        if (view.itemsize != 8 || !is_uint64_format(view.format) || view.len % 16 != 0) {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_TypeError,
+                            "buffer must hold uint64 (minterms, dont_cares) pairs");
+            return NULL;
+        }
+        count = view.len / 16;
+    } else {
+        /* A private tuple keeps every str (and its UTF-8) alive without the GIL */
+        sequence = PySequence_Tuple(source);
+        if (!sequence) return NULL;
+        count = PyTuple_GET_SIZE(sequence);
+    }
+    
+    PyObject* list = NULL;
+    size_t capacity = (size_t)count * 16 + 64;
+    batch_item_t* items = PyMem_Malloc(((size_t)count + 1) * sizeof(batch_item_t));
+    size_t* offsets = PyMem_Malloc(((size_t)count + 1) * sizeof(size_t));
+    char* output = malloc(capacity);
+    if (!items || !offsets || !output) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    
+    if (have_view) {
+        if (gather_buffer(&view, num_vars, items, count) != 0) goto done;
+    } else {
+        pool = gather_sequence(sequence, items, count);
+        if (!pool) goto done;
+    }
+    
+    int result;
+    size_t failed = 0;
+    Py_BEGIN_ALLOW_THREADS
+    result = solve_items(items, (size_t)count, form, &output, &capacity, offsets, &failed);
+    Py_END_ALLOW_THREADS
+    
+    if (result != 0) {
+        PyErr_Format(PyExc_ValueError, "K-map solving failed for item %zu (code %d)",
+                     failed, result);
+        goto done;
+    }
+    
+    list = PyList_New(count);
+    for (Py_ssize_t i = 0; list && i < count; i++) {
+        PyObject* text = PyUnicode_FromStringAndSize(output + offsets[i],
+                                                     (Py_ssize_t)(offsets[i + 1] - offsets[i]));
+        if (!text) Py_CLEAR(list);
+        else PyList_SET_ITEM(list, i, text);
+    }
+
+done:
+    free(output);
+    free(pool);
+    PyMem_Free(offsets);
+    PyMem_Free(items);
+    if (have_view) PyBuffer_Release(&view);
+    Py_XDECREF(sequence);
+    return list;
+}
+
+PyDoc_STRVAR(get_stats_doc,
+"get_stats() -> dict | None\n\n"
+"Solver counters and per-stage times (ns), or None if the core was\n"
+"built without KMAP_STATS.");
+
+static PyObject* py_get_stats(PyObject* self, PyObject* unused) {
+    static const char* const stage_names[KMAP_STAGE_COUNT] = {"parse", "primes", "cover", "emit"};
+    kmap_stats_t stats;
+    (void)self;
+    (void)unused;
+    
+    if (kmap_get_stats(&stats) != 0) Py_RETURN_NONE;
+    
+    PyObject* stages = PyDict_New();
+    for (int i = 0; stages && i < KMAP_STAGE_COUNT; i++) {
+        PyObject* stage = Py_BuildValue("{s:K,s:K}", "calls",
+                                        (unsigned long long)stats.stage_calls[i], "ns",
+                                        (unsigned long long)stats.stage_ns[i]);
+        if (!stage || PyDict_SetItemString(stages, stage_names[i], stage) != 0) Py_CLEAR(stages);
+        Py_XDECREF(stage);
+    }
+    if (!stages) return NULL;
+    
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K,s:N}",
+                         "solves", (unsigned long long)stats.solves,
+                         "cubes_examined", (unsigned long long)stats.cubes_examined,
+                         "primes_found", (unsigned long long)stats.primes_found,
+                         "cover_nodes", (unsigned long long)stats.cover_nodes,
+                         "cache_hits", (unsigned long long)stats.cache_hits,
+                         "cache_misses", (unsigned long long)stats.cache_misses,
+                         "stages", stages);
+}
+
+PyDoc_STRVAR(reset_stats_doc, "reset_stats()\n\nZero the solver counters.");
+
+static PyObject* py_reset_stats(PyObject* self, PyObject* unused) {
+    (void)self;
+    (void)unused;
+    kmap_reset_stats();
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(set_flags_doc,
+"set_flags(set_bits=0, clear_bits=0) -> int\n\n"
+"Update the process-wide KMAP_OPT_* flags of this core and return them.");
+
+static PyObject* py_set_flags(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"set_bits", "clear_bits", NULL};
+    unsigned int set_bits = 0, clear_bits = 0;
+    kmap_options_t opts;
+    (void)self;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|II", keywords, &set_bits, &clear_bits)) {
+        return NULL;
+    }
+    
+    kmap_get_options(&opts);
+    opts.flags = (opts.flags | set_bits) & ~clear_bits;
+    kmap_set_options(&opts);
+    return PyLong_FromUnsignedLong(opts.flags);
+}
+
+PyDoc_STRVAR(open_cache_doc,
+"open_cache(path, entries=0)\n\n"
+"Map a shared solution cache file (created if missing) and enable\n"
+"KMAP_OPT_DISK_CACHE. entries sizes a new file (0 = default).");
+
+static PyObject* py_open_cache(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"path", "entries", NULL};
+    PyObject* path;
+    Py_ssize_t entries = 0;
+    kmap_options_t opts;
+    (void)self;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&|n", keywords, PyUnicode_FSConverter,
+                                     &path, &entries)) {
+        return NULL;
+    }
+    if (entries < 0) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_ValueError, "entries must be non-negative");
+        return NULL;
+    }
+    
+    int result = kmap_disk_cache_open(PyBytes_AS_STRING(path), (size_t)entries);
+    if (result != 0) {
+        if (result == -3) {
+            PyErr_Format(PyExc_ValueError, "%s is not a compatible K-map cache file",
+                         PyBytes_AS_STRING(path));
+        } else {
+            PyErr_Format(PyExc_OSError, "cannot map cache file %s (code %d)",
+                         PyBytes_AS_STRING(path), result);
+        }
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+    
+    kmap_get_options(&opts);
+    opts.flags |= KMAP_OPT_DISK_CACHE;
+    kmap_set_options(&opts);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(cache_stats_doc,
+"cache_stats() -> dict\n\n"
+"Counters of the cache file: lookups, hits and misses of this process,\n"
+"entries, used (by every process) and memory_bytes.");
+
+static PyObject* py_cache_stats(PyObject* self, PyObject* unused) {
+    kmap_cache_stats_t stats;
+    (void)self;
+    (void)unused;
+    
+    kmap_disk_cache_stats(&stats);
+    return Py_BuildValue("{s:K,s:K,s:K,s:n,s:n,s:n}",
+                         "lookups", (unsigned long long)stats.lookups,
+                         "hits", (unsigned long long)stats.hits,
+                         "misses", (unsigned long long)stats.misses,
+                         "entries", (Py_ssize_t)stats.entries,
+                         "used", (Py_ssize_t)stats.used,
+                         "memory_bytes", (Py_ssize_t)stats.memory_bytes);
+}
+
+/* === MODULE DEFINITION === */
+
+static PyMethodDef kmapper_methods[] = {
+    {"solve", (PyCFunction)(void (*)(void))py_solve, METH_VARARGS | METH_KEYWORDS, solve_doc},
+    {"solve_table", (PyCFunction)(void (*)(void))py_solve_table, METH_VARARGS | METH_KEYWORDS,
+     solve_table_doc},
+    {"solve_many", (PyCFunction)(void (*)(void))py_solve_many, METH_VARARGS | METH_KEYWORDS,
+     solve_many_doc},
+    {"get_stats", py_get_stats, METH_NOARGS, get_stats_doc},
+    {"reset_stats", py_reset_stats, METH_NOARGS, reset_stats_doc},
+    {"set_flags", (PyCFunction)(void (*)(void))py_set_flags, METH_VARARGS | METH_KEYWORDS,
+     set_flags_doc},
+    {"open_cache", (PyCFunction)(void (*)(void))py_open_cache, METH_VARARGS | METH_KEYWORDS,
+     open_cache_doc},
+    {"cache_stats", py_cache_stats, METH_NOARGS, cache_stats_doc},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef kmapper_module = {
+    PyModuleDef_HEAD_INIT,
+    "_kmapper",
+    "Native bindings for the K-map solver core",
+    -1,
+    kmapper_methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit__kmapper(void) {
+    PyObject* module = PyModule_Create(&kmapper_module);
+    if (!module) return NULL;
+    
+    if (PyModule_AddIntConstant(module, "FORM_SOP", KMAP_FORM_SOP) != 0 ||
+        PyModule_AddIntConstant(module, "FORM_POS", KMAP_FORM_POS) != 0 ||
+        PyModule_AddIntConstant(module, "FORM_BOTH", KMAP_FORM_BOTH) != 0 ||
+        PyModule_AddIntConstant(module, "FORM_CHEAPEST", KMAP_FORM_CHEAPEST) != 0 ||
+        PyModule_AddIntConstant(module, "FORM_MAP", KMAP_FORM_MAP) != 0 ||
+        PyModule_AddIntConstant(module, "MAX_VARIABLES", MAX_WIDE_VARIABLES) != 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    
+    return module;
+}
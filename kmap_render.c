@@ -0,0 +1,136 @@
+/**
+ * @file kmap_render.c
+ * @brief ASCII K-map grids with the groups of a solved cover
+ *
+ * Columns are the low half of the variables and rows the high half, both
+ * in Gray order, so adjacent cells differ in one variable:
+ *
+ *   DC\BA  00  01  11  10
+ *      00  1a  0   0   1a
+ *      01  0   1b  1b  0
+ *      11  0   1b  1b  0
+ *      10  1a  0   0   1a
+ *   a: ~A&~C
+ *   b: A&C
+ *
+ * Each cell is its value followed by the letters of the groups that
+ * contain it, don't cares included; the legend gives each group's term.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+
+/* Group letters: a-z, then A-F (MAX_GROUPS = 32) */
+static const char group_letters[] = "abcdefghijklmnopqrstuvwxyzABCDEF";
+
+static const char var_names[] = "ABCDEF";
+
+/**
+ * @brief Append a character repeated count times
+ */
+static size_t emit_repeat(char* output, size_t output_len, size_t pos, char c, size_t count) {
+    for (size_t i = 0; i < count; i++) pos = emit_chars(output, output_len, pos, &c, 1);
+    return pos;
+}
+
+/**
+ * @brief Append the low bits of code, most significant first
+ */
+static size_t emit_code(char* output, size_t output_len, size_t pos, uint8_t code,
+                        uint8_t bits) {
+    for (uint8_t b = bits; b-- > 0;) {
+        pos = emit_chars(output, output_len, pos, (code >> b) & 1 ? "1" : "0", 1);
+    }
+    return pos;
+}
+
+int render_kmap(const truth_table_t* tt, const solution_t* groups, bool clauses,
+                char* output, size_t output_len) {
+    if (!tt || (!output && output_len > 0)) return -1;
+    if (!validate_truth_table(tt)) return -2;
+    if (groups && groups->implicant_count > MAX_GROUPS) return -2;
+    
+    const uint8_t num_vars = tt->num_vars;
+    const uint8_t col_vars = (uint8_t)((num_vars + 1) / 2);
+    const uint8_t row_vars = (uint8_t)(num_vars - col_vars);
+    const uint8_t group_count = groups ? groups->implicant_count : 0;
+    
+    /* Group cells once; the widest cell sets the column width */
+    uint64_t group_cells[MAX_GROUPS];
+    uint8_t depth[MAX_CELLS];
+    memset(depth, 0, sizeof(depth));
+    for (uint8_t g = 0; g < group_count; g++) {
+        const implicant_t* imp = &groups->implicants[g];
+        group_cells[g] = cube_coverage(imp->literal_mask, imp->literal_values, num_vars);
+        for (uint64_t cells = group_cells[g]; cells; cells &= cells - 1) depth[ctz(cells)]++;
+    }
+    
+    size_t width = col_vars;
+    for (uint16_t cell = 0; cell < (1U << num_vars); cell++) {
+        if ((size_t)depth[cell] + 1 > width) width = (size_t)depth[cell] + 1;
+    }
+    
+    /* Header: row variables, backslash, column variables (highest first) */
+    size_t pos = 0;
+    for (uint8_t v = num_vars; v-- > col_vars;) {
+        pos = emit_chars(output, output_len, pos, &var_names[v], 1);
+    }
+    pos = emit_chars(output, output_len, pos, "\\", 1);
+    for (uint8_t v = col_vars; v-- > 0;) {
+        pos = emit_chars(output, output_len, pos, &var_names[v], 1);
+    }
+    
+    const size_t label_width = (size_t)num_vars + 1;
+    const uint8_t cols = (uint8_t)(1U << col_vars);
+    const uint8_t rows = (uint8_t)(1U << row_vars);
+    
+    for (uint8_t col = 0; col < cols; col++) {
+        pos = emit_chars(output, output_len, pos, "  ", 2);
+        pos = emit_code(output, output_len, pos, (uint8_t)(col ^ (col >> 1)), col_vars);
+        if (col + 1 < cols) pos = emit_repeat(output, output_len, pos, ' ', width - col_vars);
+    }
+    
+    for (uint8_t row = 0; row < rows; row++) {
+        uint8_t row_gray = (uint8_t)(row ^ (row >> 1));
+        
+        pos = emit_chars(output, output_len, pos, "\n", 1);
+        pos = emit_repeat(output, output_len, pos, ' ', label_width - row_vars);
+        pos = emit_code(output, output_len, pos, row_gray, row_vars);
+        
+        for (uint8_t col = 0; col < cols; col++) {
+            uint8_t cell = (uint8_t)((row_gray << col_vars) | (col ^ (col >> 1)));
+            uint64_t bit = 1ULL << cell;
+            const char* value = (tt->dont_cares & bit) ? "X" : (tt->minterms & bit) ? "1" : "0";
+            
+            pos = emit_chars(output, output_len, pos, "  ", 2);
+            pos = emit_chars(output, output_len, pos, value, 1);
+            for (uint8_t g = 0; g < group_count; g++) {
+                if (group_cells[g] & bit) {
+                    pos = emit_chars(output, output_len, pos, &group_letters[g], 1);
+                }
+            }
+            
+            /* Pad all but the last column, so lines carry no trailing blanks */
+            if (col + 1 < cols) {
+                pos = emit_repeat(output, output_len, pos, ' ', width - 1 - depth[cell]);
+            }
+        }
+    }
+    
+    /* Legend: one line per group */
+    for (uint8_t g = 0; g < group_count; g++) {
+        const implicant_t* imp = &groups->implicants[g];
+        char term[MAX_TERM_CHARS];
+        size_t term_len = format_term(imp->literal_mask, imp->literal_values, num_vars,
+                                      clauses, term);
+        
+        pos = emit_chars(output, output_len, pos, "\n", 1);
+        pos = emit_chars(output, output_len, pos, &group_letters[g], 1);
+        pos = emit_chars(output, output_len, pos, ": ", 2);
+        pos = emit_chars(output, output_len, pos, term, term_len);
+    }
+    
+    if (output_len > 0) output[pos < output_len ? pos : output_len - 1] = '\0';
+    
+    return (int)pos;
+}
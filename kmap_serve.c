@@ -0,0 +1,520 @@
+/**
+ * @file kmap_serve.c
+ * @brief Unix-socket solver daemon with pipelined, batched requests
+ *
+ * One thread runs a poll() loop over the listening socket and every
+ * client. Each turn it reads what has arrived, cuts complete requests out
+ * of all connections into one batch, solves the batch on the pool, and
+ * queues each answer on its connection in request order. Clients may
+ * pipeline any number of requests without waiting for answers; a slow
+ * reader only stops its own connection from being read.
+ *
+ * Requests come in two framings, mixed freely on one connection:
+ *   line  - solve_kmap input up to '\n', optionally prefixed with
+ *           "sop:", "pos:", "both:" or "cheapest:"; the answer is one
+ *           line (KMAP_FORM_BOTH separates SOP and POS with a tab)
+ *   frame - byte 0x00, a form byte (0 = server default), a little-endian
+ *           uint32 length and the input; the answer is 0x00, a uint32
+ *           length and the text (KMAP_FORM_BOTH separates with '\n')
+ * A request that fails is answered with "error <code>".
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "kmap_internal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DEFAULT_MAX_CONNECTIONS 256
+#define DEFAULT_MAX_BATCH 4096
+#define CHUNK_REQUESTS 64                       // Requests per pool task (one output buffer)
+#define READ_SIZE 65536
+#define MAX_REQUEST_BYTES (4 << 20)             // Longer requests drop the connection
+#define OUTPUT_HIGH_WATER (1 << 20)             // Stop reading while this much is unsent
+
+#define FRAME_MARKER 0x00
+#define FRAME_HEADER 6                          // Marker, form, uint32 length
+
+typedef struct {
+    int fd;
+    kmap_buffer_t in;
+    size_t in_pos;                              // Bytes of in already cut into requests
+    kmap_buffer_t out;
+    size_t out_pos;                             // Bytes of out already sent
+    bool read_closed;                           // Peer finished sending
+    bool failed;                                // Protocol or I/O error: drop it
+} connection_t;
+
+/**
+ * @brief One request of the batch, pointing into its connection's input
+ */
+typedef struct {
+    const char* data;
+    size_t len;
+    uint32_t conn;
+    int form;
+    bool framed;
+    int status;
+    size_t out_offset;                          // Answer in chunks[index / CHUNK_REQUESTS]
+    size_t out_len;
+} request_t;
+
+struct kmap_server {
+    int listen_fd;
+    int wake[2];                                // Self-pipe for kmap_server_stop()
+    char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    kmap_pool_t* pool;
+    kmap_serve_options_t opts;
+    
+    connection_t* conns;
+    size_t conn_count;
+    struct pollfd* fds;
+    
+    request_t* batch;
+    size_t batch_count;
+    kmap_buffer_t* chunks;
+    
+    kmap_serve_stats_t stats;
+};
+
+static const struct {
+    const char* prefix;
+    size_t len;
+    int form;
+} line_forms[] = {
+    {"sop:", 4, KMAP_FORM_SOP},
+    {"pos:", 4, KMAP_FORM_POS},
+    {"both:", 5, KMAP_FORM_BOTH},
+    {"cheapest:", 9, KMAP_FORM_CHEAPEST},
+};
+
+/* === BUFFERS === */
+
+/**
+ * @brief Drop the first n bytes
+ */
+static void buffer_consume(kmap_buffer_t* buffer, size_t n) {
+    if (n == 0) return;
+    memmove(buffer->data, buffer->data + n, buffer->len - n);
+    buffer->len -= n;
+}
+
+/* === REQUEST FRAMING === */
+
+/**
+ * @brief Cut the next complete request out of a connection's input
+ * @return 1 if a request was cut, 0 if more input is needed, -1 on a protocol error
+ */
+static int next_request(const kmap_server_t* server, connection_t* conn, request_t* req) {
+    const char* p = conn->in.data + conn->in_pos;
+    size_t avail = conn->in.len - conn->in_pos;
+    if (avail == 0) return 0;
+    
+    req->form = server->opts.form;
+    req->status = 0;
+    
+    if ((unsigned char)p[0] == FRAME_MARKER) {
+        if (avail < FRAME_HEADER) return 0;
+        
+        uint32_t len = (uint32_t)(unsigned char)p[2] | (uint32_t)(unsigned char)p[3] << 8 |
+                       (uint32_t)(unsigned char)p[4] << 16 | (uint32_t)(unsigned char)p[5] << 24;
+        if (len > MAX_REQUEST_BYTES) return -1;
+        if (avail - FRAME_HEADER < len) return 0;
+        
+        if (p[1] != 0) req->form = (unsigned char)p[1];
+        req->data = p + FRAME_HEADER;
+        req->len = len;
+        req->framed = true;
+        conn->in_pos += FRAME_HEADER + len;
+        return 1;
+    }
+    
+    const char* newline = memchr(p, '\n', avail);
+    size_t len = newline ? (size_t)(newline - p) : avail;
+    if (!newline && !conn->read_closed) return (avail > MAX_REQUEST_BYTES) ? -1 : 0;
+    
+    conn->in_pos += len + (newline ? 1 : 0);
+    if (len > 0 && p[len - 1] == '\r') len--;
+    
+    for (size_t f = 0; f < sizeof(line_forms) / sizeof(line_forms[0]); f++) {
+        if (len >= line_forms[f].len && memcmp(p, line_forms[f].prefix, line_forms[f].len) == 0) {
+            req->form = line_forms[f].form;
+            p += line_forms[f].len;
+            len -= line_forms[f].len;
+            break;
+        }
+    }
+    
+    req->data = p;
+    req->len = len;
+    req->framed = false;
+    return 1;
+}
+
+/**
+ * @brief Gather complete requests from every connection, up to max_batch
+ * @return true if input that is already buffered was left for the next batch
+ */
+static bool collect_batch(kmap_server_t* server) {
+    bool backlog = false;
+    server->batch_count = 0;
+    
+    for (size_t c = 0; c < server->conn_count; c++) {
+        connection_t* conn = &server->conns[c];
+        if (conn->failed) continue;
+        
+        for (;;) {
+            if (server->batch_count == server->opts.max_batch) {
+                backlog = true;
+                break;
+            }
+            
+            request_t* req = &server->batch[server->batch_count];
+            int got = next_request(server, conn, req);
+            if (got < 0) conn->failed = true;
+            if (got <= 0) break;
+            
+            req->conn = (uint32_t)c;
+            server->batch_count++;
+        }
+    }
+    
+    return backlog;
+}
+
+/* === SOLVING === */
+
+/**
+ * @brief solve_into_fn for one request
+ */
+static int solve_request(const void* ctx, char* dst, size_t room) {
+    const request_t* req = (const request_t*)ctx;
+    char separator = req->framed ? '\n' : '\t';
+    return solve_forms_n(req->data, req->len, req->form, separator, dst, room);
+}
+
+static void solve_chunk_range(void* ctx, size_t begin, size_t end) {
+    kmap_server_t* server = (kmap_server_t*)ctx;
+    
+    for (size_t c = begin; c < end; c++) {
+        kmap_buffer_t* out = &server->chunks[c];
+        size_t first = c * CHUNK_REQUESTS;
+        size_t last = first + CHUNK_REQUESTS;
+        if (last > server->batch_count) last = server->batch_count;
+        
+        out->len = 0;
+        for (size_t i = first; i < last; i++) {
+            request_t* req = &server->batch[i];
+            req->out_offset = out->len;
+            
+            /* A grid spans lines, so only frames can carry one */
+            if (!kmap_form_valid(req->form) || ((req->form & KMAP_FORM_MAP) && !req->framed)) {
+                req->status = -1;
+            } else {
+                req->status = solve_into_buffer(out, solve_request, req);
+            }
+            
+            if (req->status != 0) {
+                char message[32];
+                int len = snprintf(message, sizeof(message), "error %d", req->status);
+                out->len = req->out_offset;
+                if (!buffer_append(out, message, (size_t)len)) len = 0;
+            }
+            req->out_len = out->len - req->out_offset;
+        }
+    }
+}
+
+/**
+ * @brief Solve the batch and queue every answer on its connection
+ */
+static void answer_batch(kmap_server_t* server) {
+    size_t chunk_count = (server->batch_count + CHUNK_REQUESTS - 1) / CHUNK_REQUESTS;
+    
+    if (server->pool) {
+        kmap_pool_run(server->pool, chunk_count, 1, solve_chunk_range, server);
+    } else {
+        solve_chunk_range(server, 0, chunk_count);
+    }
+    
+    for (size_t i = 0; i < server->batch_count; i++) {
+        const request_t* req = &server->batch[i];
+        connection_t* conn = &server->conns[req->conn];
+        const char* answer = server->chunks[i / CHUNK_REQUESTS].data + req->out_offset;
+        bool ok;
+        
+        if (req->status != 0) server->stats.failed++;
+        if (conn->failed) continue;
+        
+        if (req->framed) {
+            unsigned char header[5] = {
+                FRAME_MARKER, (unsigned char)req->out_len, (unsigned char)(req->out_len >> 8),
+                (unsigned char)(req->out_len >> 16), (unsigned char)(req->out_len >> 24)
+            };
+            ok = buffer_append(&conn->out, header, sizeof(header)) &&
+                 buffer_append(&conn->out, answer, req->out_len);
+        } else {
+            ok = buffer_append(&conn->out, answer, req->out_len) &&
+                 buffer_append(&conn->out, "\n", 1);
+        }
+        if (!ok) conn->failed = true;
+    }
+    
+    server->stats.requests += server->batch_count;
+    server->stats.batches++;
+    
+    /* Requests pointed into the inputs; only now can they be dropped */
+    for (size_t c = 0; c < server->conn_count; c++) {
+        connection_t* conn = &server->conns[c];
+        buffer_consume(&conn->in, conn->in_pos);
+        conn->in_pos = 0;
+    }
+}
+
+/* === CONNECTIONS === */
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) ? -1 : 0;
+}
+
+static void accept_connections(kmap_server_t* server) {
+    while (server->conn_count < server->opts.max_connections) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (set_nonblocking(fd) != 0) {
+            close(fd);
+            continue;
+        }
+        
+        connection_t* conn = &server->conns[server->conn_count++];
+        memset(conn, 0, sizeof(connection_t));
+        conn->fd = fd;
+        server->stats.connections++;
+    }
+}
+
+static void read_connection(connection_t* conn) {
+    if (!buffer_reserve(&conn->in, READ_SIZE)) {
+        conn->failed = true;
+        return;
+    }
+    
+    ssize_t got = recv(conn->fd, conn->in.data + conn->in.len, conn->in.capacity - conn->in.len, 0);
+    if (got > 0) {
+        conn->in.len += (size_t)got;
+    } else if (got == 0) {
+        conn->read_closed = true;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        conn->failed = true;
+    }
+}
+
+static void write_connection(connection_t* conn) {
+    while (conn->out_pos < conn->out.len) {
+        ssize_t sent = send(conn->fd, conn->out.data + conn->out_pos,
+                            conn->out.len - conn->out_pos, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) conn->failed = true;
+            return;
+        }
+        conn->out_pos += (size_t)sent;
+    }
+    
+    conn->out.len = 0;
+    conn->out_pos = 0;
+}
+
+static void close_connection(kmap_server_t* server, size_t c) {
+    connection_t* conn = &server->conns[c];
+    close(conn->fd);
+    free(conn->in.data);
+    free(conn->out.data);
+    
+    server->conns[c] = server->conns[--server->conn_count];
+}
+
+/**
+ * @brief Close failed connections and those whose peer is done and answered
+ */
+static void reap_connections(kmap_server_t* server) {
+    for (size_t c = server->conn_count; c-- > 0;) {
+        connection_t* conn = &server->conns[c];
+        bool drained = conn->in.len == 0 && conn->out.len == 0;
+        
+        /* A partial frame at end of input can never complete */
+        if (conn->read_closed && conn->out.len == 0 && conn->in.len > 0 &&
+            (unsigned char)conn->in.data[0] == FRAME_MARKER) {
+            drained = true;
+        }
+        if (conn->failed || (conn->read_closed && drained)) close_connection(server, c);
+    }
+}
+
+/* === PUBLIC API === */
+
+void kmap_serve_default_options(kmap_serve_options_t* opts) {
+    if (!opts) return;
+    
+    memset(opts, 0, sizeof(kmap_serve_options_t));
+    opts->form = KMAP_FORM_SOP;
+    opts->max_connections = DEFAULT_MAX_CONNECTIONS;
+    opts->max_batch = DEFAULT_MAX_BATCH;
+}
+
+kmap_server_t* kmap_server_create(const char* socket_path, kmap_pool_t* pool,
+                                  const kmap_serve_options_t* opts) {
+    struct sockaddr_un addr;
+    struct stat st;
+    
+    if (!socket_path || strlen(socket_path) >= sizeof(addr.sun_path)) return NULL;
+    
+    kmap_server_t* server = calloc(1, sizeof(kmap_server_t));
+    if (!server) return NULL;
+    server->listen_fd = -1;
+    server->wake[0] = server->wake[1] = -1;
+    server->pool = pool;
+    
+    if (opts) server->opts = *opts;
+    else kmap_serve_default_options(&server->opts);
+    if (!server->opts.max_connections) server->opts.max_connections = DEFAULT_MAX_CONNECTIONS;
+    if (!server->opts.max_batch) server->opts.max_batch = DEFAULT_MAX_BATCH;
+    if (!kmap_form_valid(server->opts.form)) {
+        free(server);
+        return NULL;
+    }
+    
+    size_t max_chunks = (server->opts.max_batch + CHUNK_REQUESTS - 1) / CHUNK_REQUESTS;
+    server->conns = calloc(server->opts.max_connections, sizeof(connection_t));
+    server->fds = calloc(server->opts.max_connections + 2, sizeof(struct pollfd));
+    server->batch = calloc(server->opts.max_batch, sizeof(request_t));
+    server->chunks = calloc(max_chunks, sizeof(kmap_buffer_t));
+    if (!server->conns || !server->fds || !server->batch || !server->chunks) goto fail;
+    
+    /* Replace a stale socket left by a previous daemon, never any other file */
+    if (lstat(socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode) || unlink(socket_path) != 0) goto fail;
+    }
+    
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, socket_path, strlen(socket_path) + 1);
+    
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listen_fd < 0 || set_nonblocking(server->listen_fd) != 0) goto fail;
+    if (bind(server->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) goto fail;
+    memcpy(server->path, socket_path, strlen(socket_path) + 1);
+    if (listen(server->listen_fd, SOMAXCONN) != 0) goto fail;
+    
+    if (pipe(server->wake) != 0 || set_nonblocking(server->wake[0]) != 0 ||
+        set_nonblocking(server->wake[1]) != 0) {
+        goto fail;
+    }
+    
+    return server;
+
+fail:
+    kmap_server_destroy(server);
+    return NULL;
+}
+
+int kmap_server_run(kmap_server_t* server) {
+    if (!server) return -1;
+    bool backlog = false;
+    
+    for (;;) {
+        /* Slot 0 is the wake pipe, slot 1 the listener, then one per connection */
+        size_t nfds = 2;
+        server->fds[0].fd = server->wake[0];
+        server->fds[0].events = POLLIN;
+        server->fds[1].fd = server->listen_fd;
+        server->fds[1].events = (server->conn_count < server->opts.max_connections) ? POLLIN : 0;
+        
+        for (size_t c = 0; c < server->conn_count; c++) {
+            const connection_t* conn = &server->conns[c];
+            struct pollfd* pfd = &server->fds[nfds++];
+            pfd->fd = conn->fd;
+            pfd->events = 0;
+            if (!conn->read_closed && conn->out.len - conn->out_pos < OUTPUT_HIGH_WATER) {
+                pfd->events |= POLLIN;
+            }
+            if (conn->out_pos < conn->out.len) pfd->events |= POLLOUT;
+        }
+        
+        /* Requests already buffered go on without waiting for more input */
+        if (poll(server->fds, nfds, backlog ? 0 : -1) < 0) {
+            if (errno == EINTR) continue;
+            return -4;
+        }
+        
+        if (server->fds[0].revents & POLLIN) {
+            char drain[16];
+            while (read(server->wake[0], drain, sizeof(drain)) > 0) {
+            }
+            return 0;
+        }
+        
+        /* Connections accepted below have no poll slot yet */
+        size_t polled = server->conn_count;
+        for (size_t c = 0; c < polled; c++) {
+            connection_t* conn = &server->conns[c];
+            short revents = server->fds[c + 2].revents;
+            
+            if (revents & (POLLIN | POLLHUP)) read_connection(conn);
+            if (revents & POLLERR) conn->failed = true;
+        }
+        if (server->fds[1].revents & POLLIN) accept_connections(server);
+        
+        backlog = collect_batch(server);
+        if (server->batch_count > 0) answer_batch(server);
+        
+        for (size_t c = 0; c < server->conn_count; c++) {
+            if (!server->conns[c].failed) write_connection(&server->conns[c]);
+        }
+        reap_connections(server);
+    }
+}
+
+void kmap_server_stop(kmap_server_t* server) {
+    if (!server) return;
+    
+    /* Async-signal-safe: one byte on the self-pipe wakes poll() */
+    ssize_t ignored = write(server->wake[1], "", 1);
+    (void)ignored;
+}
+
+void kmap_server_stats(const kmap_server_t* server, kmap_serve_stats_t* stats) {
+    if (!server || !stats) return;
+    *stats = server->stats;
+}
+
+void kmap_server_destroy(kmap_server_t* server) {
+    if (!server) return;
+    
+    while (server->conn_count > 0 && server->conns) close_connection(server, 0);
+    if (server->listen_fd >= 0) close(server->listen_fd);
+    if (server->path[0]) unlink(server->path);
+    if (server->wake[0] >= 0) close(server->wake[0]);
+    if (server->wake[1] >= 0) close(server->wake[1]);
+    
+    size_t max_chunks = (server->opts.max_batch + CHUNK_REQUESTS - 1) / CHUNK_REQUESTS;
+    for (size_t c = 0; server->chunks && c < max_chunks; c++) free(server->chunks[c].data);
+    
+    free(server->chunks);
+    free(server->batch);
+    free(server->fds);
+    free(server->conns);
+    free(server);
+}
@@ -0,0 +1,317 @@
+/**
+ * @file kmap_simd.c
+ * @brief Vectorized kernels with runtime CPU dispatch
+ *
+ * Binary truth-table strings of 16-64 characters fit in one or two
+ * vector registers: compare against '1' and 'X/x/-', movemask, and
+ * reverse the bits so the first character lands on the highest cell.
+ * AVX2 is picked at runtime; SSE2 is the x86-64 baseline (or a 32-bit
+ * x86 build with -msse2) and a scalar loop covers everything else.
+ *
+ * Cover reduction's dominance checks are subset tests of one coverage
+ * word against a column array; those run 8 (AVX-512) or 4 (AVX2) columns
+ * per compare.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+
+/* SSE2 is only a baseline on x86-64; a 32-bit build needs -msse2 for it */
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#include <immintrin.h>
+#define KMAP_X86 1
+#endif
+
+/**
+ * @brief Character class masks for one binary string (bit i = char i)
+ */
+typedef struct {
+    uint64_t ones;                              // '1'
+    uint64_t dont_cares;                        // 'X', 'x', '-'
+    uint64_t valid;                             // Any of "01Xx-"
+} char_masks_t;
+
+typedef void (*classify_fn)(const char* input, size_t len, char_masks_t* masks);
+
+/* === SCALAR KERNEL === */
+
+static void classify_scalar(const char* input, size_t len, char_masks_t* masks) {
+    masks->ones = 0;
+    masks->dont_cares = 0;
+    masks->valid = 0;
+    
+    for (size_t i = 0; i < len; i++) {
+        uint64_t bit = 1ULL << i;
+        
+        switch (input[i]) {
+            case '1': masks->ones |= bit; /* fall through */
+            case '0': masks->valid |= bit; break;
+            case 'X':
+            case 'x':
+            case '-': masks->dont_cares |= bit; masks->valid |= bit; break;
+            default: break;
+        }
+    }
+}
+
+/* === X86 VECTOR KERNELS === */
+
+#ifdef KMAP_X86
+
+static void classify_sse2(const char* input, size_t len, char_masks_t* masks) {
+    const __m128i one = _mm_set1_epi8('1');
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i upper_x = _mm_set1_epi8('X');
+    const __m128i lower_x = _mm_set1_epi8('x');
+    const __m128i dash = _mm_set1_epi8('-');
+    
+    masks->ones = 0;
+    masks->dont_cares = 0;
+    masks->valid = 0;
+    
+    for (size_t i = 0; i < len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(input + i));
+        __m128i is_one = _mm_cmpeq_epi8(v, one);
+        __m128i is_dc = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, upper_x),
+                                                  _mm_cmpeq_epi8(v, lower_x)),
+                                     _mm_cmpeq_epi8(v, dash));
+        __m128i is_valid = _mm_or_si128(_mm_or_si128(is_one, is_dc), _mm_cmpeq_epi8(v, zero));
+        
+        masks->ones |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_one) << i;
+        masks->dont_cares |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_dc) << i;
+        masks->valid |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_valid) << i;
+    }
+}
+
+__attribute__((target("avx2")))
+static void classify_avx2(const char* input, size_t len, char_masks_t* masks) {
+    if (len < 32) {
+        classify_sse2(input, len, masks);
+        return;
+    }
+    
+    const __m256i one = _mm256_set1_epi8('1');
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i upper_x = _mm256_set1_epi8('X');
+    const __m256i lower_x = _mm256_set1_epi8('x');
+    const __m256i dash = _mm256_set1_epi8('-');
+    
+    masks->ones = 0;
+    masks->dont_cares = 0;
+    masks->valid = 0;
+    
+    for (size_t i = 0; i < len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(input + i));
+        __m256i is_one = _mm256_cmpeq_epi8(v, one);
+        __m256i is_dc = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, upper_x),
+                                                        _mm256_cmpeq_epi8(v, lower_x)),
+                                        _mm256_cmpeq_epi8(v, dash));
+        __m256i is_valid = _mm256_or_si256(_mm256_or_si256(is_one, is_dc),
+                                           _mm256_cmpeq_epi8(v, zero));
+        
+        masks->ones |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_one) << i;
+        masks->dont_cares |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_dc) << i;
+        masks->valid |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_valid) << i;
+    }
+}
+
+#endif /* KMAP_X86 */
+
+/* === DISPATCH === */
+
+static classify_fn classify_impl;
+
+/**
+ * @brief Pick the widest kernel this CPU supports (once)
+ */
+static classify_fn select_classify(void) {
+    classify_fn fn = __atomic_load_n(&classify_impl, __ATOMIC_RELAXED);
+    if (fn) return fn;
+
+#ifdef KMAP_X86
+    __builtin_cpu_init();
+    fn = __builtin_cpu_supports("avx2") ? classify_avx2 : classify_sse2;
+#else
+    fn = classify_scalar;
+#endif
+    
+    __atomic_store_n(&classify_impl, fn, __ATOMIC_RELAXED);
+    return fn;
+}
+
+/**
+ * @brief Reverse the bit order of a 64-bit word
+ */
+static inline uint64_t reverse_bits(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(x);
+}
+
+/* === BINARY STRING PARSING === */
+
+int parse_binary_n(const char* input, size_t len, truth_table_t* tt) {
+    if (!input || !tt) return -1;
+    
+    /* Only whole truth tables: 4 to 64 cells */
+    if (len < 4 || len > MAX_CELLS || (len & (len - 1)) != 0) return -1;
+    
+    char_masks_t masks;
+    if (len >= 16) {
+        select_classify()(input, len, &masks);
+    } else {
+        classify_scalar(input, len, &masks);
+    }
+    
+    uint64_t all = (len == MAX_CELLS) ? ~0ULL : (1ULL << len) - 1;
+    if (masks.valid != all) return -1;
+    
+    /* Character i is cell len-1-i */
+    uint8_t shift = (uint8_t)(MAX_CELLS - len);
+    tt->minterms = reverse_bits(masks.ones) >> shift;
+    tt->dont_cares = reverse_bits(masks.dont_cares) >> shift;
+    tt->num_vars = (uint8_t)ctz(len);
+    tt->minterm_count = popcount(tt->minterms);
+    
+    return 0;
+}
+
+int parse_binary_batch(const char* data, size_t record_len, size_t stride, size_t count,
+                       truth_table_t* tables, int* status) {
+    if ((!data || !tables) && count > 0) return -1;
+    if (stride < record_len) return -1;
+    
+    int first_error = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        int result = parse_binary_n(data + i * stride, record_len, &tables[i]);
+        
+        if (result != 0) {
+            memset(&tables[i], 0, sizeof(truth_table_t));
+            if (first_error == 0) first_error = result;
+        }
+        if (status) status[i] = result;
+    }
+    
+    return first_error;
+}
+
+/* === COLUMN SUBSET SCANS === */
+
+typedef uint32_t (*superset_fn)(const uint64_t* columns, uint32_t start, uint32_t count,
+                                uint64_t cells);
+
+static uint32_t superset_scalar(const uint64_t* columns, uint32_t start, uint32_t count,
+                                uint64_t cells) {
+    for (uint32_t j = start; j < count; j++) {
+        if (!(cells & ~columns[j])) return j;
+    }
+    return count;
+}
+
+#ifdef KMAP_X86
+
+__attribute__((target("avx2")))
+static uint32_t superset_avx2(const uint64_t* columns, uint32_t start, uint32_t count,
+                              uint64_t cells) {
+    const __m256i want = _mm256_set1_epi64x((long long)cells);
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t j = start;
+    
+    /* cells & ~column == 0 in each 64-bit lane */
+    for (; j + 4 <= count; j += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(columns + j));
+        __m256i missing = _mm256_andnot_si256(v, want);
+        int hits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(missing, zero)));
+        if (hits) return j + ctz((uint64_t)hits);
+    }
+    
+    return superset_scalar(columns, j, count, cells);
+}
+
+__attribute__((target("avx512f")))
+static uint32_t superset_avx512(const uint64_t* columns, uint32_t start, uint32_t count,
+                                uint64_t cells) {
+    const __m512i want = _mm512_set1_epi64((long long)cells);
+    uint32_t j = start;
+    
+    for (; j + 8 <= count; j += 8) {
+        __m512i v = _mm512_loadu_si512((const void*)(columns + j));
+        __mmask8 hits = _mm512_testn_epi64_mask(_mm512_andnot_si512(v, want), want);
+        if (hits) return j + ctz((uint64_t)hits);
+    }
+    
+    return superset_avx2(columns, j, count, cells);
+}
+
+#endif /* KMAP_X86 */
+
+static superset_fn superset_impl;
+
+static superset_fn select_superset(void) {
+    superset_fn fn = __atomic_load_n(&superset_impl, __ATOMIC_RELAXED);
+    if (fn) return fn;
+
+#ifdef KMAP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        fn = superset_avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        fn = superset_avx2;
+    } else {
+        fn = superset_scalar;
+    }
+#else
+    fn = superset_scalar;
+#endif
+    
+    __atomic_store_n(&superset_impl, fn, __ATOMIC_RELAXED);
+    return fn;
+}
+
+uint32_t find_superset_column(const uint64_t* columns, uint32_t start, uint32_t count,
+                              uint64_t cells) {
+    return select_superset()(columns, start, count, cells);
+}
+
+/* === FORCED DISPATCH === */
+
+int kmap_simd_force(kmap_simd_level_t level) {
+    classify_fn classify = NULL;
+    superset_fn superset = NULL;
+    
+    switch (level) {
+        case KMAP_SIMD_AUTO:
+            break;
+        case KMAP_SIMD_SCALAR:
+            classify = classify_scalar;
+            superset = superset_scalar;
+            break;
+#ifdef KMAP_X86
+        case KMAP_SIMD_SSE2:
+            classify = classify_sse2;
+            superset = superset_scalar;
+            break;
+        case KMAP_SIMD_AVX2:
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("avx2")) return -1;
+            classify = classify_avx2;
+            superset = superset_avx2;
+            break;
+        case KMAP_SIMD_AVX512:
+            /* No 512-bit classifier: strings are at most 64 characters */
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx2")) return -1;
+            classify = classify_avx2;
+            superset = superset_avx512;
+            break;
+#endif
+        default:
+            return -1;
+    }
+    
+    __atomic_store_n(&classify_impl, classify, __ATOMIC_RELAXED);
+    __atomic_store_n(&superset_impl, superset, __ATOMIC_RELAXED);
+    return 0;
+}
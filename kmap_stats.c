@@ -0,0 +1,111 @@
+/**
+ * @file kmap_stats.c
+ * @brief Optional per-stage counters and timers (build with -DKMAP_STATS)
+ *
+ * Each thread bumps its own block with plain relaxed stores, so the hot
+ * path takes no lock and issues no read-modify-write. Blocks are linked
+ * into a global list on first use and outlive their thread: counts from
+ * finished pool workers still show up in kmap_get_stats().
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kmap_internal.h"
+#include <string.h>
+
+#ifdef KMAP_STATS
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct stats_block {
+    kmap_stats_t stats;
+    struct stats_block* next;
+} stats_block_t;
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static stats_block_t* registry;
+
+__thread kmap_stats_t* kmap_stats_self;
+
+/* Counters of threads whose block could not be allocated */
+static kmap_stats_t overflow_stats;
+
+kmap_stats_t* kmap_stats_register(void) {
+    stats_block_t* block = calloc(1, sizeof(stats_block_t));
+    if (!block) return &overflow_stats;
+    
+    pthread_mutex_lock(&registry_lock);
+    block->next = registry;
+    registry = block;
+    pthread_mutex_unlock(&registry_lock);
+    
+    kmap_stats_self = &block->stats;
+    return kmap_stats_self;
+}
+
+uint64_t kmap_stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void kmap_stage_add(int stage, uint64_t start_ns) {
+    kmap_stats_t* stats = kmap_stats_local();
+    kmap_stat_add(&stats->stage_calls[stage], 1);
+    kmap_stat_add(&stats->stage_ns[stage], kmap_stats_now() - start_ns);
+}
+
+/**
+ * @brief Add every counter of one block into a total
+ */
+static void accumulate(kmap_stats_t* total, kmap_stats_t* block) {
+    uint64_t* sum = (uint64_t*)total;
+    uint64_t* counters = (uint64_t*)block;
+    
+    for (size_t i = 0; i < sizeof(kmap_stats_t) / sizeof(uint64_t); i++) {
+        sum[i] += __atomic_load_n(&counters[i], __ATOMIC_RELAXED);
+    }
+}
+
+static void clear(kmap_stats_t* block) {
+    uint64_t* counters = (uint64_t*)block;
+    
+    for (size_t i = 0; i < sizeof(kmap_stats_t) / sizeof(uint64_t); i++) {
+        __atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+int kmap_get_stats(kmap_stats_t* stats) {
+    if (!stats) return -1;
+    memset(stats, 0, sizeof(kmap_stats_t));
+    
+    pthread_mutex_lock(&registry_lock);
+    for (stats_block_t* block = registry; block; block = block->next) {
+        accumulate(stats, &block->stats);
+    }
+    accumulate(stats, &overflow_stats);
+    pthread_mutex_unlock(&registry_lock);
+    
+    return 0;
+}
+
+void kmap_reset_stats(void) {
+    pthread_mutex_lock(&registry_lock);
+    for (stats_block_t* block = registry; block; block = block->next) clear(&block->stats);
+    clear(&overflow_stats);
+    pthread_mutex_unlock(&registry_lock);
+}
+
+#else
+
+int kmap_get_stats(kmap_stats_t* stats) {
+    if (stats) memset(stats, 0, sizeof(kmap_stats_t));
+    return -1;
+}
+
+void kmap_reset_stats(void) {
+}
+
+#endif /* KMAP_STATS */
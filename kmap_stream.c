@@ -0,0 +1,411 @@
+/**
+ * @file kmap_stream.c
+ * @brief Memory-mapped streaming solver for truth-table files
+ *
+ * The input is mapped read-only and consumed in batches:
+ *   parse  - the calling thread splits the next batch into record views
+ *            pointing into the mapping (nothing is copied)
+ *   solve  - the pool solves the batch, each chunk appending its output
+ *            lines to its own reusable buffer
+ *   emit   - a writer thread drains finished batches to the output fd
+ * Two batch slots let the writer flush one batch while the next one is
+ * parsed and solved. Mapped pages are dropped once their batch is solved,
+ * so memory stays flat however large the file is.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "kmap_internal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DEFAULT_BATCH_RECORDS 16384
+#define CHUNK_RECORDS 256                       // Records per pool task (one output buffer)
+#define BINARY_RECORD_BYTES 16                  // uint64 minterms, uint64 dont_cares
+
+/**
+ * @brief One input record, pointing into the mapping
+ */
+typedef struct {
+    const char* data;
+    size_t len;
+} record_view_t;
+
+/**
+ * @brief Output of one chunk
+ */
+typedef struct {
+    kmap_buffer_t buf;
+    uint64_t failed;
+    int error;                                  // -4 if the buffer could not grow
+} chunk_out_t;
+
+/**
+ * @brief solve_into_fn context for one record
+ */
+typedef struct {
+    const kmap_stream_options_t* opts;
+    const record_view_t* record;
+} record_job_t;
+
+/**
+ * @brief One batch in flight
+ */
+typedef struct {
+    record_view_t* records;
+    size_t count;
+    chunk_out_t* chunks;
+    size_t chunk_count;
+    bool full;                                  // Solved, waiting for the writer
+} batch_slot_t;
+
+typedef struct {
+    kmap_stream_options_t opts;
+    batch_slot_t slots[2];
+    size_t batch_records;
+    
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    bool done;                                  // No more batches will be produced
+    int out_fd;
+    int write_error;
+    uint64_t bytes_written;
+    
+    batch_slot_t* current;                      // Batch being solved
+} stream_t;
+
+/* === OUTPUT BUFFERS === */
+
+static void chunk_append(chunk_out_t* out, const char* chars, size_t len) {
+    if (!buffer_append(&out->buf, chars, len)) out->error = -4;
+}
+
+/* === SOLVE STAGE === */
+
+/**
+ * @brief solve_into_fn for one record
+ */
+static int solve_record(const void* ctx, char* dst, size_t room) {
+    const record_job_t* job = (const record_job_t*)ctx;
+    const kmap_stream_options_t* opts = job->opts;
+    
+    if (opts->format != KMAP_STREAM_RECORDS) {
+        return solve_forms_n(job->record->data, job->record->len, opts->form, '\t', dst, room);
+    }
+    
+    truth_table_t tt;
+    solution_t sop, pos;
+    uint64_t words[2];
+    memcpy(words, job->record->data, sizeof(words));
+    
+    bool want_sop = (opts->form & (KMAP_FORM_SOP | KMAP_FORM_CHEAPEST)) != 0;
+    bool want_pos = (opts->form & (KMAP_FORM_POS | KMAP_FORM_CHEAPEST)) != 0;
+    int result = init_truth_table(words[0], words[1], opts->num_vars, &tt);
+    if (result == 0) {
+        result = solve_kmap_dual(&tt, want_sop ? &sop : NULL, want_pos ? &pos : NULL, NULL);
+    }
+    if (result != 0) return result;
+    return emit_forms(&sop, &pos, &tt, opts->form, '\t', dst, room);
+}
+
+static void solve_chunk_range(void* ctx, size_t begin, size_t end) {
+    stream_t* stream = (stream_t*)ctx;
+    batch_slot_t* slot = stream->current;
+    
+    for (size_t c = begin; c < end; c++) {
+        chunk_out_t* out = &slot->chunks[c];
+        size_t first = c * CHUNK_RECORDS;
+        size_t last = first + CHUNK_RECORDS < slot->count ? first + CHUNK_RECORDS : slot->count;
+        
+        out->buf.len = 0;
+        out->failed = 0;
+        out->error = 0;
+        
+        for (size_t i = first; i < last && !out->error; i++) {
+            record_job_t job = {&stream->opts, &slot->records[i]};
+            int result = solve_into_buffer(&out->buf, solve_record, &job);
+            
+            if (result != 0) {
+                char message[32];
+                int len = snprintf(message, sizeof(message), "error %d", result);
+                chunk_append(out, message, (size_t)len);
+                out->failed++;
+            }
+            chunk_append(out, "\n", 1);
+            
+            /* Grids span several lines: a blank line ends each record */
+            if (stream->opts.form & KMAP_FORM_MAP) chunk_append(out, "\n", 1);
+        }
+    }
+}
+
+/* === EMIT STAGE === */
+
+static int write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -4;
+        }
+        data += written;
+        len -= (size_t)written;
+    }
+    return 0;
+}
+
+static void* writer_main(void* arg) {
+    stream_t* stream = (stream_t*)arg;
+    size_t next = 0;
+    
+    for (;;) {
+        batch_slot_t* slot = &stream->slots[next];
+        
+        pthread_mutex_lock(&stream->lock);
+        while (!slot->full && !stream->done) pthread_cond_wait(&stream->changed, &stream->lock);
+        bool have = slot->full;
+        pthread_mutex_unlock(&stream->lock);
+        
+        if (!have) break;
+        
+        uint64_t bytes = 0;
+        int error = 0;
+        for (size_t c = 0; c < slot->chunk_count && !error; c++) {
+            const kmap_buffer_t* buf = &slot->chunks[c].buf;
+            error = write_all(stream->out_fd, buf->data, buf->len);
+            bytes += buf->len;
+        }
+        
+        pthread_mutex_lock(&stream->lock);
+        stream->bytes_written += bytes;
+        if (error && !stream->write_error) stream->write_error = error;
+        slot->full = false;
+        pthread_cond_broadcast(&stream->changed);
+        pthread_mutex_unlock(&stream->lock);
+        
+        next ^= 1;
+    }
+    
+    return NULL;
+}
+
+/* === PARSE STAGE === */
+
+/**
+ * @brief Split the next batch into record views
+ * @return Bytes of input consumed
+ */
+static size_t scan_batch(const stream_t* stream, const char* data, size_t len,
+                         batch_slot_t* slot) {
+    size_t pos = 0;
+    slot->count = 0;
+    
+    if (stream->opts.format == KMAP_STREAM_RECORDS) {
+        while (slot->count < stream->batch_records && len - pos >= BINARY_RECORD_BYTES) {
+            slot->records[slot->count].data = data + pos;
+            slot->records[slot->count].len = BINARY_RECORD_BYTES;
+            slot->count++;
+            pos += BINARY_RECORD_BYTES;
+        }
+        return pos;
+    }
+    
+    while (slot->count < stream->batch_records && pos < len) {
+        const char* line = data + pos;
+        const char* newline = memchr(line, '\n', len - pos);
+        size_t line_len = newline ? (size_t)(newline - line) : len - pos;
+        
+        pos += line_len + (newline ? 1 : 0);
+        if (line_len > 0 && line[line_len - 1] == '\r') line_len--;
+        
+        slot->records[slot->count].data = line;
+        slot->records[slot->count].len = line_len;
+        slot->count++;
+    }
+    return pos;
+}
+
+/**
+ * @brief Let the kernel drop mapped pages that are fully consumed
+ */
+static void release_pages(const char* base, size_t* released, size_t consumed, bool mapped) {
+    if (!mapped) return;
+    
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = consumed / page * page;
+    if (end > *released) {
+        madvise((void*)(base + *released), end - *released, MADV_DONTNEED);
+        *released = end;
+    }
+}
+
+/* === DRIVER === */
+
+static void free_stream(stream_t* stream) {
+    for (int s = 0; s < 2; s++) {
+        batch_slot_t* slot = &stream->slots[s];
+        if (slot->chunks) {
+            size_t max_chunks = (stream->batch_records + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+            for (size_t c = 0; c < max_chunks; c++) free(slot->chunks[c].buf.data);
+        }
+        free(slot->chunks);
+        free(slot->records);
+    }
+}
+
+static int run_stream(const char* data, size_t len, bool mapped, int out_fd, kmap_pool_t* pool,
+                      const kmap_stream_options_t* opts, kmap_stream_stats_t* stats) {
+    stream_t stream;
+    memset(&stream, 0, sizeof(stream));
+    
+    if (opts) {
+        stream.opts = *opts;
+    } else {
+        kmap_stream_default_options(&stream.opts);
+    }
+    
+    const kmap_stream_options_t* o = &stream.opts;
+    if (o->format != KMAP_STREAM_LINES && o->format != KMAP_STREAM_RECORDS) return -1;
+    if (!kmap_form_valid(o->form)) return -1;
+    
+    if (o->format == KMAP_STREAM_RECORDS) {
+        if (o->num_vars < 2 || o->num_vars > MAX_VARIABLES) return -1;
+        if (len % BINARY_RECORD_BYTES != 0) return -1;
+    }
+    
+    stream.batch_records = o->batch_records ? o->batch_records : DEFAULT_BATCH_RECORDS;
+    stream.out_fd = out_fd;
+    
+    size_t max_chunks = (stream.batch_records + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+    for (int s = 0; s < 2; s++) {
+        stream.slots[s].records = malloc(stream.batch_records * sizeof(record_view_t));
+        stream.slots[s].chunks = calloc(max_chunks, sizeof(chunk_out_t));
+        if (!stream.slots[s].records || !stream.slots[s].chunks) {
+            free_stream(&stream);
+            return -4;
+        }
+    }
+    
+    pthread_mutex_init(&stream.lock, NULL);
+    pthread_cond_init(&stream.changed, NULL);
+    
+    pthread_t writer;
+    if (pthread_create(&writer, NULL, writer_main, &stream) != 0) {
+        pthread_cond_destroy(&stream.changed);
+        pthread_mutex_destroy(&stream.lock);
+        free_stream(&stream);
+        return -4;
+    }
+    
+    int result = 0;
+    uint64_t records = 0, failed = 0;
+    size_t consumed = 0, released = 0;
+    
+    for (size_t next = 0; consumed < len && result == 0; next ^= 1) {
+        batch_slot_t* slot = &stream.slots[next];
+        
+        /* Wait for the writer to hand this slot back */
+        pthread_mutex_lock(&stream.lock);
+        while (slot->full) pthread_cond_wait(&stream.changed, &stream.lock);
+        result = stream.write_error;
+        pthread_mutex_unlock(&stream.lock);
+        if (result != 0) break;
+        
+        consumed += scan_batch(&stream, data + consumed, len - consumed, slot);
+        slot->chunk_count = (slot->count + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+        
+        stream.current = slot;
+        if (pool) {
+            result = kmap_pool_run(pool, slot->chunk_count, 1, solve_chunk_range, &stream);
+        } else {
+            solve_chunk_range(&stream, 0, slot->chunk_count);
+        }
+        
+        for (size_t c = 0; c < slot->chunk_count; c++) {
+            if (slot->chunks[c].error && result == 0) result = slot->chunks[c].error;
+            failed += slot->chunks[c].failed;
+        }
+        records += slot->count;
+        
+        release_pages(data, &released, consumed, mapped);
+        
+        pthread_mutex_lock(&stream.lock);
+        slot->full = (result == 0);
+        pthread_cond_broadcast(&stream.changed);
+        pthread_mutex_unlock(&stream.lock);
+    }
+    
+    pthread_mutex_lock(&stream.lock);
+    stream.done = true;
+    pthread_cond_broadcast(&stream.changed);
+    pthread_mutex_unlock(&stream.lock);
+    pthread_join(writer, NULL);
+    
+    if (result == 0) result = stream.write_error;
+    
+    if (stats) {
+        stats->records = records;
+        stats->failed = failed;
+        stats->bytes_written = stream.bytes_written;
+    }
+    
+    pthread_cond_destroy(&stream.changed);
+    pthread_mutex_destroy(&stream.lock);
+    free_stream(&stream);
+    return result;
+}
+
+/* === PUBLIC API === */
+
+void kmap_stream_default_options(kmap_stream_options_t* opts) {
+    if (!opts) return;
+    
+    memset(opts, 0, sizeof(kmap_stream_options_t));
+    opts->format = KMAP_STREAM_LINES;
+    opts->num_vars = MAX_VARIABLES;
+    opts->form = KMAP_FORM_SOP;
+    opts->batch_records = DEFAULT_BATCH_RECORDS;
+}
+
+int kmap_stream_buffer(const char* data, size_t len, int out_fd, kmap_pool_t* pool,
+                       const kmap_stream_options_t* opts, kmap_stream_stats_t* stats) {
+    if (!data && len > 0) return -1;
+    return run_stream(data, len, false, out_fd, pool, opts, stats);
+}
+
+int kmap_stream_file(const char* path, int out_fd, kmap_pool_t* pool,
+                     const kmap_stream_options_t* opts, kmap_stream_stats_t* stats) {
+    if (!path) return -1;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    size_t len = (size_t)st.st_size;
+    if (len == 0) {
+        close(fd);
+        return run_stream(NULL, 0, false, out_fd, pool, opts, stats);
+    }
+    
+    char* data = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -4;
+    
+    madvise(data, len, MADV_SEQUENTIAL);
+    int result = run_stream(data, len, true, out_fd, pool, opts, stats);
+    
+    munmap(data, len);
+    return result;
+}
@@ -0,0 +1,1263 @@
+/**
+ * @file kmap_verify.c
+ * @brief Differential verifier: every engine against a brute-force reference
+ *
+ * Every 2-3 variable function (with don't cares) and every 4-variable
+ * function without them is enumerated; 4-6 variable functions with don't
+ * cares are sampled. Each table goes through every solving path, and
+ * each result must cover every 1 and no 0, report the literals its cubes
+ * actually have, and - when it claims to be optimal - match the reference
+ * cost (fewest terms, then fewest literals). The reference shares no code
+ * with the solver: it enumerates all 3^n cubes and branches over primes.
+ * The multi-output engine solves each table together with its neighbours
+ * and checks every output, and the shared cost, itself.
+ *
+ * The wide engines are also run on sampled 7-8 variable tables (cube
+ * unions, sparse and complemented functions) against a multi-word version
+ * of the same reference, so their essential, class-merge and greedy
+ * stages are held to the exact minimum too.
+ *
+ * Usage: kmap_verify [--threads N] [--samples N] [--wide-samples N] [--seed N]
+ *                    [--max-failures N]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kmap_internal.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BLOCK_SIZE 256
+#define DEFAULT_SAMPLES 20000
+#define DEFAULT_WIDE_SAMPLES 1000
+#define DEFAULT_MAX_FAILURES 10
+#define NPN_CACHE_ENTRIES (1 << 16)
+#define DISK_CACHE_ENTRIES (1 << 16)
+
+/* Wide passes: 7-8 variables, up to 256 cells */
+#define WIDE_MIN_VARS 7
+#define WIDE_MAX_VARS 8
+#define WIDE_MAX_WORDS 4
+#define WIDE_NODE_LIMIT 2000000                 // Reference search budget per table
+
+/* Engine kinds: how a result is judged */
+#define KIND_EXACT 0                            // Minimum whenever it claims optimal
+#define KIND_HEURISTIC 1                        // Correct; distance to the minimum reported
+#define KIND_OFFSET 2                           // Exact cover of the 0 cells (POS)
+#define KIND_SHARED 3                           // One output of a shared cover; checks its own
+
+/* Multi-output engine: each table solved with the next ones of its block */
+#define MULTI_OUTPUTS 3
+
+/**
+ * @brief A cover reduced to what the checks need
+ */
+typedef struct {
+    uint64_t cells;                             // Union of the cubes
+    uint32_t terms;                             // Number of cubes
+    uint32_t literals;                          // Literals recounted from the cubes
+    uint32_t reported;                          // Literal count the engine reported
+    bool optimal;                               // Engine claims a proven minimum
+    const char* defect;                         // Check the engine failed itself (NULL = none)
+} verify_result_t;
+
+/**
+ * @brief State of one worker block, reset per block of tables
+ */
+typedef struct {
+    const truth_table_t* tables;
+    size_t count;
+    kmap_array_result_t* array_results;         // solve_kmap_batch_arrays() on the block
+    kmap_arena_t* arena;
+    kmap_handle_t* handle;                      // Edited from each table to the next
+    kmap_wide_table_t wide;
+    kmap_options_t opts;
+    uint32_t* primes;                           // Wide reference scratch (cube codes)
+    uint8_t* implicant;                         // Wide reference scratch (per cube code)
+} verify_worker_t;
+
+/**
+ * @brief verify_result_t of a 7-8 variable table
+ */
+typedef struct {
+    uint64_t cells[WIDE_MAX_WORDS];
+    uint32_t terms;
+    uint32_t literals;
+    uint32_t reported;
+    bool optimal;
+} wide_result_t;
+
+typedef int (*engine_fn)(verify_worker_t* worker, size_t index, verify_result_t* result);
+typedef int (*wide_engine_fn)(verify_worker_t* worker, wide_result_t* result);
+
+typedef struct {
+    const char* name;
+    engine_fn fn;
+    int kind;
+    wide_engine_fn wide_fn;                     // Same path on worker->wide (NULL = narrow only)
+} verify_engine_t;
+
+/**
+ * @brief Per-engine totals, updated once per block
+ */
+typedef struct {
+    uint64_t checked;
+    uint64_t failures;
+    uint64_t unproven;                          // Exact engine gave up optimality
+    uint64_t above_minimum;                     // Heuristic result costs more than the minimum
+} engine_totals_t;
+
+/**
+ * @brief One pass over a variable count
+ */
+typedef struct {
+    uint8_t num_vars;
+    bool exhaustive;                            // Index is the function itself
+    bool dont_cares;                            // Exhaustive over 0/1/X per cell
+    size_t count;
+    uint64_t seed;
+} verify_pass_t;
+
+static size_t max_failures = DEFAULT_MAX_FAILURES;
+static uint64_t failures_reported;
+static uint64_t wide_skipped;                   // Tables past WIDE_NODE_LIMIT
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* === CELL ARITHMETIC === */
+
+static const uint64_t var_masks[MAX_VARIABLES] = {
+    VAR_MASK_0, VAR_MASK_1, VAR_MASK_2, VAR_MASK_3, VAR_MASK_4, VAR_MASK_5
+};
+
+static inline uint64_t all_cells(uint8_t num_vars) {
+    return (num_vars >= 6) ? ~0ULL : ((1ULL << (1U << num_vars)) - 1);
+}
+
+/**
+ * @brief Cells of a cube, computed literal by literal
+ */
+static uint64_t cube_cells(uint16_t mask, uint16_t values, uint8_t num_vars) {
+    uint64_t cells = all_cells(num_vars);
+    for (uint8_t v = 0; v < num_vars; v++) {
+        if (!(mask & (1U << v))) continue;
+        cells &= (values & (1U << v)) ? var_masks[v] : ~var_masks[v];
+    }
+    return cells;
+}
+
+static inline uint32_t cost_of(uint32_t terms, uint32_t literals) {
+    return terms * TERM_COST + literals;
+}
+
+/* === REFERENCE MINIMIZER === */
+
+typedef struct {
+    uint64_t cells[MAX_CUBES];
+    uint8_t literals[MAX_CUBES];
+    uint32_t count;
+    uint32_t best;
+} reference_t;
+
+/**
+ * @brief Primes of on | dc covering some 1, by trying every cube
+ */
+static void reference_primes(uint64_t on, uint64_t dc, uint8_t num_vars, reference_t* ref) {
+    uint64_t care = on | dc;
+    uint32_t full = (1U << num_vars) - 1;
+    ref->count = 0;
+    
+    for (uint32_t mask = 0; mask <= full; mask++) {
+        /* Every values pattern that is a subset of mask */
+        uint32_t values = 0;
+        do {
+            uint64_t cells = cube_cells((uint16_t)mask, (uint16_t)values, num_vars);
+            bool prime = (cells & ~care) == 0 && (cells & on) != 0;
+            
+            /* Prime: dropping any literal leaves the on | dc set */
+            for (uint8_t v = 0; prime && v < num_vars; v++) {
+                if (!(mask & (1U << v))) continue;
+                uint64_t wider = cube_cells((uint16_t)(mask & ~(1U << v)),
+                                            (uint16_t)(values & ~(1U << v)), num_vars);
+                if ((wider & ~care) == 0) prime = false;
+            }
+            
+            if (prime) {
+                ref->cells[ref->count] = cells;
+                ref->literals[ref->count] = popcount(mask);
+                ref->count++;
+            }
+            values = (values - mask) & mask;
+        } while (values != 0);
+    }
+}
+
+/**
+ * @brief Branch on the uncovered 1 with the fewest primes through it
+ */
+static void reference_search(reference_t* ref, uint64_t remaining, uint32_t cost) {
+    if (!remaining) {
+        if (cost < ref->best) ref->best = cost;
+        return;
+    }
+    
+    /* Bound: the widest prime still needs ceil(remaining / widest) terms */
+    uint32_t widest = 0;
+    for (uint32_t p = 0; p < ref->count; p++) {
+        uint32_t gain = popcount(ref->cells[p] & remaining);
+        if (gain > widest) widest = gain;
+    }
+    uint32_t needed = (popcount(remaining) + widest - 1) / widest;
+    if (cost + needed * TERM_COST >= ref->best) return;
+    
+    uint64_t pick = 0;
+    uint32_t fewest = UINT32_MAX;
+    for (uint64_t cells = remaining; cells; cells &= cells - 1) {
+        uint64_t cell = cells & -cells;
+        uint32_t ways = 0;
+        for (uint32_t p = 0; p < ref->count; p++) ways += (ref->cells[p] & cell) != 0;
+        if (ways < fewest) {
+            fewest = ways;
+            pick = cell;
+        }
+    }
+    
+    for (uint32_t p = 0; p < ref->count; p++) {
+        if (!(ref->cells[p] & pick)) continue;
+        reference_search(ref, remaining & ~ref->cells[p], cost + TERM_COST + ref->literals[p]);
+    }
+}
+
+/**
+ * @brief Minimum cost of covering on with implicants of on | dc
+ */
+static uint32_t reference_cost(uint64_t on, uint64_t dc, uint8_t num_vars) {
+    reference_t ref;
+    if (!on) return 0;
+    
+    reference_primes(on, dc, num_vars, &ref);
+    ref.best = UINT32_MAX;
+    reference_search(&ref, on, 0);
+    return ref.best;
+}
+
+/* === WIDE REFERENCE (7-8 VARIABLES) === */
+
+/**
+ * @brief Cells of every cube of one variable count, by base-3 code
+ * 
+ * Digit v of a code is 0 (~v present), 1 (v present) or 2 (v absent), so
+ * dropping literal v from code c gives c + (2 - digit) * 3^v.
+ */
+typedef struct {
+    uint8_t num_vars;
+    size_t words;
+    uint32_t count;                             // 3^num_vars
+    uint32_t pow3[WIDE_MAX_VARS];
+    uint64_t (*cells)[WIDE_MAX_WORDS];
+    uint8_t* literals;
+} cube_table_t;
+
+static cube_table_t cube_tables[WIDE_MAX_VARS + 1];
+
+/**
+ * @brief Cells of a cube over 7-8 variables, word by word
+ */
+static void wide_cube_cells(uint16_t mask, uint16_t values, uint8_t num_vars, uint64_t* cells) {
+    uint64_t low = cube_cells(mask & 0x3F, values & 0x3F, MAX_VARIABLES);
+    
+    for (size_t w = 0; w < kmap_wide_words(num_vars); w++) {
+        bool inside = true;
+        for (uint8_t v = MAX_VARIABLES; v < num_vars; v++) {
+            if ((mask >> v) & 1 && ((w >> (v - MAX_VARIABLES)) & 1) != ((values >> v) & 1U)) {
+                inside = false;
+            }
+        }
+        cells[w] = inside ? low : 0;
+    }
+}
+
+static int build_cube_table(uint8_t num_vars) {
+    cube_table_t* table = &cube_tables[num_vars];
+    
+    table->num_vars = num_vars;
+    table->words = kmap_wide_words(num_vars);
+    table->count = 1;
+    for (uint8_t v = 0; v < num_vars; v++) {
+        table->pow3[v] = table->count;
+        table->count *= 3;
+    }
+    
+    table->cells = calloc(table->count, sizeof(*table->cells));
+    table->literals = malloc(table->count);
+    if (!table->cells || !table->literals) return -4;
+    
+    for (uint32_t code = 0; code < table->count; code++) {
+        uint16_t mask = 0, values = 0;
+        uint32_t rest = code;
+        for (uint8_t v = 0; v < num_vars; v++, rest /= 3) {
+            if (rest % 3 == 2) continue;
+            mask |= (uint16_t)(1U << v);
+            if (rest % 3 == 1) values |= (uint16_t)(1U << v);
+        }
+        wide_cube_cells(mask, values, num_vars, table->cells[code]);
+        table->literals[code] = popcount(mask);
+    }
+    return 0;
+}
+
+typedef struct {
+    const cube_table_t* cubes;
+    const uint32_t* primes;                     // Cube codes
+    uint32_t count;
+    uint32_t best;
+    uint64_t nodes;
+} wide_reference_t;
+
+static uint32_t words_popcount(const uint64_t* a, const uint64_t* b, size_t words) {
+    uint32_t total = 0;
+    for (size_t w = 0; w < words; w++) total += popcount(a[w] & b[w]);
+    return total;
+}
+
+static void wide_reference_search(wide_reference_t* ref, const uint64_t* remaining,
+                                  uint32_t cost) {
+    const cube_table_t* cubes = ref->cubes;
+    size_t words = cubes->words;
+    
+    if (++ref->nodes > WIDE_NODE_LIMIT) return;
+    
+    uint32_t left = 0;
+    for (size_t w = 0; w < words; w++) left += popcount(remaining[w]);
+    if (!left) {
+        if (cost < ref->best) ref->best = cost;
+        return;
+    }
+    
+    uint32_t widest = 0;
+    for (uint32_t p = 0; p < ref->count; p++) {
+        uint32_t gain = words_popcount(cubes->cells[ref->primes[p]], remaining, words);
+        if (gain > widest) widest = gain;
+    }
+    uint32_t needed = (left + widest - 1) / widest;
+    if (cost + needed * TERM_COST >= ref->best) return;
+    
+    /* Uncovered 1 with the fewest primes through it */
+    size_t pick_word = 0;
+    uint64_t pick = 0;
+    uint32_t fewest = UINT32_MAX;
+    for (size_t w = 0; w < words && fewest > 1; w++) {
+        for (uint64_t cells = remaining[w]; cells && fewest > 1; cells &= cells - 1) {
+            uint64_t cell = cells & -cells;
+            uint32_t ways = 0;
+            for (uint32_t p = 0; p < ref->count; p++) {
+                ways += (cubes->cells[ref->primes[p]][w] & cell) != 0;
+            }
+            if (ways < fewest) {
+                fewest = ways;
+                pick_word = w;
+                pick = cell;
+            }
+        }
+    }
+    
+    for (uint32_t p = 0; p < ref->count; p++) {
+        const uint64_t* cells = cubes->cells[ref->primes[p]];
+        if (!(cells[pick_word] & pick)) continue;
+        
+        uint64_t next[WIDE_MAX_WORDS];
+        for (size_t w = 0; w < words; w++) next[w] = remaining[w] & ~cells[w];
+        wide_reference_search(ref, next, cost + TERM_COST + cubes->literals[ref->primes[p]]);
+    }
+}
+
+/**
+ * @brief reference_cost() of a 7-8 variable table
+ * @return Minimum cost, or UINT32_MAX if the search ran past WIDE_NODE_LIMIT
+ */
+static uint32_t wide_reference_cost(verify_worker_t* worker, const uint64_t* on,
+                                    const uint64_t* dc) {
+    const cube_table_t* cubes = &cube_tables[worker->wide.num_vars];
+    size_t words = cubes->words;
+    uint64_t care[WIDE_MAX_WORDS];
+    bool any = false;
+    
+    for (size_t w = 0; w < words; w++) {
+        care[w] = on[w] | dc[w];
+        if (on[w]) any = true;
+    }
+    if (!any) return 0;
+    
+    /* Implicants first, so a prime test is one lookup per literal */
+    for (uint32_t code = 0; code < cubes->count; code++) {
+        bool inside = true;
+        for (size_t w = 0; w < words; w++) {
+            if (cubes->cells[code][w] & ~care[w]) inside = false;
+        }
+        worker->implicant[code] = inside;
+    }
+    
+    uint32_t count = 0;
+    for (uint32_t code = 0; code < cubes->count; code++) {
+        if (!worker->implicant[code] || !words_popcount(cubes->cells[code], on, words)) continue;
+        
+        bool prime = true;
+        uint32_t rest = code;
+        for (uint8_t v = 0; prime && v < cubes->num_vars; v++, rest /= 3) {
+            uint32_t digit = rest % 3;
+            if (digit != 2 && worker->implicant[code + (2 - digit) * cubes->pow3[v]]) {
+                prime = false;
+            }
+        }
+        if (prime) worker->primes[count++] = code;
+    }
+    
+    wide_reference_t ref = {cubes, worker->primes, count, UINT32_MAX, 0};
+    wide_reference_search(&ref, on, 0);
+    return (ref.nodes > WIDE_NODE_LIMIT) ? UINT32_MAX : ref.best;
+}
+
+/* === EXPRESSION EVALUATOR === */
+
+typedef struct {
+    const char* p;
+    uint8_t num_vars;
+    bool error;
+} expr_parser_t;
+
+static uint64_t parse_sum(expr_parser_t* parser);
+
+static void skip_spaces(expr_parser_t* parser) {
+    while (*parser->p == ' ') parser->p++;
+}
+
+static uint64_t parse_factor(expr_parser_t* parser) {
+    skip_spaces(parser);
+    char c = *parser->p;
+    
+    if (c == '~') {
+        parser->p++;
+        return ~parse_factor(parser) & all_cells(parser->num_vars);
+    }
+    if (c == '(') {
+        parser->p++;
+        uint64_t cells = parse_sum(parser);
+        skip_spaces(parser);
+        if (*parser->p != ')') parser->error = true;
+        else parser->p++;
+        return cells;
+    }
+    
+    parser->p++;
+    if (c == '0') return 0;
+    if (c == '1') return all_cells(parser->num_vars);
+    if (c >= 'A' && c < 'A' + parser->num_vars) {
+        return var_masks[c - 'A'] & all_cells(parser->num_vars);
+    }
+    
+    parser->error = true;
+    return 0;
+}
+
+static uint64_t parse_product(expr_parser_t* parser) {
+    uint64_t cells = parse_factor(parser);
+    skip_spaces(parser);
+    while (!parser->error && *parser->p == '&') {
+        parser->p++;
+        cells &= parse_factor(parser);
+        skip_spaces(parser);
+    }
+    return cells;
+}
+
+static uint64_t parse_sum(expr_parser_t* parser) {
+    uint64_t cells = parse_product(parser);
+    while (!parser->error && *parser->p == '+') {
+        parser->p++;
+        cells |= parse_product(parser);
+    }
+    return cells;
+}
+
+/**
+ * @brief Evaluate an SOP or POS expression and count its terms and literals
+ * @param expression Solver output
+ * @param num_vars Number of variables
+ * @param pos Count '&'-joined clauses instead of '+'-joined products
+ * @param result Output cells, terms and literals (reported = literals)
+ * @return 0 on success, -1 if the expression does not parse
+ */
+static int evaluate_expression(const char* expression, uint8_t num_vars, bool pos,
+                               verify_result_t* result) {
+    expr_parser_t parser = {expression, num_vars, false};
+    result->cells = parse_sum(&parser);
+    if (parser.error || *parser.p != '\0') return -1;
+    
+    /* Top-level separators delimit terms; a lone "0" (SOP) or "1" (POS) has none */
+    char empty = pos ? '1' : '0';
+    char separator = pos ? '&' : '+';
+    int depth = 0;
+    
+    result->terms = (expression[0] == empty && expression[1] == '\0') ? 0 : 1;
+    result->literals = 0;
+    for (const char* c = expression; *c; c++) {
+        if (*c == '(') depth++;
+        if (*c == ')') depth--;
+        if (*c == separator && depth == 0) result->terms++;
+        if (*c >= 'A' && *c <= 'P') result->literals++;
+    }
+    result->reported = result->literals;
+    return 0;
+}
+
+/* === ENGINES === */
+
+static void from_solution(const solution_t* solution, uint8_t num_vars, verify_result_t* result) {
+    memset(result, 0, sizeof(verify_result_t));
+    for (uint8_t i = 0; i < solution->implicant_count; i++) {
+        const implicant_t* imp = &solution->implicants[i];
+        result->cells |= cube_cells(imp->literal_mask, imp->literal_values, num_vars);
+        result->literals += popcount(imp->literal_mask);
+    }
+    result->terms = solution->implicant_count;
+    result->reported = solution->literal_count;
+    result->optimal = solution->optimal;
+}
+
+static void from_cover(const kmap_cover_t* cover, uint8_t num_vars, verify_result_t* result) {
+    memset(result, 0, sizeof(verify_result_t));
+    for (uint32_t i = 0; i < cover->count; i++) {
+        result->cells |= cube_cells(cover->cubes[i].mask, cover->cubes[i].values, num_vars);
+        result->literals += popcount(cover->cubes[i].mask);
+    }
+    result->terms = cover->count;
+    result->reported = cover->literal_count;
+    result->optimal = cover->optimal;
+}
+
+static int solve_with_flags(verify_worker_t* worker, size_t index, uint32_t flags,
+                            verify_result_t* result) {
+    kmap_options_t opts = worker->opts;
+    solution_t solution;
+    opts.flags = flags;
+    
+    int status = find_prime_implicants_ex(&worker->tables[index], &solution, &opts);
+    if (status == 0) from_solution(&solution, worker->tables[index].num_vars, result);
+    return status;
+}
+
+static int engine_exact(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    return solve_with_flags(worker, index, 0, result);
+}
+
+/* Cached engines solve twice so both the miss and the hit are checked */
+static int engine_memo4(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    int status = solve_with_flags(worker, index, KMAP_OPT_MEMO4, result);
+    return status ? status : solve_with_flags(worker, index, KMAP_OPT_MEMO4, result);
+}
+
+static int engine_npn(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    int status = solve_with_flags(worker, index, KMAP_OPT_NPN_CACHE, result);
+    return status ? status : solve_with_flags(worker, index, KMAP_OPT_NPN_CACHE, result);
+}
+
+static int engine_disk(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    int status = solve_with_flags(worker, index, KMAP_OPT_DISK_CACHE, result);
+    return status ? status : solve_with_flags(worker, index, KMAP_OPT_DISK_CACHE, result);
+}
+
+static int engine_espresso(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    return solve_with_flags(worker, index, KMAP_OPT_ESPRESSO, result);
+}
+
+static int engine_dual_pos(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    solution_t pos;
+    int status = solve_kmap_dual(&worker->tables[index], NULL, &pos, &worker->opts);
+    if (status == 0) from_solution(&pos, worker->tables[index].num_vars, result);
+    return status;
+}
+
+static void load_wide(verify_worker_t* worker, size_t index) {
+    worker->wide.minterms[0] = worker->tables[index].minterms;
+    worker->wide.dont_cares[0] = worker->tables[index].dont_cares;
+}
+
+static void from_wide_cover(const kmap_cover_t* cover, uint8_t num_vars, wide_result_t* result) {
+    memset(result, 0, sizeof(wide_result_t));
+    for (uint32_t i = 0; i < cover->count; i++) {
+        uint64_t cells[WIDE_MAX_WORDS];
+        wide_cube_cells(cover->cubes[i].mask, cover->cubes[i].values, num_vars, cells);
+        for (size_t w = 0; w < kmap_wide_words(num_vars); w++) result->cells[w] |= cells[w];
+        result->literals += popcount(cover->cubes[i].mask);
+    }
+    result->terms = cover->count;
+    result->reported = cover->literal_count;
+    result->optimal = cover->optimal;
+}
+
+static int run_wide_primes(verify_worker_t* worker, kmap_cover_t* cover) {
+    kmap_cube_t* primes;
+    uint32_t prime_count;
+    
+    kmap_arena_reset(worker->arena);
+    memset(cover, 0, sizeof(kmap_cover_t));
+    
+    int status = generate_wide_primes(&worker->wide, worker->arena, &primes, &prime_count);
+    if (status != 0) return status;
+    return cover_wide_primes(&worker->wide, primes, prime_count, &worker->opts,
+                             worker->arena, cover);
+}
+
+static int run_wide_api(verify_worker_t* worker, kmap_cover_t* cover) {
+    kmap_arena_reset(worker->arena);
+    return solve_kmap_wide_arena(&worker->wide, cover, &worker->opts, worker->arena);
+}
+
+/* The 7-16 variable engine run on a narrow table, skipping the 64-bit hand-off */
+static int engine_wide(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    kmap_cover_t cover;
+    
+    load_wide(worker, index);
+    int status = run_wide_primes(worker, &cover);
+    if (status == 0) from_cover(&cover, worker->wide.num_vars, result);
+    return status;
+}
+
+static int engine_wide_api(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    kmap_cover_t cover;
+    
+    load_wide(worker, index);
+    int status = run_wide_api(worker, &cover);
+    if (status == 0) from_cover(&cover, worker->wide.num_vars, result);
+    return status;
+}
+
+static int wide_engine_primes(verify_worker_t* worker, wide_result_t* result) {
+    kmap_cover_t cover;
+    int status = run_wide_primes(worker, &cover);
+    if (status == 0) from_wide_cover(&cover, worker->wide.num_vars, result);
+    return status;
+}
+
+static int wide_engine_api(verify_worker_t* worker, wide_result_t* result) {
+    kmap_cover_t cover;
+    int status = run_wide_api(worker, &cover);
+    if (status == 0) from_wide_cover(&cover, worker->wide.num_vars, result);
+    return status;
+}
+
+/* A fresh handle per wide table: its first solve, not the edit path */
+static int wide_engine_handle(verify_worker_t* worker, wide_result_t* result) {
+    kmap_handle_t* handle = kmap_handle_create(&worker->wide, &worker->opts);
+    if (!handle) return -4;
+    
+    const kmap_cover_t* cover;
+    int status = kmap_handle_get_solution(handle, &cover);
+    if (status == 0) from_wide_cover(cover, worker->wide.num_vars, result);
+    kmap_handle_destroy(handle);
+    return status;
+}
+
+/* One handle per block, edited cell by cell from the previous table */
+static int engine_incremental(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    const truth_table_t* tt = &worker->tables[index];
+    
+    if (!worker->handle) {
+        load_wide(worker, index);
+        worker->handle = kmap_handle_create(&worker->wide, &worker->opts);
+        if (!worker->handle) return -4;
+    } else {
+        const kmap_wide_table_t* current = kmap_handle_table(worker->handle);
+        uint64_t changed = (current->minterms[0] ^ tt->minterms) |
+                           (current->dont_cares[0] ^ tt->dont_cares);
+        
+        for (; changed; changed &= changed - 1) {
+            uint32_t cell = ctz(changed);
+            uint64_t bit = 1ULL << cell;
+            int value = (tt->dont_cares & bit) ? KMAP_CELL_DONT_CARE :
+                        (tt->minterms & bit) ? KMAP_CELL_ONE : KMAP_CELL_ZERO;
+            int status = kmap_handle_update_cell(worker->handle, cell, value);
+            if (status != 0) return status;
+        }
+    }
+    
+    const kmap_cover_t* cover;
+    int status = kmap_handle_get_solution(worker->handle, &cover);
+    if (status == 0) from_cover(cover, tt->num_vars, result);
+    return status;
+}
+
+static int engine_arrays(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    const kmap_array_result_t* item = &worker->array_results[index];
+    uint8_t num_vars = worker->tables[index].num_vars;
+    
+    if (item->status != 0) return item->status;
+    
+    memset(result, 0, sizeof(verify_result_t));
+    for (uint8_t i = 0; i < item->term_count; i++) {
+        uint16_t mask = item->cubes[i] & 0xFF;
+        result->cells |= cube_cells(mask, item->cubes[i] >> 8, num_vars);
+        result->literals += popcount(mask);
+    }
+    result->terms = item->term_count;
+    result->reported = item->literal_count;
+    result->optimal = item->optimal;
+    return 0;
+}
+
+/**
+ * @brief Render a table as a binary string, highest cell first
+ */
+static void render_table(const truth_table_t* tt, char* input) {
+    size_t cells = (size_t)1 << tt->num_vars;
+    for (size_t c = 0; c < cells; c++) {
+        uint64_t bit = 1ULL << (cells - 1 - c);
+        input[c] = (tt->dont_cares & bit) ? 'X' : (tt->minterms & bit) ? '1' : '0';
+    }
+    input[cells] = '\0';
+}
+
+/* The string entry point: parse, solve and emit, then read the expression back */
+static int solve_string(verify_worker_t* worker, size_t index, int form,
+                        verify_result_t* result) {
+    char input[MAX_CELLS + 1];
+    char output[MAX_EXPRESSION_LEN];
+    
+    render_table(&worker->tables[index], input);
+    int status = solve_kmap_form(input, form, output, sizeof(output));
+    if (status != 0) return status;
+    
+    if (evaluate_expression(output, worker->tables[index].num_vars,
+                            form == KMAP_FORM_POS, result) != 0) {
+        return -3;
+    }
+    
+    /* Unlimited process defaults (see main): the exact path always completes */
+    result->optimal = true;
+    return 0;
+}
+
+static int engine_string_sop(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    return solve_string(worker, index, KMAP_FORM_SOP, result);
+}
+
+static int engine_string_pos(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    int status = solve_string(worker, index, KMAP_FORM_POS, result);
+    
+    /* Checked as the off-set cover the clauses complement */
+    result->cells = ~result->cells & all_cells(worker->tables[index].num_vars);
+    return status;
+}
+
+/**
+ * @brief Recount one output of a shared cover
+ * @return NULL if it covers exactly its function, otherwise the reason
+ */
+static const char* check_output(const verify_result_t* output, const truth_table_t* tt) {
+    if ((output->cells & tt->minterms) != tt->minterms) return "an output misses a 1 cell";
+    if (output->cells & ~(tt->minterms | tt->dont_cares)) return "an output covers a 0 cell";
+    if (output->reported != output->literals) return "an output's literal count is wrong";
+    return NULL;
+}
+
+/**
+ * @brief Table index and the next MULTI_OUTPUTS - 1 of its block, solved as one
+ *
+ * Every output must cover its own function, and the pool, each term
+ * counted once, must cost no more than the outputs solved apart. Output 0
+ * is left in result for judge().
+ */
+static int engine_multi(verify_worker_t* worker, size_t index, verify_result_t* result) {
+    truth_table_t outputs[MULTI_OUTPUTS];
+    multi_solution_t shared;
+    const char* defect = NULL;
+    uint32_t separate = 0;
+    
+    for (size_t k = 0; k < MULTI_OUTPUTS; k++) {
+        outputs[k] = worker->tables[(index + k) % worker->count];
+    }
+    int status = solve_kmap_multi(outputs, MULTI_OUTPUTS, &shared, &worker->opts);
+    if (status != 0) return status;
+    
+    /* Down to output 0, which is left in result */
+    for (size_t k = MULTI_OUTPUTS; k-- > 0;) {
+        solution_t single, alone;
+        status = multi_solution_output(&shared, (uint8_t)k, &single);
+        if (status == 0) status = find_prime_implicants_ex(&outputs[k], &alone, &worker->opts);
+        if (status != 0) return status;
+        
+        from_solution(&single, outputs[k].num_vars, result);
+        if (!defect && k > 0) defect = check_output(result, &outputs[k]);
+        separate += cost_of(alone.implicant_count, alone.literal_count);
+    }
+    
+    if (!defect && cost_of(shared.term_count, shared.literal_count) > separate) {
+        defect = "shared cover costs more than separate ones";
+    }
+    result->defect = defect;
+    return 0;
+}
+
+static const verify_engine_t engines[] = {
+    {"exact",       engine_exact,       KIND_EXACT,     NULL},
+    {"memo4",       engine_memo4,       KIND_EXACT,     NULL},
+    {"npn-cache",   engine_npn,         KIND_EXACT,     NULL},
+    {"disk-cache",  engine_disk,        KIND_EXACT,     NULL},
+    {"espresso",    engine_espresso,    KIND_HEURISTIC, NULL},
+    {"dual-pos",    engine_dual_pos,    KIND_OFFSET,    NULL},
+    {"wide-primes", engine_wide,        KIND_EXACT,     wide_engine_primes},
+    {"wide-api",    engine_wide_api,    KIND_EXACT,     wide_engine_api},
+    {"incremental", engine_incremental, KIND_EXACT,     wide_engine_handle},
+    {"arrays",      engine_arrays,      KIND_EXACT,     NULL},
+    {"string-sop",  engine_string_sop,  KIND_EXACT,     NULL},
+    {"string-pos",  engine_string_pos,  KIND_OFFSET,    NULL},
+    {"multi",       engine_multi,       KIND_SHARED,    NULL},
+};
+
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+static engine_totals_t totals[ENGINE_COUNT];
+
+/* === CHECKING === */
+
+static void report_failure(const verify_engine_t* engine, const truth_table_t* tt,
+                           const char* reason) {
+    pthread_mutex_lock(&report_lock);
+    if (failures_reported++ < max_failures) {
+        fprintf(stderr, "FAIL %-11s n=%u minterms=0x%016llx dont_cares=0x%016llx: %s\n",
+                engine->name, tt->num_vars, (unsigned long long)tt->minterms,
+                (unsigned long long)tt->dont_cares, reason);
+    }
+    pthread_mutex_unlock(&report_lock);
+}
+
+/**
+ * @brief Judge one result against the reference minimum of its rail
+ * @return NULL if the result passes, otherwise the reason
+ */
+static const char* judge(const verify_engine_t* engine, const verify_result_t* result,
+                         uint64_t on, uint64_t dc, uint32_t minimum, engine_totals_t* local) {
+    uint32_t cost = cost_of(result->terms, result->literals);
+    
+    if (result->defect) return result->defect;
+    if ((result->cells & on) != on) return "a 1 cell is not covered";
+    if (result->cells & ~(on | dc)) return "a 0 cell is covered";
+    if (result->reported != result->literals) return "reported literal count is wrong";
+    if (cost < minimum) return "cheaper than the reference minimum";
+    
+    /* A shared output may grow to reuse terms of the others */
+    if (engine->kind == KIND_HEURISTIC || engine->kind == KIND_SHARED) {
+        if (cost > minimum) local->above_minimum++;
+        return NULL;
+    }
+    if (!result->optimal) {
+        local->unproven++;
+        return NULL;
+    }
+    return (cost > minimum) ? "claims optimal but is not minimum" : NULL;
+}
+
+static void check_block(verify_worker_t* worker) {
+    engine_totals_t local[ENGINE_COUNT];
+    memset(local, 0, sizeof(local));
+    
+    for (size_t i = 0; i < worker->count; i++) {
+        const truth_table_t* tt = &worker->tables[i];
+        uint64_t off = ~(tt->minterms | tt->dont_cares) & all_cells(tt->num_vars);
+        uint32_t sop_minimum = reference_cost(tt->minterms, tt->dont_cares, tt->num_vars);
+        uint32_t pos_minimum = reference_cost(off, tt->dont_cares, tt->num_vars);
+        
+        for (size_t e = 0; e < ENGINE_COUNT; e++) {
+            const verify_engine_t* engine = &engines[e];
+            bool offset = engine->kind == KIND_OFFSET;
+            verify_result_t result;
+            char reason[64];
+            const char* failure;
+            
+            memset(&result, 0, sizeof(result));
+            int status = engine->fn(worker, i, &result);
+            if (status != 0) {
+                snprintf(reason, sizeof(reason), "returned %d", status);
+                failure = reason;
+            } else {
+                failure = judge(engine, &result, offset ? off : tt->minterms, tt->dont_cares,
+                                offset ? pos_minimum : sop_minimum, &local[e]);
+            }
+            
+            local[e].checked++;
+            if (failure) {
+                local[e].failures++;
+                report_failure(engine, tt, failure);
+            }
+        }
+    }
+    
+    for (size_t e = 0; e < ENGINE_COUNT; e++) {
+        __atomic_fetch_add(&totals[e].checked, local[e].checked, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&totals[e].failures, local[e].failures, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&totals[e].unproven, local[e].unproven, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&totals[e].above_minimum, local[e].above_minimum, __ATOMIC_RELAXED);
+    }
+}
+
+static void report_wide_failure(const verify_engine_t* engine, const kmap_wide_table_t* tt,
+                                size_t index, const char* reason) {
+    pthread_mutex_lock(&report_lock);
+    if (failures_reported++ < max_failures) {
+        fprintf(stderr, "FAIL %-11s n=%u sample %zu minterms=", engine->name, tt->num_vars,
+                index);
+        for (size_t w = kmap_wide_words(tt->num_vars); w-- > 0;) {
+            fprintf(stderr, "%016llx", (unsigned long long)tt->minterms[w]);
+        }
+        fprintf(stderr, " dont_cares=");
+        for (size_t w = kmap_wide_words(tt->num_vars); w-- > 0;) {
+            fprintf(stderr, "%016llx", (unsigned long long)tt->dont_cares[w]);
+        }
+        fprintf(stderr, ": %s\n", reason);
+    }
+    pthread_mutex_unlock(&report_lock);
+}
+
+/**
+ * @brief judge() for a 7-8 variable result
+ */
+static const char* judge_wide(const wide_result_t* result, const kmap_wide_table_t* tt,
+                              uint32_t minimum, engine_totals_t* local) {
+    for (size_t w = 0; w < kmap_wide_words(tt->num_vars); w++) {
+        if ((result->cells[w] & tt->minterms[w]) != tt->minterms[w]) {
+            return "a 1 cell is not covered";
+        }
+        if (result->cells[w] & ~(tt->minterms[w] | tt->dont_cares[w])) {
+            return "a 0 cell is covered";
+        }
+    }
+    
+    uint32_t cost = cost_of(result->terms, result->literals);
+    if (result->reported != result->literals) return "reported literal count is wrong";
+    if (cost < minimum) return "cheaper than the reference minimum";
+    if (!result->optimal) {
+        local->unproven++;
+        return NULL;
+    }
+    return (cost > minimum) ? "claims optimal but is not minimum" : NULL;
+}
+
+static void check_wide_table(verify_worker_t* worker, size_t index, engine_totals_t* local) {
+    const kmap_wide_table_t* tt = &worker->wide;
+    uint32_t minimum = wide_reference_cost(worker, tt->minterms, tt->dont_cares);
+    
+    if (minimum == UINT32_MAX) {
+        __atomic_fetch_add(&wide_skipped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    for (size_t e = 0; e < ENGINE_COUNT; e++) {
+        const verify_engine_t* engine = &engines[e];
+        wide_result_t result;
+        char reason[64];
+        const char* failure;
+        
+        if (!engine->wide_fn) continue;
+        
+        memset(&result, 0, sizeof(result));
+        int status = engine->wide_fn(worker, &result);
+        if (status != 0) {
+            snprintf(reason, sizeof(reason), "returned %d", status);
+            failure = reason;
+        } else {
+            failure = judge_wide(&result, tt, minimum, &local[e]);
+        }
+        
+        local[e].checked++;
+        if (failure) {
+            local[e].failures++;
+            report_wide_failure(engine, tt, index, failure);
+        }
+    }
+}
+
+/* === DRIVER === */
+
+/* splitmix64: sample i depends only on (seed, i), not on the thread that draws it */
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Table number index of a pass
+ */
+static void pass_table(const verify_pass_t* pass, size_t index, truth_table_t* tt) {
+    uint8_t cells = (uint8_t)(1U << pass->num_vars);
+    uint64_t on = 0, dc = 0;
+    
+    if (pass->exhaustive && !pass->dont_cares) {
+        on = index;
+    } else if (pass->exhaustive) {
+        /* Base-3 digits: 0, 1 or don't care per cell */
+        for (uint8_t c = 0; c < cells; c++, index /= 3) {
+            if (index % 3 == 1) on |= 1ULL << c;
+            if (index % 3 == 2) dc |= 1ULL << c;
+        }
+    } else {
+        /* Independent draws per sample: ~1/4 don't cares, the rest split evenly */
+        uint64_t a = mix(pass->seed ^ mix(index));
+        uint64_t b = mix(a);
+        dc = a & b & all_cells(pass->num_vars);
+        on = mix(b) & ~dc & all_cells(pass->num_vars);
+    }
+    
+    init_truth_table(on, dc, pass->num_vars, tt);
+}
+
+/**
+ * @brief OR a random cube with about half the literals into cells
+ */
+static uint64_t add_random_cube(uint64_t r, uint8_t num_vars, uint64_t* cells) {
+    uint64_t cube[WIDE_MAX_WORDS];
+    uint16_t full = (uint16_t)((1U << num_vars) - 1);
+    uint16_t mask = (uint16_t)(r & full);
+    
+    wide_cube_cells(mask, (uint16_t)((r >> 16) & mask), num_vars, cube);
+    for (size_t w = 0; w < kmap_wide_words(num_vars); w++) cells[w] |= cube[w];
+    return mix(r);
+}
+
+/**
+ * @brief Sample index of a 7-8 variable pass: cube unions, sparse or complemented
+ */
+static void wide_pass_table(const verify_pass_t* pass, size_t index, kmap_wide_table_t* tt) {
+    uint8_t n = pass->num_vars;
+    size_t words = kmap_wide_words(n);
+    uint64_t on[WIDE_MAX_WORDS] = {0}, dc[WIDE_MAX_WORDS] = {0};
+    uint64_t r = mix(pass->seed ^ mix(index ^ ((uint64_t)n << 56)));
+    
+    switch (index % 3) {
+        case 0:
+            /* 2-6 cubes of 1s and one of don't cares */
+            for (uint32_t k = 2 + (uint32_t)(r % 5); k > 0; k--) r = add_random_cube(mix(r), n, on);
+            add_random_cube(mix(r), n, dc);
+            break;
+        case 1:
+            /* About 1/8 ones and 1/8 don't cares, scattered */
+            for (size_t w = 0; w < words; w++) {
+                uint64_t a = mix(r + 2 * w), b = mix(a), c = mix(b);
+                on[w] = a & b & c;
+                dc[w] = mix(c) & mix(c + 1) & mix(c + 2);
+            }
+            break;
+        default:
+            /* Complement of 3-8 cubes, with 1/16 don't cares */
+            for (uint32_t k = 3 + (uint32_t)(r % 6); k > 0; k--) r = add_random_cube(mix(r), n, on);
+            for (size_t w = 0; w < words; w++) {
+                uint64_t a = mix(r + 2 * w), b = mix(a);
+                on[w] = ~on[w];
+                dc[w] = a & b & mix(b) & mix(b + 1);
+            }
+            break;
+    }
+    
+    for (size_t w = 0; w < words; w++) {
+        tt->minterms[w] = on[w] & ~dc[w];
+        tt->dont_cares[w] = dc[w];
+    }
+}
+
+static void verify_wide_range(void* ctx, size_t begin, size_t end) {
+    const verify_pass_t* pass = (const verify_pass_t*)ctx;
+    const cube_table_t* cubes = &cube_tables[pass->num_vars];
+    engine_totals_t local[ENGINE_COUNT];
+    verify_worker_t worker;
+    
+    memset(local, 0, sizeof(local));
+    memset(&worker, 0, sizeof(worker));
+    kmap_get_options(&worker.opts);
+    worker.arena = kmap_arena_create(0);
+    worker.primes = malloc(cubes->count * sizeof(uint32_t));
+    worker.implicant = malloc(cubes->count);
+    if (!worker.arena || !worker.primes || !worker.implicant ||
+        kmap_wide_table_init(&worker.wide, pass->num_vars) != 0) {
+        fprintf(stderr, "kmap_verify: out of memory\n");
+        exit(2);
+    }
+    
+    for (size_t index = begin; index < end; index++) {
+        wide_pass_table(pass, index, &worker.wide);
+        check_wide_table(&worker, index, local);
+    }
+    
+    for (size_t e = 0; e < ENGINE_COUNT; e++) {
+        __atomic_fetch_add(&totals[e].checked, local[e].checked, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&totals[e].failures, local[e].failures, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&totals[e].unproven, local[e].unproven, __ATOMIC_RELAXED);
+    }
+    
+    free(worker.primes);
+    free(worker.implicant);
+    kmap_wide_table_free(&worker.wide);
+    kmap_arena_destroy(worker.arena);
+}
+
+static void verify_range(void* ctx, size_t begin, size_t end) {
+    const verify_pass_t* pass = (const verify_pass_t*)ctx;
+    truth_table_t tables[BLOCK_SIZE];
+    uint64_t minterms[BLOCK_SIZE], dont_cares[BLOCK_SIZE];
+    kmap_array_result_t array_results[BLOCK_SIZE];
+    verify_worker_t worker;
+    
+    memset(&worker, 0, sizeof(worker));
+    kmap_get_options(&worker.opts);
+    worker.tables = tables;
+    worker.array_results = array_results;
+    worker.arena = kmap_arena_create(0);
+    if (!worker.arena || kmap_wide_table_init(&worker.wide, pass->num_vars) != 0) {
+        fprintf(stderr, "kmap_verify: out of memory\n");
+        exit(2);
+    }
+    
+    for (size_t base = begin; base < end; base += BLOCK_SIZE) {
+        worker.count = (end - base < BLOCK_SIZE) ? end - base : BLOCK_SIZE;
+        for (size_t i = 0; i < worker.count; i++) {
+            pass_table(pass, base + i, &tables[i]);
+            minterms[i] = tables[i].minterms;
+            dont_cares[i] = tables[i].dont_cares;
+        }
+        
+        /* Per-item status is judged with the rest of the arrays results */
+        solve_kmap_batch_arrays(minterms, dont_cares, worker.count, pass->num_vars,
+                                array_results);
+        check_block(&worker);
+    }
+    
+    kmap_handle_destroy(worker.handle);
+    kmap_wide_table_free(&worker.wide);
+    kmap_arena_destroy(worker.arena);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--threads N] [--samples N] [--wide-samples N] [--seed N]\n"
+            "          [--max-failures N]\n"
+            "  --threads N       Worker threads (default: online CPUs)\n"
+            "  --samples N       Sampled tables per 4-6 variable pass (default %d)\n"
+            "  --wide-samples N  Sampled tables per 7-8 variable pass (default %d)\n"
+            "  --seed N          Sampling seed (default 1)\n"
+            "  --max-failures N  Failures printed in full (default %d)\n",
+            program, DEFAULT_SAMPLES, DEFAULT_WIDE_SAMPLES, DEFAULT_MAX_FAILURES);
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    size_t samples = DEFAULT_SAMPLES;
+    size_t wide_samples = DEFAULT_WIDE_SAMPLES;
+    uint64_t seed = 1;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--wide-samples") == 0 && i + 1 < argc) {
+            wide_samples = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--max-failures") == 0 && i + 1 < argc) {
+            max_failures = strtoull(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    /* No search budget: every exact result must be proven, independent of load */
+    kmap_options_t opts;
+    kmap_default_options(&opts);
+    opts.cover_node_limit = 0;
+    opts.cover_time_limit_us = 0;
+    kmap_set_options(&opts);
+    
+    /* Cache file of this run only: unlinked once mapped */
+    char cache_path[] = "/tmp/kmap_verify_XXXXXX";
+    int cache_fd = mkstemp(cache_path);
+    int cache_result = (cache_fd >= 0) ? kmap_disk_cache_open(cache_path, DISK_CACHE_ENTRIES) : -4;
+    if (cache_fd >= 0) {
+        close(cache_fd);
+        unlink(cache_path);
+    }
+    
+    kmap_pool_t* pool = kmap_pool_create(threads);
+    if (!pool || cache_result != 0 || kmap_npn_cache_init(NPN_CACHE_ENTRIES) != 0 ||
+        build_cube_table(7) != 0 || build_cube_table(8) != 0) {
+        fprintf(stderr, "kmap_verify: cannot create worker pool or caches\n");
+        return 2;
+    }
+    
+    const verify_pass_t passes[] = {
+        {2, true, true, 81, 0},
+        {3, true, true, 6561, 0},
+        {4, true, false, 65536, 0},
+        {4, false, true, samples, seed},
+        {5, false, true, samples, seed},
+        {6, false, true, samples, seed},
+        {7, false, true, wide_samples, seed},
+        {8, false, true, wide_samples, seed},
+    };
+    
+    printf("kmap_verify: %zu engines, %u threads\n", ENGINE_COUNT, kmap_pool_size(pool));
+    double start = now_seconds();
+    
+    for (size_t p = 0; p < sizeof(passes) / sizeof(passes[0]); p++) {
+        const verify_pass_t* pass = &passes[p];
+        bool wide = pass->num_vars >= WIDE_MIN_VARS;
+        double pass_start = now_seconds();
+        uint64_t skipped = __atomic_load_n(&wide_skipped, __ATOMIC_RELAXED);
+        
+        /* Wide tables cost far more each: small grains keep the threads balanced */
+        if (kmap_pool_run(pool, pass->count, wide ? 8 : BLOCK_SIZE,
+                          wide ? verify_wide_range : verify_range, (void*)pass) != 0) {
+            fprintf(stderr, "kmap_verify: pool run failed\n");
+            return 2;
+        }
+        printf("  n=%u %-26s %8zu tables  %6.2fs", pass->num_vars,
+               wide ? "sampled, wide engines" :
+               !pass->exhaustive ? "sampled, don't cares" :
+               pass->dont_cares ? "exhaustive, don't cares" : "exhaustive",
+               pass->count, now_seconds() - pass_start);
+        skipped = __atomic_load_n(&wide_skipped, __ATOMIC_RELAXED) - skipped;
+        if (skipped) printf("  (%llu past the reference budget)", (unsigned long long)skipped);
+        printf("\n");
+    }
+    
+    uint64_t failures = 0;
+    printf("\n%-12s %10s %9s %9s %10s\n", "engine", "checked", "failures", "unproven",
+           "above-min");
+    for (size_t e = 0; e < ENGINE_COUNT; e++) {
+        printf("%-12s %10llu %9llu %9llu %10llu\n", engines[e].name,
+               (unsigned long long)totals[e].checked, (unsigned long long)totals[e].failures,
+               (unsigned long long)totals[e].unproven,
+               (unsigned long long)totals[e].above_minimum);
+        failures += totals[e].failures;
+    }
+    printf("\n%s: %llu failures in %.2fs\n", failures ? "FAILED" : "PASSED",
+           (unsigned long long)failures, now_seconds() - start);
+    
+    for (uint8_t n = WIDE_MIN_VARS; n <= WIDE_MAX_VARS; n++) {
+        free(cube_tables[n].cells);
+        free(cube_tables[n].literals);
+    }
+    kmap_npn_cache_free();
+    kmap_disk_cache_close();
+    kmap_pool_destroy(pool);
+    return failures ? 1 : 0;
+}
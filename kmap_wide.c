@@ -0,0 +1,1074 @@
+/**
+ * @file kmap_wide.c
+ * @brief Multi-word truth tables for 7-16 variables
+ *
+ * Cells live in an array of 64-bit words (cell c = bit c % 64 of word
+ * c / 64). Variables 0-5 index bits inside a word and variables 6-15
+ * index words, so combining across a high variable is a word-to-word AND
+ * and across a low variable the same shift-and-mask as the 64-bit path.
+ * Tables with 6 or fewer variables are handed to the single-word solver.
+ */
+
+#include "kmap_internal.h"
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+/* Hard cap on generated primes before giving up with -4 */
+#define MAX_WIDE_PRIMES (1U << 20)
+
+/* Marks a cube dropped by the irredundancy pass (values outside the mask) */
+#define REMOVED_CUBE(cube) (((cube).values & ~(cube).mask) != 0)
+
+static const uint64_t low_var_masks[6] = {
+    VAR_MASK_0, VAR_MASK_1, VAR_MASK_2, VAR_MASK_3, VAR_MASK_4, VAR_MASK_5
+};
+
+/* === TABLE HELPERS === */
+
+size_t kmap_wide_words(uint8_t num_vars) {
+    return (num_vars <= MAX_VARIABLES) ? 1 : (size_t)1 << (num_vars - MAX_VARIABLES);
+}
+
+/**
+ * @brief Valid cells in word 0 (all 64 once there are 6+ variables)
+ */
+static inline uint64_t word_cell_mask(uint8_t num_vars) {
+    return (num_vars >= MAX_VARIABLES) ? ~0ULL : (1ULL << (1 << num_vars)) - 1;
+}
+
+int kmap_wide_table_init(kmap_wide_table_t* tt, uint8_t num_vars) {
+    if (!tt) return -1;
+    memset(tt, 0, sizeof(kmap_wide_table_t));
+    if (num_vars < 2 || num_vars > MAX_WIDE_VARIABLES) return -1;
+    
+    size_t words = kmap_wide_words(num_vars);
+    tt->minterms = calloc(words, sizeof(uint64_t));
+    tt->dont_cares = calloc(words, sizeof(uint64_t));
+    if (!tt->minterms || !tt->dont_cares) {
+        kmap_wide_table_free(tt);
+        return -1;
+    }
+    
+    tt->num_vars = num_vars;
+    return 0;
+}
+
+void kmap_wide_table_free(kmap_wide_table_t* tt) {
+    if (!tt) return;
+    
+    free(tt->minterms);
+    free(tt->dont_cares);
+    memset(tt, 0, sizeof(kmap_wide_table_t));
+}
+
+bool validate_wide_table(const kmap_wide_table_t* tt) {
+    if (!tt || !tt->minterms || !tt->dont_cares) return false;
+    if (tt->num_vars < 2 || tt->num_vars > MAX_WIDE_VARIABLES) return false;
+    
+    size_t words = kmap_wide_words(tt->num_vars);
+    uint64_t valid = word_cell_mask(tt->num_vars);
+    
+    for (size_t w = 0; w < words; w++) {
+        if (tt->minterms[w] & tt->dont_cares[w]) return false;
+        if ((tt->minterms[w] | tt->dont_cares[w]) & ~valid) return false;
+    }
+    
+    return true;
+}
+
+int kmap_wide_table_complement(const kmap_wide_table_t* tt, kmap_wide_table_t* off) {
+    if (!tt || !off) return -1;
+    if (!validate_wide_table(tt)) return -2;
+    if (kmap_wide_table_init(off, tt->num_vars) != 0) return -4;
+    
+    size_t words = kmap_wide_words(tt->num_vars);
+    uint64_t valid = word_cell_mask(tt->num_vars);
+    
+    for (size_t w = 0; w < words; w++) {
+        off->minterms[w] = ~(tt->minterms[w] | tt->dont_cares[w]) & valid;
+        off->dont_cares[w] = tt->dont_cares[w];
+    }
+    
+    return 0;
+}
+
+void kmap_cover_free(kmap_cover_t* cover) {
+    if (!cover) return;
+    
+    free(cover->cubes);
+    memset(cover, 0, sizeof(kmap_cover_t));
+}
+
+/* === WORD-LEVEL CUBE OPERATIONS === */
+
+/**
+ * @brief Move every cell to its neighbour across a low variable (0-5)
+ */
+static inline uint64_t swap_low(uint64_t cells, uint8_t var) {
+    uint8_t shift = (uint8_t)(1 << var);
+    return ((cells & low_var_masks[var]) >> shift) | ((cells & ~low_var_masks[var]) << shift);
+}
+
+/**
+ * @brief Combine a cell set with its neighbours across one variable
+ *
+ * dst = src op swap_var(src); op is AND (every cell of the merged cube
+ * qualifies) or OR (some cell of the merged cube qualifies).
+ */
+static void merge_variable(uint64_t* dst, const uint64_t* src, size_t words,
+                           uint8_t var, bool use_and) {
+    if (var < MAX_VARIABLES) {
+        for (size_t w = 0; w < words; w++) {
+            uint64_t other = swap_low(src[w], var);
+            dst[w] = use_and ? src[w] & other : src[w] | other;
+        }
+    } else {
+        size_t stride = (size_t)1 << (var - MAX_VARIABLES);
+        for (size_t w = 0; w < words; w++) {
+            uint64_t other = src[w ^ stride];
+            dst[w] = use_and ? src[w] & other : src[w] | other;
+        }
+    }
+}
+
+/**
+ * @brief Cells inside one word that belong to a cube (low variables only)
+ */
+static inline uint64_t cube_word_cells(kmap_cube_t cube, uint8_t num_vars) {
+    uint8_t low_vars = (num_vars < MAX_VARIABLES) ? num_vars : MAX_VARIABLES;
+    return cube_coverage((uint8_t)(cube.mask & 0x3F), (uint8_t)(cube.values & 0x3F), low_vars);
+}
+
+/**
+ * @brief Call fn for every word a cube touches, with the in-word cell mask
+ *
+ * Words are enumerated over the subsets of the cube's free high variables,
+ * so the cost is the number of words touched, not the number of cells.
+ */
+#define FOR_EACH_CUBE_WORD(cube, num_vars, w, cells, body)                   \
+    do {                                                                     \
+        uint64_t cells = cube_word_cells((cube), (num_vars));                \
+        size_t high_all_ = kmap_wide_words(num_vars) - 1;                    \
+        size_t high_free_ = ~(size_t)((cube).mask >> MAX_VARIABLES) & high_all_; \
+        size_t high_base_ = (size_t)((cube).values >> MAX_VARIABLES) & high_all_; \
+        size_t sub_ = 0;                                                     \
+        do {                                                                 \
+            size_t w = high_base_ | sub_;                                    \
+            body                                                             \
+            sub_ = (sub_ - high_free_) & high_free_;                         \
+        } while (sub_ != 0);                                                 \
+    } while (0)
+
+static uint32_t cube_literals(kmap_cube_t cube) {
+    return (uint32_t)__builtin_popcount(cube.mask);
+}
+
+bool wide_cube_within(kmap_cube_t cube, uint8_t num_vars, const uint64_t* cells) {
+    bool within = true;
+    FOR_EACH_CUBE_WORD(cube, num_vars, w, cube_cells, {
+        if (cube_cells & ~cells[w]) within = false;
+    });
+    return within;
+}
+
+/**
+ * @brief Number of cells in rows that a cube covers
+ */
+static uint32_t cube_gain(kmap_cube_t cube, uint8_t num_vars, const uint64_t* rows) {
+    uint32_t gain = 0;
+    FOR_EACH_CUBE_WORD(cube, num_vars, w, cells, {
+        gain += popcount(rows[w] & cells);
+    });
+    return gain;
+}
+
+/* === PRIME IMPLICANT GENERATION === */
+
+/**
+ * @brief Depth-first prime generation over free-variable sets
+ *
+ * Level d holds, for the current free set S:
+ *   impl[c] = every cell of cube(c, S) is a 1 or a don't care
+ *   hits[c] = some cell of cube(c, S) is a 1
+ * Children add a variable above max(S), so every S is visited once.
+ * A cube(c, S) is prime when impl holds but impl of S + v fails for every
+ * v outside S. Subtrees whose impl & hits is empty cannot hold a prime
+ * that covers a 1, so they are skipped.
+ */
+typedef struct {
+    uint8_t num_vars;
+    size_t words;
+    uint64_t* impl;                             // (num_vars + 1) levels
+    uint64_t* hits;                             // (num_vars + 1) levels
+    uint64_t* scratch;
+    
+    kmap_arena_t* arena;
+    kmap_cube_t* primes;                        // Newest arena allocation, grows in place
+    uint32_t count;
+    uint32_t capacity;
+    int error;
+} prime_gen_t;
+
+static void add_prime(prime_gen_t* pg, uint16_t cell, uint16_t free_vars) {
+    if (pg->count == pg->capacity) {
+        uint32_t capacity = pg->capacity ? pg->capacity * 2 : 64;
+        kmap_cube_t* grown = (capacity <= MAX_WIDE_PRIMES) ?
+            kmap_arena_grow(pg->arena, pg->primes, pg->capacity * sizeof(kmap_cube_t),
+                            capacity * sizeof(kmap_cube_t)) : NULL;
+        if (!grown) {
+            pg->error = -4;
+            return;
+        }
+        pg->primes = grown;
+        pg->capacity = capacity;
+    }
+    
+    uint16_t all = (uint16_t)((1U << pg->num_vars) - 1);
+    pg->primes[pg->count].mask = (uint16_t)(~free_vars & all);
+    pg->primes[pg->count].values = cell;
+    pg->count++;
+}
+
+static void collect_primes(prime_gen_t* pg, uint8_t depth, uint16_t free_vars) {
+    const uint64_t* impl = pg->impl + depth * pg->words;
+    const uint64_t* hits = pg->hits + depth * pg->words;
+    uint64_t* primes = pg->scratch;
+    
+    /* Representatives: cells whose free bits are all zero */
+    uint64_t low_rep = ~0ULL;
+    for (uint8_t v = 0; v < MAX_VARIABLES && v < pg->num_vars; v++) {
+        if (free_vars & (1U << v)) low_rep &= ~low_var_masks[v];
+    }
+    size_t high_free = (size_t)(free_vars >> MAX_VARIABLES);
+    
+    for (size_t w = 0; w < pg->words; w++) {
+        primes[w] = (w & high_free) ? 0 : impl[w] & hits[w] & low_rep;
+        KMAP_STAT_ADD(cubes_examined, popcount(primes[w]));
+    }
+    
+    /* Drop cubes that still grow across some variable */
+    for (uint8_t v = 0; v < pg->num_vars; v++) {
+        if (free_vars & (1U << v)) continue;
+        
+        if (v < MAX_VARIABLES) {
+            for (size_t w = 0; w < pg->words; w++) {
+                if (primes[w]) primes[w] &= ~swap_low(impl[w], v);
+            }
+        } else {
+            size_t stride = (size_t)1 << (v - MAX_VARIABLES);
+            for (size_t w = 0; w < pg->words; w++) {
+                if (primes[w]) primes[w] &= ~impl[w ^ stride];
+            }
+        }
+    }
+    
+    for (size_t w = 0; w < pg->words && !pg->error; w++) {
+        uint64_t bits = primes[w];
+        while (bits && !pg->error) {
+            uint16_t cell = (uint16_t)(w * 64 + ctz(bits));
+            bits &= bits - 1;
+            add_prime(pg, cell, free_vars);
+        }
+    }
+}
+
+static void prime_dfs(prime_gen_t* pg, uint8_t depth, uint16_t free_vars, uint8_t next_var) {
+    collect_primes(pg, depth, free_vars);
+    
+    const uint64_t* impl = pg->impl + depth * pg->words;
+    const uint64_t* hits = pg->hits + depth * pg->words;
+    uint64_t* child_impl = pg->impl + (depth + 1) * pg->words;
+    uint64_t* child_hits = pg->hits + (depth + 1) * pg->words;
+    
+    for (uint8_t v = next_var; v < pg->num_vars && !pg->error; v++) {
+        merge_variable(child_impl, impl, pg->words, v, true);
+        merge_variable(child_hits, hits, pg->words, v, false);
+        
+        uint64_t live = 0;
+        for (size_t w = 0; w < pg->words; w++) live |= child_impl[w] & child_hits[w];
+        if (!live) continue;
+        
+        prime_dfs(pg, (uint8_t)(depth + 1), (uint16_t)(free_vars | (1U << v)), (uint8_t)(v + 1));
+    }
+}
+
+int generate_wide_primes(const kmap_wide_table_t* tt, kmap_arena_t* arena,
+                         kmap_cube_t** primes, uint32_t* prime_count) {
+    prime_gen_t pg;
+    memset(&pg, 0, sizeof(pg));
+    pg.num_vars = tt->num_vars;
+    pg.words = kmap_wide_words(tt->num_vars);
+    pg.arena = arena;
+    
+    size_t level_words = (size_t)(tt->num_vars + 1) * pg.words;
+    pg.impl = kmap_arena_alloc(arena, level_words * sizeof(uint64_t));
+    pg.hits = kmap_arena_alloc(arena, level_words * sizeof(uint64_t));
+    pg.scratch = kmap_arena_alloc(arena, pg.words * sizeof(uint64_t));
+    
+    if (!pg.impl || !pg.hits || !pg.scratch) {
+        pg.error = -4;
+    } else {
+        for (size_t w = 0; w < pg.words; w++) {
+            pg.impl[w] = tt->minterms[w] | tt->dont_cares[w];
+            pg.hits[w] = tt->minterms[w];
+        }
+        prime_dfs(&pg, 0, 0, 0);
+    }
+    
+    if (pg.error) return pg.error;
+    
+    *primes = pg.primes;
+    *prime_count = pg.count;
+    return 0;
+}
+
+/* === COVER === */
+
+/**
+ * @brief Max-heap entry for lazy greedy selection
+ */
+typedef struct {
+    uint32_t gain;                              // Cells covered when last evaluated
+    uint32_t index;                             // Prime index
+} gain_entry_t;
+
+static inline bool gain_before(const gain_entry_t* a, const gain_entry_t* b,
+                               const kmap_cube_t* primes) {
+    if (a->gain != b->gain) return a->gain > b->gain;
+    return cube_literals(primes[a->index]) < cube_literals(primes[b->index]);
+}
+
+static void heap_sift_down(gain_entry_t* heap, uint32_t size, uint32_t i,
+                           const kmap_cube_t* primes) {
+    for (;;) {
+        uint32_t best = i, left = 2 * i + 1, right = left + 1;
+        if (left < size && gain_before(&heap[left], &heap[best], primes)) best = left;
+        if (right < size && gain_before(&heap[right], &heap[best], primes)) best = right;
+        if (best == i) return;
+        
+        gain_entry_t tmp = heap[i];
+        heap[i] = heap[best];
+        heap[best] = tmp;
+        i = best;
+    }
+}
+
+/**
+ * @brief Lazy greedy cover: gains only shrink, so a re-evaluated top
+ * entry that still beats the runner-up is the true maximum
+ */
+static int greedy_wide_cover(const kmap_cube_t* primes, uint32_t prime_count,
+                             uint8_t num_vars, uint64_t* rows, size_t words,
+                             kmap_arena_t* arena, uint32_t* selected, uint32_t* selected_count) {
+    gain_entry_t* heap = kmap_arena_alloc(arena, prime_count * sizeof(gain_entry_t));
+    if (!heap) return -4;
+    
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < prime_count; i++) {
+        uint32_t gain = cube_gain(primes[i], num_vars, rows);
+        if (gain == 0) continue;
+        heap[size].gain = gain;
+        heap[size].index = i;
+        size++;
+    }
+    for (uint32_t i = size / 2; i-- > 0;) heap_sift_down(heap, size, i, primes);
+    
+    uint64_t left = 0;
+    for (size_t w = 0; w < words; w++) left += popcount(rows[w]);
+    
+    while (left > 0 && size > 0) {
+        heap[0].gain = cube_gain(primes[heap[0].index], num_vars, rows);
+        
+        if (heap[0].gain == 0) {
+            heap[0] = heap[--size];
+            heap_sift_down(heap, size, 0, primes);
+            continue;
+        }
+        
+        /* Stale top: push it down and look again */
+        bool beaten = (size > 1 && gain_before(&heap[1], &heap[0], primes)) ||
+                      (size > 2 && gain_before(&heap[2], &heap[0], primes));
+        if (beaten) {
+            heap_sift_down(heap, size, 0, primes);
+            continue;
+        }
+        
+        kmap_cube_t cube = primes[heap[0].index];
+        selected[(*selected_count)++] = heap[0].index;
+        left -= heap[0].gain;
+        FOR_EACH_CUBE_WORD(cube, num_vars, w, cells, {
+            rows[w] &= ~cells;
+        });
+        
+        heap[0] = heap[--size];
+        heap_sift_down(heap, size, 0, primes);
+    }
+    
+    return left ? -4 : 0;
+}
+
+/**
+ * @brief Drop selected primes whose 1s are all covered by the others
+ *
+ * Terms with the most literals are tried first, like the 64-bit path.
+ */
+static int remove_redundant_cubes(const kmap_wide_table_t* tt, kmap_cube_t* cubes,
+                                  uint32_t* count, kmap_arena_t* arena) {
+    size_t cells = (size_t)1 << tt->num_vars;
+    uint32_t* depth = kmap_arena_calloc(arena, cells, sizeof(uint32_t));
+    if (!depth) return -4;
+    
+    uint16_t all = (uint16_t)((1U << tt->num_vars) - 1);
+    
+    for (uint32_t i = 0; i < *count; i++) {
+        uint16_t free_vars = (uint16_t)(~cubes[i].mask & all);
+        uint16_t sub = 0;
+        do {
+            depth[cubes[i].values | sub]++;
+            sub = (uint16_t)((sub - free_vars) & free_vars);
+        } while (sub != 0);
+    }
+    
+    for (uint32_t literals = (uint32_t)tt->num_vars + 1; literals-- > 0;) {
+        for (uint32_t i = 0; i < *count; i++) {
+            if (REMOVED_CUBE(cubes[i]) || cube_literals(cubes[i]) != literals) continue;
+            
+            uint16_t free_vars = (uint16_t)(~cubes[i].mask & all);
+            bool redundant = true;
+            uint16_t sub = 0;
+            do {
+                uint16_t cell = cubes[i].values | sub;
+                bool is_one = (tt->minterms[cell / 64] >> (cell % 64)) & 1;
+                if (is_one && depth[cell] == 1) redundant = false;
+                sub = (uint16_t)((sub - free_vars) & free_vars);
+            } while (redundant && sub != 0);
+            
+            if (!redundant) continue;
+            
+            sub = 0;
+            do {
+                depth[cubes[i].values | sub]--;
+                sub = (uint16_t)((sub - free_vars) & free_vars);
+            } while (sub != 0);
+            
+            cubes[i].mask = 0;
+            cubes[i].values = 1;
+        }
+    }
+    
+    uint32_t write = 0;
+    for (uint32_t i = 0; i < *count; i++) {
+        if (!REMOVED_CUBE(cubes[i])) cubes[write++] = cubes[i];
+    }
+    *count = write;
+    
+    return 0;
+}
+
+/**
+ * @brief Pick one row per class of rows covered by exactly the same primes
+ *
+ * Equivalent rows are interchangeable for the cover, so a function with
+ * many 1s can still have a core small enough for the exact search. Each
+ * prime adds a random key to the signature of every row it covers.
+ *
+ * @return false if more than 64 classes remain
+ */
+static bool collect_core_rows(const kmap_cube_t* primes, uint32_t prime_count,
+                              uint8_t num_vars, const uint64_t* rows, size_t words,
+                              size_t left, kmap_arena_t* arena,
+                              uint16_t* row_cells, uint32_t* row_count) {
+    *row_count = 0;
+    
+    if (left <= MAX_CELLS) {
+        for (size_t w = 0; w < words; w++) {
+            uint64_t bits = rows[w];
+            while (bits) {
+                row_cells[(*row_count)++] = (uint16_t)(w * 64 + ctz(bits));
+                bits &= bits - 1;
+            }
+        }
+        return true;
+    }
+    
+    uint64_t* signature = kmap_arena_calloc(arena, words * 64, sizeof(uint64_t));
+    if (!signature) return false;
+    
+    for (uint32_t i = 0; i < prime_count; i++) {
+        /* splitmix64 of the prime index */
+        uint64_t key = (uint64_t)(i + 1) * 0x9E3779B97F4A7C15ULL;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+        
+        FOR_EACH_CUBE_WORD(primes[i], num_vars, w, cells, {
+            uint64_t bits = rows[w] & cells;
+            while (bits) {
+                signature[w * 64 + ctz(bits)] += key;
+                bits &= bits - 1;
+            }
+        });
+    }
+    
+    uint64_t class_signature[MAX_CELLS];
+    bool fits = true;
+    
+    for (size_t w = 0; w < words && fits; w++) {
+        uint64_t bits = rows[w];
+        while (bits && fits) {
+            size_t cell = w * 64 + ctz(bits);
+            bits &= bits - 1;
+            
+            bool seen = false;
+            for (uint32_t k = 0; k < *row_count && !seen; k++) {
+                seen = (class_signature[k] == signature[cell]);
+            }
+            if (seen) continue;
+            
+            if (*row_count == MAX_CELLS) {
+                fits = false;
+                break;
+            }
+            class_signature[*row_count] = signature[cell];
+            row_cells[(*row_count)++] = (uint16_t)cell;
+        }
+    }
+    
+    return fits;
+}
+
+/**
+ * @brief Exact cover of up to 64 representative rows on the 64-bit core
+ * @return 0 on success, 1 if too many primes touch the rows, negative on error
+ */
+static int exact_core(const kmap_cube_t* primes, uint32_t prime_count,
+                      const uint16_t* row_cells, uint32_t row_count,
+                      const kmap_options_t* opts, uint32_t* selected,
+                      uint32_t* selected_count, bool* optimal) {
+    uint64_t columns[MAX_CUBES];
+    uint16_t costs[MAX_CUBES];
+    uint32_t index[MAX_CUBES];
+    uint32_t column_count = 0;
+    
+    for (uint32_t i = 0; i < prime_count; i++) {
+        uint64_t column = 0;
+        for (uint32_t r = 0; r < row_count; r++) {
+            if ((row_cells[r] & primes[i].mask) == primes[i].values) column |= 1ULL << r;
+        }
+        if (!column) continue;
+        
+        if (column_count == MAX_CUBES) return 1;
+        
+        columns[column_count] = column;
+        costs[column_count] = (uint16_t)(TERM_COST + cube_literals(primes[i]));
+        index[column_count] = i;
+        column_count++;
+    }
+    
+    uint32_t core[MAX_CELLS];
+    uint32_t core_count;
+    uint64_t all_rows = (row_count == MAX_CELLS) ? ~0ULL : (1ULL << row_count) - 1;
+    
+    int result = solve_cover(columns, costs, column_count, all_rows, opts,
+                             core, &core_count, optimal);
+    if (result != 0) return result;
+    
+    for (uint32_t i = 0; i < core_count; i++) {
+        selected[(*selected_count)++] = index[core[i]];
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Cover the 1s with primes
+ *
+ * Essential primes first (once/twice masks, word by word). A core of at
+ * most 64 row classes goes to the exact branch-and-bound of the 64-bit
+ * path; larger cores get a lazy greedy cover plus an irredundancy pass.
+ */
+static int cover_wide(const kmap_wide_table_t* tt, const kmap_cube_t* primes,
+                      uint32_t prime_count, const kmap_options_t* opts, kmap_arena_t* arena,
+                      uint32_t* selected, uint32_t* selected_count, bool* optimal) {
+    size_t words = kmap_wide_words(tt->num_vars);
+    uint8_t n = tt->num_vars;
+    int result = 0;
+    
+    uint64_t* once = kmap_arena_calloc(arena, words, sizeof(uint64_t));
+    uint64_t* twice = kmap_arena_calloc(arena, words, sizeof(uint64_t));
+    uint64_t* rows = kmap_arena_alloc(arena, words * sizeof(uint64_t));
+    if (!once || !twice || !rows) return -4;
+    
+    *selected_count = 0;
+    *optimal = true;
+    
+    for (uint32_t i = 0; i < prime_count; i++) {
+        FOR_EACH_CUBE_WORD(primes[i], n, w, cells, {
+            twice[w] |= once[w] & cells;
+            once[w] |= cells;
+        });
+    }
+    
+    /* Essentials: the only prime over some 1 */
+    memcpy(rows, tt->minterms, words * sizeof(uint64_t));
+    for (size_t w = 0; w < words; w++) once[w] &= ~twice[w] & rows[w];
+    
+    for (uint32_t i = 0; i < prime_count; i++) {
+        bool essential = false;
+        FOR_EACH_CUBE_WORD(primes[i], n, w, cells, {
+            if (once[w] & cells) essential = true;
+        });
+        if (!essential) continue;
+        
+        selected[(*selected_count)++] = i;
+        FOR_EACH_CUBE_WORD(primes[i], n, w, cells, {
+            rows[w] &= ~cells;
+        });
+    }
+    
+    size_t left = 0;
+    for (size_t w = 0; w < words; w++) left += popcount(rows[w]);
+    if (left == 0) return 0;
+    
+    /* Exact core over row classes; anything else falls back to greedy */
+    uint16_t row_cells[MAX_CELLS];
+    uint32_t row_count = 0;
+    if (collect_core_rows(primes, prime_count, n, rows, words, left, arena,
+                          row_cells, &row_count)) {
+        uint32_t before = *selected_count;
+        
+        result = exact_core(primes, prime_count, row_cells, row_count, opts,
+                            selected, selected_count, optimal);
+        if (result < 0) return result;
+        
+        if (result == 0) {
+            /* A signature collision could leave a row uncovered */
+            memcpy(twice, rows, words * sizeof(uint64_t));
+            for (uint32_t i = before; i < *selected_count; i++) {
+                FOR_EACH_CUBE_WORD(primes[selected[i]], n, w, cells, {
+                    twice[w] &= ~cells;
+                });
+            }
+            
+            bool covered = true;
+            for (size_t w = 0; w < words; w++) {
+                if (twice[w]) covered = false;
+            }
+            if (covered) return 0;
+        }
+        
+        *selected_count = before;
+        result = 0;
+    }
+    
+    *optimal = false;
+    return greedy_wide_cover(primes, prime_count, n, rows, words, arena,
+                             selected, selected_count);
+}
+
+/* === SOLVING === */
+
+int cover_wide_primes(const kmap_wide_table_t* tt, const kmap_cube_t* primes,
+                      uint32_t prime_count, const kmap_options_t* opts,
+                      kmap_arena_t* arena, kmap_cover_t* cover) {
+    memset(cover, 0, sizeof(kmap_cover_t));
+    
+    uint32_t* selected = kmap_arena_alloc(arena, (prime_count ? prime_count : 1) *
+                                                 sizeof(uint32_t));
+    if (!selected) return -4;
+    
+    uint32_t selected_count = 0;
+    bool optimal = false;
+    int result = cover_wide(tt, primes, prime_count, opts, arena,
+                            selected, &selected_count, &optimal);
+    if (result != 0) return result;
+    
+    kmap_cube_t* cubes = kmap_arena_alloc(arena, (selected_count ? selected_count : 1) *
+                                                 sizeof(kmap_cube_t));
+    if (!cubes) return -4;
+    
+    uint32_t count = selected_count;
+    for (uint32_t i = 0; i < count; i++) cubes[i] = primes[selected[i]];
+    
+    if (!optimal) {
+        result = remove_redundant_cubes(tt, cubes, &count, arena);
+        if (result != 0) return result;
+    }
+    
+    cover->cubes = cubes;
+    cover->count = count;
+    cover->optimal = optimal;
+    for (uint32_t i = 0; i < count; i++) cover->literal_count += cube_literals(cubes[i]);
+    
+    return 0;
+}
+
+/**
+ * @brief Copy a malloc'd cover into the arena
+ */
+static int adopt_cover(kmap_cover_t* cover, kmap_arena_t* arena) {
+    kmap_cube_t* cubes = kmap_arena_alloc(arena, (cover->count ? cover->count : 1) *
+                                                 sizeof(kmap_cube_t));
+    if (cubes && cover->count) memcpy(cubes, cover->cubes, cover->count * sizeof(kmap_cube_t));
+    
+    free(cover->cubes);
+    cover->cubes = cubes;
+    if (!cubes) {
+        cover->count = 0;
+        return -4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Espresso, or prime generation plus cover, at any width
+ */
+static int solve_general(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                         const kmap_options_t* opts, kmap_arena_t* arena) {
+    KMAP_STAT_ADD(solves, 1);
+    if (opts->flags & KMAP_OPT_ESPRESSO) {
+        int result = espresso_solve_wide(tt, cover);
+        return (result == 0) ? adopt_cover(cover, arena) : result;
+    }
+    
+    size_t words = kmap_wide_words(tt->num_vars);
+    bool any_one = false, all_set = true;
+    for (size_t w = 0; w < words; w++) {
+        if (tt->minterms[w]) any_one = true;
+        if ((tt->minterms[w] | tt->dont_cares[w]) != ~0ULL) all_set = false;
+    }
+    
+    cover->optimal = true;
+    if (!any_one) return 0;
+    
+    if (all_set) {
+        /* Every cell is 1 or don't care - constant 1 */
+        cover->cubes = kmap_arena_calloc(arena, 1, sizeof(kmap_cube_t));
+        if (!cover->cubes) return -4;
+        cover->count = 1;
+        return 0;
+    }
+    
+    kmap_cube_t* primes = NULL;
+    uint32_t prime_count = 0;
+    KMAP_STAGE_START(primes_start);
+    int result = generate_wide_primes(tt, arena, &primes, &prime_count);
+    KMAP_STAGE_STOP(KMAP_STAGE_PRIMES, primes_start);
+    if (result != 0) return result;
+    KMAP_STAT_ADD(primes_found, prime_count);
+    
+    KMAP_STAGE_START(cover_start);
+    result = cover_wide_primes(tt, primes, prime_count, opts, arena, cover);
+    KMAP_STAGE_STOP(KMAP_STAGE_COVER, cover_start);
+    return result;
+}
+
+/**
+ * @brief Solve a table of at most 6 variables on the 64-bit path
+ *
+ * solution_t holds MAX_GROUPS terms; a heuristic cover needing more
+ * (exact covers never do) is redone on the uncapped general path.
+ */
+static int solve_narrow(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                        const kmap_options_t* opts, kmap_arena_t* arena) {
+    truth_table_t narrow;
+    solution_t solution;
+    
+    int result = init_truth_table(tt->minterms[0], tt->dont_cares[0], tt->num_vars, &narrow);
+    if (result != 0) return result;
+    
+    result = find_prime_implicants_ex(&narrow, &solution, opts);
+    if (result == -4) return solve_general(tt, cover, opts, arena);
+    if (result != 0) return result;
+    
+    size_t count = solution.implicant_count ? solution.implicant_count : 1;
+    cover->cubes = kmap_arena_alloc(arena, count * sizeof(kmap_cube_t));
+    if (!cover->cubes) return -4;
+    
+    for (uint8_t i = 0; i < solution.implicant_count; i++) {
+        cover->cubes[i].mask = solution.implicants[i].literal_mask;
+        cover->cubes[i].values = solution.implicants[i].literal_values;
+    }
+    cover->count = solution.implicant_count;
+    cover->literal_count = solution.literal_count;
+    cover->optimal = solution.optimal;
+    
+    return 0;
+}
+
+int solve_kmap_wide_arena(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                          const kmap_options_t* opts, kmap_arena_t* arena) {
+    if (!tt || !cover || !arena) return -1;
+    memset(cover, 0, sizeof(kmap_cover_t));
+    if (!validate_wide_table(tt)) return -2;
+    
+    kmap_options_t defaults;
+    if (!opts) {
+        kmap_get_options(&defaults);
+        opts = &defaults;
+    }
+    
+    if (tt->num_vars <= MAX_VARIABLES) return solve_narrow(tt, cover, opts, arena);
+    return solve_general(tt, cover, opts, arena);
+}
+
+int solve_kmap_wide(const kmap_wide_table_t* tt, kmap_cover_t* cover,
+                    const kmap_options_t* opts) {
+    if (!tt || !cover) return -1;
+    memset(cover, 0, sizeof(kmap_cover_t));
+    
+    kmap_arena_t* arena = kmap_thread_arena();
+    if (!arena) return -4;
+    
+    /* Scratch and result live in the thread arena; only the result is copied out */
+    kmap_arena_mark_t mark = kmap_arena_mark(arena);
+    kmap_cover_t scratch;
+    int result = solve_kmap_wide_arena(tt, &scratch, opts, arena);
+    
+    if (result == 0) {
+        size_t bytes = scratch.count * sizeof(kmap_cube_t);
+        *cover = scratch;
+        cover->cubes = malloc(bytes ? bytes : 1);
+        if (cover->cubes) {
+            if (bytes) memcpy(cover->cubes, scratch.cubes, bytes);
+        } else {
+            memset(cover, 0, sizeof(kmap_cover_t));
+            result = -4;
+        }
+    }
+    
+    kmap_arena_release(arena, mark);
+    return result;
+}
+
+bool validate_wide_cover(const kmap_wide_table_t* tt, const kmap_cover_t* cover) {
+    if (!validate_wide_table(tt) || !cover) return false;
+    if (cover->count > 0 && !cover->cubes) return false;
+    
+    size_t words = kmap_wide_words(tt->num_vars);
+    uint64_t* covered = calloc(words, sizeof(uint64_t));
+    if (!covered) return false;
+    
+    bool ok = true;
+    uint16_t all = (uint16_t)((1U << tt->num_vars) - 1);
+    
+    for (uint32_t i = 0; i < cover->count && ok; i++) {
+        kmap_cube_t cube = cover->cubes[i];
+        if ((cube.mask & ~all) || (cube.values & ~cube.mask)) {
+            ok = false;
+            break;
+        }
+        
+        /* Each term must stay inside the 1s and don't cares */
+        FOR_EACH_CUBE_WORD(cube, tt->num_vars, w, cells, {
+            if (cells & ~(tt->minterms[w] | tt->dont_cares[w])) ok = false;
+            covered[w] |= cells & tt->minterms[w];
+        });
+    }
+    
+    for (size_t w = 0; w < words && ok; w++) {
+        if (covered[w] != tt->minterms[w]) ok = false;
+    }
+    
+    free(covered);
+    return ok;
+}
+
+/* === INPUT PARSING === */
+
+/**
+ * @brief Parse a minterm list "1,2,5 d(0,4,6)" with cells up to 65535
+ *
+ * Runs twice: once to find the highest cell (table == NULL), once to set
+ * the bits.
+ */
+static int scan_wide_list(const char* input, size_t len, kmap_wide_table_t* table,
+                          uint32_t* max_cell) {
+    size_t i = 0;
+    uint8_t section = 0;                        // 1 inside d(...)
+    bool after_number = false;                  // Number read, no comma yet
+    bool closed = false;
+    
+    *max_cell = 0;
+    
+    for (;;) {
+        while (i < len && input[i] != '\0' && isspace((unsigned char)input[i])) i++;
+        if (i >= len || input[i] == '\0') break;
+        
+        char c = input[i];
+        
+        if (c >= '0' && c <= '9') {
+            if (closed || after_number) return -1;
+            uint32_t value = 0;
+            while (i < len && input[i] >= '0' && input[i] <= '9') {
+                value = value * 10 + (uint32_t)(input[i] - '0');
+                if (value >= (1U << MAX_WIDE_VARIABLES)) return -1;
+                i++;
+            }
+            if (value > *max_cell) *max_cell = value;
+            if (table) {
+                uint64_t* bits = section ? table->dont_cares : table->minterms;
+                bits[value / 64] |= 1ULL << (value % 64);
+            }
+            after_number = true;
+            continue;
+        }
+        
+        /* Numbers are separated by commas; empty entries are skipped like parse_input_n */
+        if (c == ',' && !closed) {
+            after_number = false;
+            i++;
+            continue;
+        }
+        
+        if ((c == 'd' || c == 'D') && section == 0) {
+            i++;
+            while (i < len && input[i] != '\0' && isspace((unsigned char)input[i])) i++;
+            if (i >= len || input[i] != '(') return -1;
+            section = 1;
+            after_number = false;
+            i++;
+            continue;
+        }
+        
+        if (c == ')' && section == 1 && !closed) {
+            closed = true;
+            i++;
+            continue;
+        }
+        
+        return -1;
+    }
+    
+    if (section == 1 && !closed) return -1;
+    return 0;
+}
+
+/**
+ * @brief Binary strings and minterm lists
+ */
+static int parse_cells_wide(const char* input, size_t len, kmap_wide_table_t* tt) {
+    if (!input || !tt) return -1;
+    memset(tt, 0, sizeof(kmap_wide_table_t));
+    
+    /* Trim surrounding whitespace; a list has a comma or d(...) section */
+    size_t begin = 0, end = 0;
+    bool is_list = false;
+    for (size_t i = 0; i < len && input[i] != '\0'; i++) {
+        if (isspace((unsigned char)input[i])) continue;
+        if (end == 0) begin = i;
+        end = i + 1;
+        if (input[i] == ',' || input[i] == 'd' || input[i] == 'D') is_list = true;
+    }
+    if (end == 0) return -1;
+    
+    if (is_list) {
+        uint32_t max_cell;
+        if (scan_wide_list(input, end, NULL, &max_cell) != 0) return -1;
+        
+        uint8_t num_vars = 2;
+        while ((1U << num_vars) <= max_cell) num_vars++;
+        
+        if (kmap_wide_table_init(tt, num_vars) != 0) return -1;
+        scan_wide_list(input, end, tt, &max_cell);
+        
+        /* A cell listed as both 1 and don't care, as solve_forms_n reports it */
+        if (!validate_wide_table(tt)) {
+            kmap_wide_table_free(tt);
+            return -2;
+        }
+        return 0;
+    }
+    
+    /* Binary string: first character is the highest cell */
+    size_t bin_len = end - begin;
+    uint8_t num_vars = 0;
+    while (((size_t)1 << num_vars) < bin_len) num_vars++;
+    if (((size_t)1 << num_vars) != bin_len || num_vars < 2 || num_vars > MAX_WIDE_VARIABLES) {
+        return -1;
+    }
+    
+    if (kmap_wide_table_init(tt, num_vars) != 0) return -1;
+    
+    for (size_t i = 0; i < bin_len; i++) {
+        size_t cell = bin_len - 1 - i;
+        uint64_t bit = 1ULL << (cell % 64);
+        
+        switch (input[begin + i]) {
+            case '1': tt->minterms[cell / 64] |= bit; break;
+            case '0': break;
+            case 'X':
+            case 'x':
+            case '-': tt->dont_cares[cell / 64] |= bit; break;
+            default:
+                kmap_wide_table_free(tt);
+                return -1;
+        }
+    }
+    
+    return 0;
+}
+
+int parse_input_wide(const char* input, size_t len, kmap_wide_table_t* tt) {
+    int result = parse_cells_wide(input, len, tt);
+    
+    /* Neither cells nor a list: it may be an expression */
+    if (result == -1 && input && tt) result = parse_expression_wide(input, len, tt);
+    return result;
+}
+
+/* === OUTPUT === */
+
+int generate_sop_expression_wide(const kmap_cover_t* cover, uint8_t num_vars,
+                                 char* output, size_t output_len) {
+    if (!cover || (!output && output_len > 0)) return -1;
+    if (num_vars > MAX_WIDE_VARIABLES || (cover->count > 0 && !cover->cubes)) return -2;
+    
+    size_t pos = 0;
+    
+    if (cover->count == 0) pos = emit_chars(output, output_len, pos, "0", 1);
+    
+    for (uint32_t i = 0; i < cover->count; i++) {
+        char term[MAX_TERM_CHARS];
+        
+        if (i > 0) pos = emit_chars(output, output_len, pos, " + ", 3);
+        
+        size_t term_len = format_term(cover->cubes[i].mask, cover->cubes[i].values,
+                                      num_vars, false, term);
+        pos = emit_chars(output, output_len, pos, term, term_len);
+    }
+    
+    if (output_len > 0) output[pos < output_len ? pos : output_len - 1] = '\0';
+    
+    return (int)pos;
+}
+
+int generate_pos_expression_wide(const kmap_cover_t* off_cover, uint8_t num_vars,
+                                 char* output, size_t output_len) {
+    if (!off_cover || (!output && output_len > 0)) return -1;
+    if (num_vars > MAX_WIDE_VARIABLES || (off_cover->count > 0 && !off_cover->cubes)) return -2;
+    
+    size_t pos = 0;
+    
+    /* No 0 cells: constant 1 */
+    if (off_cover->count == 0) pos = emit_chars(output, output_len, pos, "1", 1);
+    
+    for (uint32_t i = 0; i < off_cover->count; i++) {
+        kmap_cube_t cube = off_cover->cubes[i];
+        bool wrap = cube_literals(cube) > 1 && off_cover->count > 1;
+        char clause[MAX_TERM_CHARS];
+        
+        if (i > 0) pos = emit_chars(output, output_len, pos, "&", 1);
+        if (wrap) pos = emit_chars(output, output_len, pos, "(", 1);
+        
+        size_t clause_len = format_term(cube.mask, cube.values, num_vars, true, clause);
+        pos = emit_chars(output, output_len, pos, clause, clause_len);
+        
+        if (wrap) pos = emit_chars(output, output_len, pos, ")", 1);
+    }
+    
+    if (output_len > 0) output[pos < output_len ? pos : output_len - 1] = '\0';
+    
+    return (int)pos;
+}
@@ -8,6 +8,7 @@ simplified Boolean expressions using an optimized C core engine.
 Usage:
     ./kmapper "1010"                    # Binary string input
     ./kmapper "0,1,3"                   # Minterm list input  
+    ./kmapper "A&~B | C"                # Boolean expression input
     ./kmapper -v "11110000"             # With K-map visualization
     ./kmapper -p "1010"                 # Generate POS instead of SOP
     ./kmapper -e "1010"                 # Educational mode with explanations
@@ -21,14 +22,185 @@ import sys
 import os
 import argparse
 import time
+import signal
+import threading
 from pathlib import Path
 
+# Native extension (make pymodule); without it every call goes through ctypes
+sys.path.insert(0, "./build")
+try:
+    import _kmapper
+except ImportError:
+    _kmapper = None
+finally:
+    sys.path.pop(0)
+
+class TruthTable(ctypes.Structure):
+    """Mirror of the C truth_table_t structure"""
+    _fields_ = [
+        ("minterms", ctypes.c_uint64),
+        ("dont_cares", ctypes.c_uint64),
+        ("num_vars", ctypes.c_uint8),
+        ("minterm_count", ctypes.c_uint8),
+    ]
+
+class WideTable(ctypes.Structure):
+    """Mirror of the C kmap_wide_table_t structure"""
+    _fields_ = [
+        ("minterms", ctypes.POINTER(ctypes.c_uint64)),
+        ("dont_cares", ctypes.POINTER(ctypes.c_uint64)),
+        ("num_vars", ctypes.c_uint8),
+    ]
+
+class KMapOptions(ctypes.Structure):
+    """Mirror of the C kmap_options_t structure"""
+    _fields_ = [
+        ("cover_node_limit", ctypes.c_uint32),
+        ("cover_time_limit_us", ctypes.c_uint32),
+        ("flags", ctypes.c_uint32),
+    ]
+
+class StreamOptions(ctypes.Structure):
+    """Mirror of the C kmap_stream_options_t structure"""
+    _fields_ = [
+        ("format", ctypes.c_uint32),
+        ("num_vars", ctypes.c_uint8),
+        ("form", ctypes.c_int),
+        ("batch_records", ctypes.c_size_t),
+    ]
+
+class StreamStats(ctypes.Structure):
+    """Mirror of the C kmap_stream_stats_t structure"""
+    _fields_ = [
+        ("records", ctypes.c_uint64),
+        ("failed", ctypes.c_uint64),
+        ("bytes_written", ctypes.c_uint64),
+    ]
+
+class ServeOptions(ctypes.Structure):
+    """Mirror of the C kmap_serve_options_t structure"""
+    _fields_ = [
+        ("form", ctypes.c_int),
+        ("max_connections", ctypes.c_size_t),
+        ("max_batch", ctypes.c_size_t),
+    ]
+
+class ServeStats(ctypes.Structure):
+    """Mirror of the C kmap_serve_stats_t structure"""
+    _fields_ = [
+        ("connections", ctypes.c_uint64),
+        ("requests", ctypes.c_uint64),
+        ("failed", ctypes.c_uint64),
+        ("batches", ctypes.c_uint64),
+    ]
+
+# kmap_stream_options_t.format values
+KMAP_STREAM_LINES = 0
+KMAP_STREAM_RECORDS = 1
+
+# kmap_options_t.flags bits
+KMAP_OPT_MEMO4 = 0x0001
+KMAP_OPT_NPN_CACHE = 0x0002
+KMAP_OPT_ESPRESSO = 0x0004
+KMAP_OPT_DISK_CACHE = 0x0008
+
+# solve_kmap_form() output forms
+KMAP_FORM_SOP = 0x0001
+KMAP_FORM_POS = 0x0002
+KMAP_FORM_BOTH = 0x0003
+KMAP_FORM_CHEAPEST = 0x0004
+KMAP_FORM_MAP = 0x0008              # Add-on: K-map grid first (2-6 variables)
+
+# kmap_stats_t stages, in KMAP_STAGE_* order
+KMAP_STAGE_NAMES = ("parse", "primes", "cover", "emit")
+
+class KMapStats(ctypes.Structure):
+    """C structure matching kmap_stats_t"""
+    _fields_ = [
+        ("solves", ctypes.c_uint64),
+        ("cubes_examined", ctypes.c_uint64),
+        ("primes_found", ctypes.c_uint64),
+        ("cover_nodes", ctypes.c_uint64),
+        ("cache_hits", ctypes.c_uint64),
+        ("cache_misses", ctypes.c_uint64),
+        ("stage_calls", ctypes.c_uint64 * len(KMAP_STAGE_NAMES)),
+        ("stage_ns", ctypes.c_uint64 * len(KMAP_STAGE_NAMES)),
+    ]
+
+# kmap_array_result_t as a NumPy structured dtype (68 bytes, no padding);
+# cubes[i] = literal_mask | literal_values << 8
+ARRAY_RESULT_FIELDS = [
+    ("term_count", "u1"),
+    ("literal_count", "u1"),
+    ("optimal", "u1"),
+    ("status", "i1"),
+    ("cubes", "<u2", (32,)),
+]
+
+class PackedSolutions:
+    """
+    Zero-copy view of solve_kmap_batch_packed() output
+    
+    `buffer` is a memoryview of the arena the C core wrote and `offsets`
+    a memoryview of the per-item start offsets, so other tools can read
+    the records directly. Indexing decodes one record into a list of
+    (literal_mask, literal_values) pairs, or None if that item failed.
+    """
+    
+    def __init__(self, arena, offsets, status, count):
+        self._arena = arena
+        self._offsets = offsets
+        self._status = status
+        self._count = count
+        self.buffer = memoryview(arena)
+        # ctypes exports '<Q'-style formats; recast to native ones for slicing
+        self.offsets = memoryview(offsets).cast('B').cast('N')[:count]
+        self.status = memoryview(status).cast('B').cast('i')[:count]
+    
+    def __len__(self):
+        return self._count
+    
+    def _varint(self, pos):
+        value = shift = 0
+        while True:
+            byte = self._arena[pos]
+            pos += 1
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value, pos
+            shift += 7
+    
+    def __getitem__(self, index):
+        if not -self._count <= index < self._count:
+            raise IndexError("record index out of range")
+        index %= self._count
+        if self._status[index] != 0:
+            return None
+        
+        pos = self._offsets[index] + 1  # skip num_vars / optimal byte
+        count, pos = self._varint(pos)
+        terms = []
+        for _ in range(count):
+            mask, pos = self._varint(pos)
+            values, pos = self._varint(pos)
+            terms.append((mask, values))
+        return terms
+    
+    def num_vars(self, index):
+        """Variable count of record index"""
+        return self._arena[self._offsets[index]] & 0x7F
+    
+    def optimal(self, index):
+        """True if record index is a proven minimum cover"""
+        return bool(self._arena[self._offsets[index]] & 0x80)
+
 class KMapSolver:
     """Lightweight Python interface to high-performance C K-map solver"""
     
     def __init__(self):
         """Initialize the solver and load C library"""
         self.lib = None
+        self.native = _kmapper
         self._load_library()
         self._setup_function_signatures()
     
@@ -65,17 +237,193 @@ class KMapSolver:
             ctypes.c_int      # buffer size
         ]
         self.lib.solve_kmap.restype = ctypes.c_int
+        
+        # int solve_kmap_form(const char* input, int form, char* output, int output_len)
+        self.lib.solve_kmap_form.argtypes = [
+            ctypes.c_char_p,  # input string
+            ctypes.c_int,     # KMAP_FORM_* value
+            ctypes.c_char_p,  # output buffer
+            ctypes.c_int      # buffer size
+        ]
+        self.lib.solve_kmap_form.restype = ctypes.c_int
+        
+        # int solve_kmap_batch_sop(const truth_table_t* tables, size_t count,
+        #                          char* arena, size_t arena_len,
+        #                          size_t* offsets, int* status)
+        self.lib.solve_kmap_batch_sop.argtypes = [
+            ctypes.POINTER(TruthTable),      # input tables
+            ctypes.c_size_t,                 # table count
+            ctypes.c_char_p,                 # string arena
+            ctypes.c_size_t,                 # arena size
+            ctypes.POINTER(ctypes.c_size_t), # per-item offsets
+            ctypes.POINTER(ctypes.c_int)     # per-item status
+        ]
+        self.lib.solve_kmap_batch_sop.restype = ctypes.c_int
+        
+        # int solve_kmap_batch_packed(const truth_table_t* tables, size_t count,
+        #                             uint8_t* arena, size_t arena_len,
+        #                             size_t* offsets, int* status)
+        self.lib.solve_kmap_batch_packed.argtypes = [
+            ctypes.POINTER(TruthTable),      # input tables
+            ctypes.c_size_t,                 # table count
+            ctypes.POINTER(ctypes.c_uint8),  # record arena
+            ctypes.c_size_t,                 # arena size
+            ctypes.POINTER(ctypes.c_size_t), # per-item offsets
+            ctypes.POINTER(ctypes.c_int)     # per-item status
+        ]
+        self.lib.solve_kmap_batch_packed.restype = ctypes.c_int
+    
+        # int solve_kmap_batch_arrays_mt(kmap_pool_t* pool, const uint64_t* minterms,
+        #                                const uint64_t* dont_cares, size_t count,
+        #                                uint8_t num_vars, kmap_array_result_t* results)
+        self.lib.solve_kmap_batch_arrays_mt.argtypes = [
+            ctypes.c_void_p,                 # pool (NULL = calling thread)
+            ctypes.c_void_p,                 # minterm array
+            ctypes.c_void_p,                 # don't-care array (NULL = none)
+            ctypes.c_size_t,                 # table count
+            ctypes.c_uint8,                  # variables per table
+            ctypes.c_void_p                  # result array
+        ]
+        self.lib.solve_kmap_batch_arrays_mt.restype = ctypes.c_int
+        
+        # kmap_pool_t* kmap_pool_create(unsigned num_threads)
+        # void kmap_pool_destroy(kmap_pool_t* pool)
+        self.lib.kmap_pool_create.argtypes = [ctypes.c_uint]
+        self.lib.kmap_pool_create.restype = ctypes.c_void_p
+        self.lib.kmap_pool_destroy.argtypes = [ctypes.c_void_p]
+        self.lib.kmap_pool_destroy.restype = None
+        
+        # void kmap_stream_default_options(kmap_stream_options_t* opts)
+        # int kmap_stream_file(const char* path, int out_fd, kmap_pool_t* pool,
+        #                      const kmap_stream_options_t* opts, kmap_stream_stats_t* stats)
+        self.lib.kmap_stream_default_options.argtypes = [ctypes.POINTER(StreamOptions)]
+        self.lib.kmap_stream_default_options.restype = None
+        self.lib.kmap_stream_file.argtypes = [
+            ctypes.c_char_p,                 # input path
+            ctypes.c_int,                    # output fd
+            ctypes.c_void_p,                 # pool (NULL = calling thread)
+            ctypes.POINTER(StreamOptions),   # options
+            ctypes.POINTER(StreamStats)      # counters
+        ]
+        self.lib.kmap_stream_file.restype = ctypes.c_int
+        
+        # kmap_server_t* kmap_server_create(const char* socket_path, kmap_pool_t* pool,
+        #                                   const kmap_serve_options_t* opts)
+        # int kmap_server_run(kmap_server_t* server), and stop / stats / destroy
+        self.lib.kmap_serve_default_options.argtypes = [ctypes.POINTER(ServeOptions)]
+        self.lib.kmap_serve_default_options.restype = None
+        self.lib.kmap_server_create.argtypes = [
+            ctypes.c_char_p,                 # socket path
+            ctypes.c_void_p,                 # pool (NULL = serving thread)
+            ctypes.POINTER(ServeOptions)     # options
+        ]
+        self.lib.kmap_server_create.restype = ctypes.c_void_p
+        self.lib.kmap_server_run.argtypes = [ctypes.c_void_p]
+        self.lib.kmap_server_run.restype = ctypes.c_int
+        self.lib.kmap_server_stop.argtypes = [ctypes.c_void_p]
+        self.lib.kmap_server_stop.restype = None
+        self.lib.kmap_server_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(ServeStats)]
+        self.lib.kmap_server_stats.restype = None
+        self.lib.kmap_server_destroy.argtypes = [ctypes.c_void_p]
+        self.lib.kmap_server_destroy.restype = None
+        
+        # int kmap_get_stats(kmap_stats_t* stats)
+        self.lib.kmap_get_stats.argtypes = [ctypes.POINTER(KMapStats)]
+        self.lib.kmap_get_stats.restype = ctypes.c_int
+        
+        # void kmap_get_options(kmap_options_t* opts)
+        # void kmap_set_options(const kmap_options_t* opts)
+        self.lib.kmap_get_options.argtypes = [ctypes.POINTER(KMapOptions)]
+        self.lib.kmap_get_options.restype = None
+        self.lib.kmap_set_options.argtypes = [ctypes.POINTER(KMapOptions)]
+        self.lib.kmap_set_options.restype = None
+        
+        # int parse_input_n(const char* input, size_t len, truth_table_t* tt)
+        # int parse_input_wide(const char* input, size_t len, kmap_wide_table_t* tt)
+        # int parse_expression_wide(const char* input, size_t len, kmap_wide_table_t* tt)
+        # void kmap_wide_table_free(kmap_wide_table_t* tt)
+        self.lib.parse_input_n.argtypes = [
+            ctypes.c_char_p, ctypes.c_size_t, ctypes.POINTER(TruthTable)]
+        self.lib.parse_input_n.restype = ctypes.c_int
+        for name in ("parse_input_wide", "parse_expression_wide"):
+            getattr(self.lib, name).argtypes = [
+                ctypes.c_char_p, ctypes.c_size_t, ctypes.POINTER(WideTable)]
+            getattr(self.lib, name).restype = ctypes.c_int
+        self.lib.kmap_wide_table_free.argtypes = [ctypes.POINTER(WideTable)]
+        self.lib.kmap_wide_table_free.restype = None
+        
+        # int kmap_disk_cache_open(const char* path, size_t entries)
+        self.lib.kmap_disk_cache_open.argtypes = [ctypes.c_char_p, ctypes.c_size_t]
+        self.lib.kmap_disk_cache_open.restype = ctypes.c_int
+    
+    def get_stats(self):
+        """
+        Solver counters of the core that served solve()
+        
+        The extension is a separate copy of the core, so it is only asked
+        first; without STATS=1 the ctypes-loaded library may still have them.
+        
+        Returns:
+            dict: solves, cubes_examined, primes_found, cover_nodes,
+                  cache_hits, cache_misses and per-stage {calls, ns};
+                  None if neither core was built with STATS=1
+        """
+        if self.native is not None:
+            stats = self.native.get_stats()
+            if stats is not None:
+                return stats
+        
+        stats = KMapStats()
+        if self.lib.kmap_get_stats(ctypes.byref(stats)) != 0:
+            return None
+        
+        result = {name: getattr(stats, name) for name, _ in KMapStats._fields_[:6]}
+        result["stages"] = {name: {"calls": stats.stage_calls[i], "ns": stats.stage_ns[i]}
+                            for i, name in enumerate(KMAP_STAGE_NAMES)}
+        return result
     
-    def solve(self, input_str, max_output_len=1024):
+    def set_flags(self, set_bits=0, clear_bits=0):
+        """Update the process-wide solver option flags (KMAP_OPT_*)"""
+        opts = KMapOptions()
+        self.lib.kmap_get_options(ctypes.byref(opts))
+        opts.flags = (opts.flags | set_bits) & ~clear_bits
+        self.lib.kmap_set_options(ctypes.byref(opts))
+        
+        # The extension links its own copy of the core, with its own options
+        if self.native is not None:
+            self.native.set_flags(set_bits, clear_bits)
+    
+    def open_cache(self, path, entries=0):
+        """
+        Share solutions with other processes through a cache file
+        
+        Args:
+            path: Cache file, created if missing
+            entries: Capacity of a new file (0 = library default)
+        """
+        path = os.fsencode(path)
+        result = self.lib.kmap_disk_cache_open(path, entries)
+        if result == -3:
+            raise ValueError(f"{os.fsdecode(path)} is not a compatible K-map cache file")
+        if result != 0:
+            raise RuntimeError(f"Cannot map cache file {os.fsdecode(path)} (code {result})")
+        self.set_flags(KMAP_OPT_DISK_CACHE)
+        
+        if self.native is not None:
+            self.native.open_cache(path, entries)
+    
+    def solve(self, input_str, max_output_len=1024, form=KMAP_FORM_SOP):
         """
         Solve K-map and return simplified Boolean expression
         
         Args:
             input_str: Truth table as binary string or minterm list
             max_output_len: Maximum length of output expression
+            form: KMAP_FORM_SOP, KMAP_FORM_POS or KMAP_FORM_CHEAPEST
+                  (KMAP_FORM_BOTH returns "SOP\nPOS"; see solve_both)
             
         Returns:
-            str: Simplified Boolean expression (SOP form)
+            str: Simplified Boolean expression
             
         Raises:
             ValueError: If input is invalid or solving fails
@@ -87,15 +435,20 @@ class KMapSolver:
         if not input_str.strip():
             raise ValueError("Input cannot be empty")
         
-        # Create output buffer
-        output_buffer = ctypes.create_string_buffer(max_output_len)
+        if self.native is not None:
+            return self.native.solve(input_str, form)
         
-        # Call C function
-        result = self.lib.solve_kmap(
-            input_str.encode('utf-8'),
-            output_buffer,
-            max_output_len
-        )
+        # Create output buffer; 7-16 variable covers can outgrow the default
+        encoded = input_str.encode('utf-8')
+        while True:
+            output_buffer = ctypes.create_string_buffer(max_output_len)
+            
+            # Call C function
+            result = self.lib.solve_kmap_form(encoded, form, output_buffer, max_output_len)
+            
+            if result != -3 or max_output_len >= (1 << 24):
+                break
+            max_output_len *= 4
         
         # Check for errors
         if result != 0:
@@ -109,80 +462,316 @@ class KMapSolver:
             raise ValueError(f"K-map solving failed: {error_msg}")
         
         return output_buffer.value.decode('utf-8')
+    
+    def describe_input(self, input_str):
+        """
+        Parse input_str the way solve() does
+        
+        Returns:
+            tuple: (format name, number of variables); format is
+                   "Binary string", "Minterm list" or "Expression"
+            
+        Raises:
+            ValueError: If the input does not parse
+        """
+        encoded = input_str.encode('utf-8')
+        
+        wide = WideTable()
+        is_expression = self.lib.parse_expression_wide(encoded, len(encoded),
+                                                       ctypes.byref(wide)) == 0
+        if is_expression:
+            self.lib.kmap_wide_table_free(ctypes.byref(wide))
+        
+        # Narrow parse first, wide only when the narrow one rejects the input
+        tt = TruthTable()
+        result = self.lib.parse_input_n(encoded, len(encoded), ctypes.byref(tt))
+        num_vars = tt.num_vars
+        if result == -1:
+            wide = WideTable()
+            result = self.lib.parse_input_wide(encoded, len(encoded), ctypes.byref(wide))
+            if result == 0:
+                num_vars = wide.num_vars
+                self.lib.kmap_wide_table_free(ctypes.byref(wide))
+        if result != 0:
+            raise ValueError(f"Cannot parse input (code {result})")
+        
+        if is_expression:
+            return "Expression", num_vars
+        is_list = ',' in input_str or 'd' in input_str
+        return ("Minterm list" if is_list else "Binary string"), num_vars
+    
+    def stream_file(self, path, out_fd=1, form=KMAP_FORM_SOP, record_vars=None, threads=0):
+        """
+        Solve every record of a file in the C core, one output line each
+        
+        Args:
+            path: Input file (one input per line, or binary records)
+            out_fd: File descriptor to write results to
+            form: KMAP_FORM_* value for every line
+            record_vars: Variable count of binary {uint64, uint64} records,
+                         or None for a text file
+            threads: Worker threads (0 = one per CPU)
+            
+        Returns:
+            StreamStats: records, failed and bytes_written counters
+        """
+        opts = StreamOptions()
+        self.lib.kmap_stream_default_options(ctypes.byref(opts))
+        opts.form = form
+        if record_vars is not None:
+            opts.format = KMAP_STREAM_RECORDS
+            opts.num_vars = record_vars
+        
+        stats = StreamStats()
+        pool = self.lib.kmap_pool_create(threads)
+        try:
+            result = self.lib.kmap_stream_file(os.fsencode(path), out_fd, pool,
+                                               ctypes.byref(opts), ctypes.byref(stats))
+        finally:
+            self.lib.kmap_pool_destroy(pool)
+        
+        if result != 0:
+            raise ValueError(f"Streaming failed (code {result})")
+        return stats
+    
+    def serve(self, socket_path, form=KMAP_FORM_SOP, threads=0):
+        """
+        Answer solve requests on a Unix socket until SIGINT or SIGTERM
+        
+        The C daemon runs in a background thread (ctypes drops the GIL);
+        this thread only waits for a signal and then stops it.
+        
+        Args:
+            socket_path: Socket to listen on (a stale socket is replaced)
+            form: KMAP_FORM_* for requests that do not name one
+            threads: Worker threads for batches (0 = one per CPU)
+            
+        Returns:
+            ServeStats: connections, requests, failed and batches counters
+        """
+        opts = ServeOptions()
+        self.lib.kmap_serve_default_options(ctypes.byref(opts))
+        opts.form = form
+        
+        pool = self.lib.kmap_pool_create(threads)
+        server = self.lib.kmap_server_create(os.fsencode(socket_path), pool, ctypes.byref(opts))
+        if not server:
+            self.lib.kmap_pool_destroy(pool)
+            raise RuntimeError(f"Cannot listen on {socket_path}")
+        
+        result = []
+        worker = threading.Thread(target=lambda: result.append(self.lib.kmap_server_run(server)))
+        stop = lambda signum, frame: self.lib.kmap_server_stop(server)
+        previous = signal.signal(signal.SIGTERM, stop)
+        try:
+            worker.start()
+            while worker.is_alive():
+                try:
+                    worker.join(0.5)
+                except KeyboardInterrupt:
+                    self.lib.kmap_server_stop(server)
+            
+            stats = ServeStats()
+            self.lib.kmap_server_stats(server, ctypes.byref(stats))
+        finally:
+            signal.signal(signal.SIGTERM, previous)
+            if worker.is_alive():
+                self.lib.kmap_server_stop(server)
+                worker.join()
+            self.lib.kmap_server_destroy(server)
+            self.lib.kmap_pool_destroy(pool)
+        
+        if result and result[0] != 0:
+            raise RuntimeError(f"Server failed (code {result[0]})")
+        return stats
+    
+    def solve_table(self, minterms, dont_cares, num_vars, form=KMAP_FORM_SOP):
+        """
+        Solve a table given as integer cell masks (bit i = cell i)
+        
+        With the native extension the masks go straight to the solver;
+        otherwise they are written out as a binary string (2-16 variables).
+        """
+        if self.native is not None:
+            return self.native.solve_table(minterms, dont_cares, num_vars, form)
+        
+        cells = ''.join('X' if dont_cares >> i & 1 else '1' if minterms >> i & 1 else '0'
+                        for i in reversed(range(1 << num_vars)))
+        return self.solve(cells, form=form)
+    
+    def solve_many(self, items, form=KMAP_FORM_SOP):
+        """
+        Solve str inputs and/or (minterms, dont_cares, num_vars) tuples
+        
+        The native extension solves the whole list with the GIL released.
+        
+        Raises:
+            ValueError: On the first item that fails
+        """
+        if self.native is not None:
+            return self.native.solve_many(items, form)
+        return [self.solve(item, form=form) if isinstance(item, str) else
+                self.solve_table(*item, form=form) for item in items]
+    
+    def solve_both(self, input_str):
+        """Return (sop, pos) for one input from a single library call"""
+        sop, pos = self.solve(input_str, form=KMAP_FORM_BOTH).split('\n')
+        return sop, pos
+    
+    def _table_array(self, tables):
+        """Pack (minterms, dont_cares, num_vars) tuples into a truth_table_t array"""
+        table_array = (TruthTable * len(tables))()
+        for i, (minterms, dont_cares, num_vars) in enumerate(tables):
+            table_array[i].minterms = minterms
+            table_array[i].dont_cares = dont_cares
+            table_array[i].num_vars = num_vars
+            table_array[i].minterm_count = bin(minterms).count('1')
+        return table_array
+    
+    def _grow_arena(self, fill, status, count, arena_len, max_len):
+        """
+        Call fill(arena_len), quadrupling the arena while items report -3
+        
+        -3 is only the arena running out (a failed cover is -4), so a bad
+        table cannot drive the arena up to max_len.
+        
+        Returns:
+            The arena of the last fill() call
+        """
+        while True:
+            arena = fill(arena_len)
+            if -3 not in status[:count] or arena_len >= max_len:
+                return arena
+            arena_len *= 4
+    
+    def solve_tables_packed(self, tables, bytes_per_item=16):
+        """
+        Solve many functions into packed binary records (no strings)
+        
+        Args:
+            tables: Iterable of (minterms, dont_cares, num_vars) tuples
+            bytes_per_item: Initial arena space reserved per record
+            
+        Returns:
+            PackedSolutions: records backed by the buffer the C core wrote
+        """
+        tables = list(tables)
+        count = len(tables)
+        table_array = self._table_array(tables)
+        offsets = (ctypes.c_size_t * max(count, 1))()
+        status = (ctypes.c_int * max(count, 1))()
+        
+        def fill(arena_len):
+            arena = bytearray(arena_len)
+            view = (ctypes.c_uint8 * arena_len).from_buffer(arena)
+            self.lib.solve_kmap_batch_packed(table_array, count, view, arena_len,
+                                             offsets, status)
+            del view
+            return arena
+        
+        arena = self._grow_arena(fill, status, count, max(count * bytes_per_item, 1),
+                                 count * 256)
+        return PackedSolutions(arena, offsets, status, count)
+    
+    def solve_array(self, minterms, dont_cares, num_vars, threads=1):
+        """
+        Solve NumPy arrays of uint64 bit masks in one C call
+        
+        The array buffers are handed to the C core as they are (copied only
+        if they are not already contiguous uint64), and the results come
+        back as one structured array; no Python object is built per item.
+        
+        Args:
+            minterms: Array of 1s bit masks (any shape)
+            dont_cares: Array of the same shape, or None for no don't cares
+            num_vars: Variables of every table (2-6)
+            threads: Worker threads (1 = calling thread, 0 = one per CPU)
+            
+        Returns:
+            numpy.ndarray: ARRAY_RESULT_FIELDS records shaped like minterms;
+            failed items have a nonzero status and no terms
+        """
+        import numpy as np
+        
+        minterms = np.ascontiguousarray(minterms, dtype=np.uint64)
+        if dont_cares is not None:
+            dont_cares = np.ascontiguousarray(dont_cares, dtype=np.uint64)
+            if dont_cares.shape != minterms.shape:
+                raise ValueError("minterms and dont_cares must have the same shape")
+        
+        results = np.zeros(minterms.shape, dtype=np.dtype(ARRAY_RESULT_FIELDS))
+        pool = self.lib.kmap_pool_create(threads) if threads != 1 else None
+        try:
+            self.lib.solve_kmap_batch_arrays_mt(
+                pool, minterms.ctypes.data,
+                dont_cares.ctypes.data if dont_cares is not None else None,
+                minterms.size, num_vars, results.ctypes.data)
+        finally:
+            if pool:
+                self.lib.kmap_pool_destroy(pool)
+        
+        return results
+    
+    def solve_tables(self, tables, bytes_per_item=64):
+        """
+        Solve many functions with a single call into the C core
+        
+        Args:
+            tables: Iterable of (minterms, dont_cares, num_vars) tuples
+                    where minterms/dont_cares are integer bit masks
+            bytes_per_item: Initial arena space reserved per expression
+            
+        Returns:
+            list: Simplified expression (str) per table, or None on failure
+        """
+        tables = list(tables)
+        count = len(tables)
+        if count == 0:
+            return []
+        
+        table_array = self._table_array(tables)
+        offsets = (ctypes.c_size_t * count)()
+        status = (ctypes.c_int * count)()
+        
+        def fill(arena_len):
+            arena = ctypes.create_string_buffer(arena_len)
+            self.lib.solve_kmap_batch_sop(table_array, count, arena, arena_len,
+                                          offsets, status)
+            return arena
+        
+        arena = self._grow_arena(fill, status, count, count * bytes_per_item, count * 1024)
+        raw = arena.raw
+        results = []
+        for i in range(count):
+            if status[i] != 0:
+                results.append(None)
+                continue
+            end = raw.index(b'\0', offsets[i])
+            results.append(raw[offsets[i]:end].decode('utf-8'))
+        return results
 
 def render_kmap_ascii(input_str, num_vars=None):
     """
     Render ASCII K-map visualization
     
+    The grid is drawn by the C core from the same parse and solve as the
+    expression, with each SOP group lettered in its cells and a legend.
+    
     Args:
         input_str: Truth table input
-        num_vars: Number of variables (auto-detected if None)
+        num_vars: Unused; the variable count comes from the input
     
     Returns:
         str: ASCII representation of K-map
     """
-    # Auto-detect number of variables
-    if num_vars is None:
-        if ',' in input_str:
-            # Minterm list - find max value
-            try:
-                minterms = [int(x.strip()) for x in input_str.split(',')]
-                max_minterm = max(minterms)
-                num_vars = 2
-                while (1 << num_vars) <= max_minterm:
-                    num_vars += 1
-            except ValueError:
-                return "Error: Invalid minterm list format"
-        else:
-            # Binary string
-            length = len(input_str.strip())
-            num_vars = 0
-            while (1 << num_vars) < length:
-                num_vars += 1
-    
-    if num_vars > 4:
-        return f"ASCII visualization not supported for {num_vars} variables (>4)"
-    
-    # Parse input to truth table
-    if ',' in input_str:
-        # Convert minterm list to binary string
-        minterms = [int(x.strip()) for x in input_str.split(',')]
-        truth_table = ['0'] * (1 << num_vars)
-        for m in minterms:
-            if 0 <= m < len(truth_table):
-                truth_table[m] = '1'
-        binary_str = ''.join(truth_table)
-    else:
-        binary_str = input_str.strip()
-    
-    # Generate ASCII K-map
-    output = [f"K-Map for {num_vars} variables:"]
-    
-    if num_vars == 2:
-        # 2x2 grid
-        output.append("   00 01 11 10")
-        output.append("0 │ " + "  ".join([binary_str[0], binary_str[1], binary_str[3], binary_str[2]]))
-        
-    elif num_vars == 3:
-        # 2x4 grid  
-        output.append("    00 01 11 10")
-        row0 = [binary_str[0], binary_str[1], binary_str[3], binary_str[2]]
-        row1 = [binary_str[4], binary_str[5], binary_str[7], binary_str[6]]
-        output.append(" 0 │ " + "  ".join(row0))
-        output.append(" 1 │ " + "  ".join(row1))
-        
-    elif num_vars == 4:
-        # 4x4 grid
-        output.append("    00 01 11 10")
-        gray_order = [0, 1, 3, 2]
-        for row in range(4):
-            row_cells = []
-            for col in range(4):
-                idx = gray_order[row] * 4 + gray_order[col]
-                row_cells.append(binary_str[idx] if idx < len(binary_str) else '0')
-            output.append(f"{gray_order[row]:02b} │ " + "  ".join(row_cells))
-    
-    return "\n".join(output)
+    output = KMapSolver().solve(input_str, form=KMAP_FORM_SOP | KMAP_FORM_MAP)
+    return split_kmap(output, KMAP_FORM_SOP)[0]
+
+def split_kmap(output, form):
+    """Split KMAP_FORM_MAP output into (grid, expression text)"""
+    expression_lines = 2 if form == KMAP_FORM_BOTH else 1
+    lines = output.split('\n')
+    return '\n'.join(lines[:-expression_lines]), '\n'.join(lines[-expression_lines:])
 
 def print_usage_examples():
     """Print usage examples and help information"""
@@ -195,14 +784,24 @@ BASIC USAGE:
   ./kmapper "10110100"          # 8 cells = 3 variables
 
 OPTIONS:
-  -v, --visualize               # Show ASCII K-map grid
+  -v, --visualize               # Show ASCII K-map grid with its groups (2-6 variables)
   -e, --explain                 # Show step-by-step explanation
+  -p, --pos                     # Product of sums instead of SOP
+  --both                        # Print both SOP and POS
+  --cheapest                    # Print whichever form is smaller
+  --espresso                    # Heuristic minimizer for large inputs
+  --stream FILE                 # Solve every line of FILE in the C core
+  --records N                   # FILE holds binary records of N variables
+  --serve SOCKET                # Answer pipelined requests on a Unix socket
   -h, --help                    # Show this help
 
 INPUT FORMATS:
   Binary String:    "1010"      # Each digit = one truth table cell
   Minterm List:     "0,1,3"     # Comma-separated minterm numbers
   Don't Cares:      "10X1"      # X = don't care condition
+  Minterms + d():   "1,2,5 d(0,4,6)"  # Don't cares after the minterm list
+  Wide tables:      "0,255 d(1,254)"  # Up to 16 variables (A-P)
+  Expression:       "A&~B | C"  # Also AB + C', A^B; optional d(...) after it
 
 EXAMPLES:
   ./kmapper "1100"                    → Output: ~B
@@ -210,6 +809,7 @@ EXAMPLES:
   ./kmapper "0,3"                     → Output: ~A&~B + A&B
   ./kmapper -v "11110000"             → Shows K-map + expression
   ./kmapper "1X1X"                    → Uses don't cares for optimization
+  ./kmapper -p "0,1,2"                → Output: ~A + ~B
 
 PERFORMANCE:
   • 2-4 variables: <1ms response time
@@ -228,14 +828,14 @@ def main():
     
     parser.add_argument(
         'input',
-        help='Truth table (binary string or minterm list)',
+        help='Truth table (binary string, minterm list or expression)',
         nargs='?'
     )
     
     parser.add_argument(
         '-v', '--visualize',
         action='store_true',
-        help='Show ASCII K-map visualization'
+        help='Show the K-map grid with its groups (2-6 variables; with --stream, per record)'
     )
     
     parser.add_argument(
@@ -244,6 +844,62 @@ def main():
         help='Show step-by-step explanation'
     )
     
+    form_group = parser.add_mutually_exclusive_group()
+    form_group.add_argument(
+        '-p', '--pos',
+        action='store_true',
+        help='Output product of sums (POS) instead of SOP'
+    )
+    form_group.add_argument(
+        '--both',
+        action='store_true',
+        help='Output both SOP and POS from one solve'
+    )
+    form_group.add_argument(
+        '--cheapest',
+        action='store_true',
+        help='Output whichever of SOP and POS has fewer terms and literals'
+    )
+    
+    parser.add_argument(
+        '--espresso',
+        action='store_true',
+        help='Use the heuristic Espresso minimizer instead of exact cover'
+    )
+    
+    parser.add_argument(
+        '--stream',
+        metavar='FILE',
+        help='Solve every record of FILE (one input per line), writing one result per line'
+    )
+    
+    parser.add_argument(
+        '--records',
+        metavar='N',
+        type=int,
+        help='With --stream: FILE holds binary {uint64 minterms, uint64 dont_cares} records of N variables'
+    )
+    
+    parser.add_argument(
+        '--serve',
+        metavar='SOCKET',
+        help='Run a solver daemon on a Unix socket: one request per line (optionally '
+             '"pos:", "both:" or "cheapest:" first), one answer line each'
+    )
+    
+    parser.add_argument(
+        '--cache',
+        metavar='FILE',
+        default=os.environ.get('KMAPPER_CACHE'),
+        help='Share solutions across runs through a cache file (default: $KMAPPER_CACHE)'
+    )
+    
+    parser.add_argument(
+        '--stats',
+        action='store_true',
+        help='Print solver counters and stage times (library built with make STATS=1)'
+    )
+    
     parser.add_argument(
         '--examples',
         action='store_true',
@@ -266,6 +922,12 @@ def main():
     if args.benchmark:
         return run_benchmark()
     
+    if args.stream:
+        return run_stream(args)
+    
+    if args.serve:
+        return run_serve(args)
+    
     if not args.input:
         parser.print_help()
         return 1
@@ -273,44 +935,65 @@ def main():
     try:
         # Initialize solver
         solver = KMapSolver()
+        if args.stats and solver.native is not None and solver.native.get_stats() is None:
+            # Counters live in the library only; solve there so they see this input
+            solver.native = None
+        if args.espresso:
+            solver.set_flags(KMAP_OPT_ESPRESSO)
+        if args.cache:
+            solver.open_cache(args.cache)
         
         # Measure performance
         start_time = time.time()
         
-        # Solve K-map
-        result = solver.solve(args.input)
+        # Solve K-map; the grid comes from the same solve
+        form = selected_form(args)
+        if args.visualize:
+            try:
+                kmap_viz, result = split_kmap(solver.solve(args.input, form=form | KMAP_FORM_MAP),
+                                              form)
+            except ValueError as e:
+                print(f"Visualization error: {e}")
+                print()
+                kmap_viz, result = None, solver.solve(args.input, form=form)
+        else:
+            kmap_viz, result = None, solver.solve(args.input, form=form)
         
         end_time = time.time()
         solve_time = (end_time - start_time) * 1000  # Convert to ms
         
         # Show visualization if requested
-        if args.visualize:
-            try:
-                kmap_viz = render_kmap_ascii(args.input)
-                print(kmap_viz)
-                print()
-            except Exception as e:
-                print(f"Visualization error: {e}")
-                print()
+        if kmap_viz is not None:
+            print(kmap_viz)
+            print()
         
         # Show result
-        print(f"Minimal Expression: {result}")
+        if args.both:
+            sop, pos = result.split('\n')
+            print(f"Minimal SOP: {sop}")
+            print(f"Minimal POS: {pos}")
+        else:
+            print(f"Minimal Expression: {result}")
+        
+        if args.stats:
+            print_stats(solver.get_stats())
         
         # Show explanation if requested
         if args.explain:
             print(f"\nSolution found in {solve_time:.3f}ms")
-            print(f"Input format: {'Minterm list' if ',' in args.input else 'Binary string'}")
-            
-            # Basic explanation
-            num_vars = len(args.input.replace(',', '').replace(' ', '')) 
-            if ',' not in args.input:
-                num_vars = 0
-                length = len(args.input.strip())
-                while (1 << num_vars) < length:
-                    num_vars += 1
             
-            print(f"Variables: {num_vars} ({'ABCDEFGH'[:num_vars]})")
-            print(f"Expression type: SOP (Sum of Products)")
+            # Format and variable count from the same C parser as the solve
+            input_format, num_vars = solver.describe_input(args.input)
+            print(f"Input format: {input_format}")
+            print(f"Variables: {num_vars} ({'ABCDEFGHIJKLMNOP'[:num_vars]})")
+            if args.both:
+                print("Expression type: SOP and POS")
+            elif args.pos:
+                print("Expression type: POS (Product of Sums)")
+            elif args.cheapest:
+                print("Expression type: POS or SOP, whichever is smaller")
+            else:
+                print("Expression type: SOP (Sum of Products)")
         
         return 0
         
@@ -324,9 +1007,98 @@ def main():
         print(f"Unexpected error: {e}", file=sys.stderr)
         return 3
 
+def print_stats(stats, file=sys.stdout):
+    """Print kmap_get_stats() counters as an aligned table"""
+    if stats is None:
+        print("\nStatistics not compiled in (rebuild with: make STATS=1 all pymodule)", file=file)
+        return
+    
+    print("\nSolver statistics:", file=file)
+    for name in ("solves", "cubes_examined", "primes_found", "cover_nodes",
+                 "cache_hits", "cache_misses"):
+        print(f"  {name:15} {stats[name]:>12}", file=file)
+    for name, stage in stats["stages"].items():
+        print(f"  {name + ' time':15} {stage['ns'] / 1000:>10.1f}us  ({stage['calls']} calls)",
+              file=file)
+
+def selected_form(args):
+    """KMAP_FORM_* value for the output-form flags"""
+    if args.both:
+        return KMAP_FORM_BOTH
+    if args.pos:
+        return KMAP_FORM_POS
+    if args.cheapest:
+        return KMAP_FORM_CHEAPEST
+    return KMAP_FORM_SOP
+
+def run_stream(args):
+    """Stream a whole file through the C core straight to stdout"""
+    try:
+        solver = KMapSolver()
+        if args.espresso:
+            solver.set_flags(KMAP_OPT_ESPRESSO)
+        if args.cache:
+            solver.open_cache(args.cache)
+        
+        sys.stdout.flush()
+        start_time = time.time()
+        # With -v every record is its grid, the expression and a blank line
+        form = selected_form(args) | (KMAP_FORM_MAP if args.visualize else 0)
+        stats = solver.stream_file(args.stream, sys.stdout.fileno(), form, args.records)
+        elapsed = time.time() - start_time
+        
+        if args.explain:
+            rate = stats.records / elapsed if elapsed > 0 else 0
+            print(f"{stats.records} records ({stats.failed} failed) in {elapsed:.3f}s "
+                  f"({rate:,.0f}/s), {stats.bytes_written} bytes written", file=sys.stderr)
+        if args.stats:
+            # Streaming always runs in the ctypes-loaded core, not the extension
+            solver.native = None
+            print_stats(solver.get_stats(), file=sys.stderr)
+        return 0
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    except RuntimeError as e:
+        print(f"Runtime Error: {e}", file=sys.stderr)
+        return 2
+
+def run_serve(args):
+    """Run the C solver daemon in the foreground until interrupted"""
+    try:
+        solver = KMapSolver()
+        if args.espresso:
+            solver.set_flags(KMAP_OPT_ESPRESSO)
+        if args.cache:
+            solver.open_cache(args.cache)
+        
+        print(f"Serving on {args.serve} (Ctrl-C to stop)", file=sys.stderr)
+        stats = solver.serve(args.serve, selected_form(args))
+        
+        if args.explain:
+            print(f"{stats.requests} requests ({stats.failed} failed) from "
+                  f"{stats.connections} connections in {stats.batches} batches", file=sys.stderr)
+        if args.stats:
+            # The daemon runs in the ctypes-loaded core, not the extension
+            solver.native = None
+            print_stats(solver.get_stats(), file=sys.stderr)
+        return 0
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    except RuntimeError as e:
+        print(f"Runtime Error: {e}", file=sys.stderr)
+        return 2
+
 def run_benchmark():
     """Run performance benchmark tests"""
+    # The C harness times each stage without FFI overhead (make performance)
+    bench = Path("./build/kmap_bench")
+    if bench.exists():
+        return os.spawnv(os.P_WAIT, str(bench), [str(bench)])
+    
     print("K-Map Solver Performance Benchmark")
+    print("(build/kmap_bench not built; timings include ctypes overhead)")
     print("=" * 40)
     
     try:
@@ -345,9 +1117,9 @@ def run_benchmark():
             
             # Run each test multiple times for accuracy
             for _ in range(100):
-                start = time.time()
+                start = time.perf_counter()
                 result = solver.solve(test_input)
-                end = time.time()
+                end = time.perf_counter()
                 times.append((end - start) * 1000)  # Convert to ms
             
             avg_time = sum(times) / len(times)
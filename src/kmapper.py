@@ -1,334 +0,0 @@
-#!/usr/bin/env python3
-"""
-K-Map Solver - Terminal-Based Karnaugh Map Simplification Tool
-
-A minimal, fast K-map solver that processes truth tables and generates
-simplified Boolean expressions using an optimized C core engine.
-
-Usage:
-    ./kmapper "1010"                    # Binary string input
-    ./kmapper "0,1,3"                   # Minterm list input  
-    ./kmapper -v "11110000"             # With K-map visualization
-    ./kmapper -p "1010"                 # Generate POS instead of SOP
-    ./kmapper -e "1010"                 # Educational mode with explanations
-
-Performance: <10ms for 6-variable maps, <1ms for 4-variable maps
-Size: <100KB total, minimal dependencies
-"""
-
-import ctypes
-import sys
-import os
-import argparse
-import time
-from pathlib import Path
-
-class KMapSolver:
-    """Lightweight Python interface to high-performance C K-map solver"""
-    
-    def __init__(self):
-        """Initialize the solver and load C library"""
-        self.lib = None
-        self._load_library()
-        self._setup_function_signatures()
-    
-    def _load_library(self):
-        """Load the compiled C library"""
-        # Try different possible library locations
-        possible_paths = [
-            "./build/kmap_core.so",           # Production build
-            "./build/libkmap_core_debug.so",  # Debug build
-            "./kmap_core.so",                 # Current directory
-            "/usr/local/lib/kmap_core.so"     # System install
-        ]
-        
-        for lib_path in possible_paths:
-            if os.path.exists(lib_path):
-                try:
-                    self.lib = ctypes.CDLL(lib_path)
-                    return
-                except OSError as e:
-                    continue
-        
-        # If we get here, no library was found
-        raise RuntimeError(
-            "Could not load K-map solver library. "
-            "Please run 'make' to build the library first."
-        )
-    
-    def _setup_function_signatures(self):
-        """Define C function signatures for type safety"""
-        # int solve_kmap(const char* input, char* output, int output_len)
-        self.lib.solve_kmap.argtypes = [
-            ctypes.c_char_p,  # input string
-            ctypes.c_char_p,  # output buffer
-            ctypes.c_int      # buffer size
-        ]
-        self.lib.solve_kmap.restype = ctypes.c_int
-    
-    def solve(self, input_str, max_output_len=1024):
-        """
-        Solve K-map and return simplified Boolean expression
-        
-        Args:
-            input_str: Truth table as binary string or minterm list
-            max_output_len: Maximum length of output expression
-            
-        Returns:
-            str: Simplified Boolean expression (SOP form)
-            
-        Raises:
-            ValueError: If input is invalid or solving fails
-            RuntimeError: If library call fails
-        """
-        if not isinstance(input_str, str):
-            raise ValueError("Input must be a string")
-        
-        if not input_str.strip():
-            raise ValueError("Input cannot be empty")
-        
-        # Create output buffer
-        output_buffer = ctypes.create_string_buffer(max_output_len)
-        
-        # Call C function
-        result = self.lib.solve_kmap(
-            input_str.encode('utf-8'),
-            output_buffer,
-            max_output_len
-        )
-        
-        # Check for errors
-        if result != 0:
-            error_messages = {
-                -1: "Invalid input format",
-                -2: "Invalid truth table structure", 
-                -3: "Output buffer too small",
-                -4: "Solving algorithm failed"
-            }
-            error_msg = error_messages.get(result, f"Unknown error (code {result})")
-            raise ValueError(f"K-map solving failed: {error_msg}")
-        
-        return output_buffer.value.decode('utf-8')
-
-def render_kmap_ascii(input_str, num_vars=None):
-    """
-    Render ASCII K-map visualization
-    
-    Args:
-        input_str: Truth table input
-        num_vars: Number of variables (auto-detected if None)
-    
-    Returns:
-        str: ASCII representation of K-map
-    """
-    # Auto-detect number of variables
-    if num_vars is None:
-        if ',' in input_str:
-            # Minterm list - find max value
-            try:
-                minterms = [int(x.strip()) for x in input_str.split(',')]
-                max_minterm = max(minterms)
-                num_vars = 2
-                while (1 << num_vars) <= max_minterm:
-                    num_vars += 1
-            except ValueError:
-                return "Error: Invalid minterm list format"
-        else:
-            # Binary string
-            length = len(input_str.strip())
-            num_vars = 0
-            while (1 << num_vars) < length:
-                num_vars += 1
-    
-    if num_vars > 4:
-        return f"ASCII visualization not supported for {num_vars} variables (>4)"
-    
-    # Parse input to truth table
-    if ',' in input_str:
-        # Convert minterm list to binary string
-        minterms = [int(x.strip()) for x in input_str.split(',')]
-        truth_table = ['0'] * (1 << num_vars)
-        for m in minterms:
-            if 0 <= m < len(truth_table):
-                truth_table[m] = '1'
-        binary_str = ''.join(truth_table)
-    else:
-        binary_str = input_str.strip()
-    
-    # Generate ASCII K-map
-    output = [f"K-Map for {num_vars} variables:"]
-    
-    if num_vars == 2:
-        # 2x2 grid
-        output.append("   00 01 11 10")
-        output.append("0 │ " + "  ".join([binary_str[0], binary_str[1], binary_str[3], binary_str[2]]))
-        
-    elif num_vars == 3:
-        # 2x4 grid  
-        output.append("    00 01 11 10")
-        row0 = [binary_str[0], binary_str[1], binary_str[3], binary_str[2]]
-        row1 = [binary_str[4], binary_str[5], binary_str[7], binary_str[6]]
-        output.append(" 0 │ " + "  ".join(row0))
-        output.append(" 1 │ " + "  ".join(row1))
-        
-    elif num_vars == 4:
-        # 4x4 grid
-        output.append("    00 01 11 10")
-        gray_order = [0, 1, 3, 2]
-        for row in range(4):
-            row_cells = []
-            for col in range(4):
-                idx = gray_order[row] * 4 + gray_order[col]
-                row_cells.append(binary_str[idx] if idx < len(binary_str) else '0')
-            output.append(f"{gray_order[row]:02b} │ " + "  ".join(row_cells))
-    
-    return "\n".join(output)
-
-def main():
-    """Main entry point for command-line interface"""
-    parser = argparse.ArgumentParser(
-        description='Fast terminal-based Karnaugh Map solver',
-        epilog='Examples: ./kmapper "1010" or ./kmapper -v "0,1,3"'
-    )
-    
-    parser.add_argument(
-        'input',
-        help='Truth table (binary string or minterm list)',
-        nargs='?'
-    )
-    
-    parser.add_argument(
-        '-v', '--visualize',
-        action='store_true',
-        help='Show ASCII K-map visualization'
-    )
-    
-    parser.add_argument(
-        '-e', '--explain', 
-        action='store_true',
-        help='Show step-by-step explanation'
-    )
-    
-    parser.add_argument(
-        '--examples',
-        action='store_true',
-        help='Show usage examples and exit'
-    )
-    
-    parser.add_argument(
-        '--benchmark',
-        action='store_true',
-        help='Run performance benchmark'
-    )
-    
-    args = parser.parse_args()
-    
-    # Handle special modes
-    if args.examples:
-        print_usage_examples()
-        return 0
-    
-    if args.benchmark:
-        return run_benchmark()
-    
-    if not args.input:
-        parser.print_help()
-        return 1
-    
-    try:
-        # Initialize solver
-        solver = KMapSolver()
-        
-        # Measure performance
-        start_time = time.time()
-        
-        # Solve K-map
-        result = solver.solve(args.input)
-        
-        end_time = time.time()
-        solve_time = (end_time - start_time) * 1000  # Convert to ms
-        
-        # Show visualization if requested
-        if args.visualize:
-            try:
-                kmap_viz = render_kmap_ascii(args.input)
-                print(kmap_viz)
-                print()
-            except Exception as e:
-                print(f"Visualization error: {e}")
-                print()
-        
-        # Show result
-        print(f"Minimal Expression: {result}")
-        
-        # Show explanation if requested
-        if args.explain:
-            print(f"\nSolution found in {solve_time:.3f}ms")
-            print(f"Input format: {'Minterm list' if ',' in args.input else 'Binary string'}")
-            
-            # Basic explanation
-            num_vars = len(args.input.replace(',', '').replace(' ', '')) 
-            if ',' not in args.input:
-                num_vars = 0
-                length = len(args.input.strip())
-                while (1 << num_vars) < length:
-                    num_vars += 1
-            
-            print(f"Variables: {num_vars} ({'ABCDEFGH'[:num_vars]})")
-            print(f"Expression type: SOP (Sum of Products)")
-        
-        return 0
-        
-    except ValueError as e:
-        print(f"Error: {e}", file=sys.stderr)
-        return 1
-    except RuntimeError as e:
-        print(f"Runtime Error: {e}", file=sys.stderr)
-        return 2
-    except Exception as e:
-        print(f"Unexpected error: {e}", file=sys.stderr)
-        return 3
-
-def run_benchmark():
-    """Run performance benchmark tests"""
-    print("K-Map Solver Performance Benchmark")
-    print("=" * 40)
-    
-    try:
-        solver = KMapSolver()
-        
-        test_cases = [
-            ("2 vars", "1010"),
-            ("3 vars", "10110100"), 
-            ("4 vars", "1111000011110000"),
-            ("3 vars (minterm)", "0,1,3,5"),
-            ("4 vars (complex)", "0,1,2,3,8,9,10,11")
-        ]
-        
-        for name, test_input in test_cases:
-            times = []
-            
-            # Run each test multiple times for accuracy
-            for _ in range(100):
-                start = time.time()
-                result = solver.solve(test_input)
-                end = time.time()
-                times.append((end - start) * 1000)  # Convert to ms
-            
-            avg_time = sum(times) / len(times)
-            min_time = min(times)
-            max_time = max(times)
-            
-            print(f"{name:15} | {avg_time:6.3f}ms avg | {min_time:6.3f}ms min | {max_time:6.3f}ms max")
-            print(f"{'':15} | Result: {result}")
-            print()
-        
-        print("Benchmark completed successfully!")
-        return 0
-        
-    except Exception as e:
-        print(f"Benchmark failed: {e}", file=sys.stderr)
-        return 1
-
-if __name__ == '__main__':
-    sys.exit(main())
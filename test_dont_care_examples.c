@@ -1,4 +1,4 @@
-#include "src/kmap_core.h"
+#include "kmap_core.h"
 #include <stdio.h>
 #include <string.h>
 
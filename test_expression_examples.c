@@ -0,0 +1,223 @@
+#include "kmap_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Boolean expression input checked against C itself: each expression is
+ * also compiled as C over the variable masks below, and C's precedence
+ * (~ over & over ^ over |) is the one the parser implements. Operator
+ * spellings C lacks, don't care lists, the nesting limit and the wide
+ * fallback are checked separately.
+ */
+
+/* Variable masks over 64 cells; the low 2^n bits are the n-variable table */
+static const uint64_t A = 0xAAAAAAAAAAAAAAAAULL;
+static const uint64_t B = 0xCCCCCCCCCCCCCCCCULL;
+static const uint64_t C = 0xF0F0F0F0F0F0F0F0ULL;
+static const uint64_t D = 0xFF00FF00FF00FF00ULL;
+static const uint64_t E = 0xFFFF0000FFFF0000ULL;
+static const uint64_t F = 0xFFFFFFFF00000000ULL;
+
+/* The unparenthesized mixes below are the point: they pin the precedence */
+#pragma GCC diagnostic ignored "-Wparentheses"
+
+#define CELLS(n) ((n) == 6 ? ~0ULL : (1ULL << (1U << (n))) - 1)
+
+/* The same text read by the parser and compiled by the C compiler */
+#define SAME_AS_C(n, expr) {#expr, n, (expr) & CELLS(n)}
+
+/* A spelling C has no operator for, with its meaning in C */
+#define SPELLED(text, n, expr) {text, n, (expr) & CELLS(n)}
+
+static const struct {
+    const char* input;
+    uint8_t num_vars;                           // Highest variable used, at least 2
+    uint64_t minterms;
+} expressions[] = {
+    SAME_AS_C(2, A),
+    SAME_AS_C(2, ~A),
+    SAME_AS_C(2, ~~A),
+    SAME_AS_C(4, D),
+    SAME_AS_C(6, F),
+    SAME_AS_C(2, A & B),
+    SAME_AS_C(2, A | B),
+    SAME_AS_C(2, A ^ B),
+    SAME_AS_C(2, ~(A & B)),
+    SAME_AS_C(2, ~A & B),
+    SAME_AS_C(3, A | B & C),
+    SAME_AS_C(3, A ^ B & C),
+    SAME_AS_C(3, A | B ^ C),
+    SAME_AS_C(3, A & B ^ C),
+    SAME_AS_C(3, (A | B) & C),
+    SAME_AS_C(3, A & ~B | C),
+    SAME_AS_C(4, A ^ B ^ C ^ D),
+    SAME_AS_C(5, ~(A | ~B) ^ (C & ~D | E)),
+    SAME_AS_C(6, A & B & C & D & E & F | ~A & ~F),
+    
+    /* Negation, AND and OR as the textbooks write them */
+    SPELLED("!A", 2, ~A),
+    SPELLED("A'", 2, ~A),
+    SPELLED("A''", 2, A),
+    SPELLED("(A+B)'", 2, ~(A | B)),
+    SPELLED("A*B", 2, A & B),
+    SPELLED("A.B", 2, A & B),
+    SPELLED("A+B", 2, A | B),
+    SPELLED("A'B", 2, ~A & B),
+    
+    /* Juxtaposition is AND before a letter, '(', '~' or '!' */
+    SPELLED("AB", 2, A & B),
+    SPELLED("A B", 2, A & B),
+    SPELLED("A(B)", 2, A & B),
+    SPELLED("A~B", 2, A & ~B),
+    SPELLED("A!B", 2, A & ~B),
+    SPELLED("AB + ~CD", 4, A & B | ~C & D),
+    SPELLED("AB^CD", 4, A & B ^ C & D),
+    
+    /* Constants take the smallest table */
+    SPELLED("0", 2, 0),
+    SPELLED("1", 2, ~0ULL),
+    SPELLED("A&1", 2, A),
+    SPELLED("A|0", 2, A),
+    SPELLED("~0&C", 3, C),
+};
+
+/* Neither cells, a list nor an expression */
+static const char* const rejected[] = {
+    "", "101", "1X", "A&", "(A", "A)", "A|", "&A", "()", "Q", "a", "A d(", "A d()",
+    "A d(1,)", "A d(1) B", "A B +", "A^", "A''B'+", "A d(1) d(2)",
+};
+
+/**
+ * @brief Parse "(((A)))" or "~~~A" nested depth times
+ * @return parse_input_n result; 1 if it parsed to the wrong table
+ */
+static int parse_nested(char open, char close, size_t depth) {
+    char* input = malloc(2 * depth + 1);
+    size_t len = depth;
+    
+    memset(input, open, depth);
+    input[len++] = 'A';
+    if (close) {
+        memset(input + len, close, depth);
+        len += depth;
+    }
+    
+    truth_table_t tt;
+    int result = parse_input_n(input, len, &tt);
+    free(input);
+    
+    uint64_t expected = (close || depth % 2 == 0) ? 0xA : 0x5;
+    return (result == 0 && tt.minterms != expected) ? 1 : result;
+}
+
+/**
+ * @brief Nesting, don't cares, wide tables and inputs that must stay cells
+ * @return Number of wrong results
+ */
+static int check_edges(void) {
+    int wrong = 0;
+    truth_table_t tt;
+    kmap_wide_table_t wide;
+    
+    /* A trailing d(...) list; its highest cell can widen the table */
+    wrong += parse_input_n("A d(3)", SIZE_MAX, &tt) != 0 || tt.minterms != 0x2 ||
+             tt.dont_cares != 0x8;
+    wrong += parse_input_n("A d(0, 3)", SIZE_MAX, &tt) != 0 || tt.dont_cares != 0x9;
+    wrong += parse_input_n("A d(4)", SIZE_MAX, &tt) != 0 || tt.num_vars != 3 ||
+             tt.minterms != 0xAA;
+    wrong += parse_input_n("~0 d(63)", SIZE_MAX, &tt) != 0 ||
+             tt.minterms != 0x7FFFFFFFFFFFFFFFULL || tt.dont_cares != 0x8000000000000000ULL;
+    
+    /* Unlike a list, a don't care may land on a cell the expression sets */
+    wrong += parse_input_n("A d(1)", SIZE_MAX, &tt) != 0 || tt.minterms != 0x8 ||
+             tt.dont_cares != 0x2;
+    
+    /* 32 levels parse; 65 or more are refused instead of recursing on */
+    wrong += parse_nested('(', ')', 32) != 0;
+    wrong += parse_nested('(', ')', 65) != -1;
+    wrong += parse_nested('(', ')', 1000) != -1;
+    wrong += parse_nested('~', 0, 32) != 0;
+    wrong += parse_nested('~', 0, 65) != -1;
+    wrong += parse_nested('~', 0, 1000) != -1;
+    
+    /* Past F, or past cell 63 in d(...), only the wide parser takes it */
+    wrong += parse_input_n("A d(200)", SIZE_MAX, &tt) != -1;
+    if (parse_input_wide("A d(200)", SIZE_MAX, &wide) == 0) {
+        wrong += wide.num_vars != 8 || wide.minterms[3] != A ||
+                 wide.dont_cares[3] != 1ULL << (200 % 64) || wide.dont_cares[0] != 0;
+        kmap_wide_table_free(&wide);
+    } else {
+        wrong++;
+    }
+    
+    /* G selects odd words, P the upper half of a 16-variable table */
+    if (parse_input_wide("G&A", SIZE_MAX, &wide) == 0) {
+        wrong += wide.num_vars != 7 || wide.minterms[0] != 0 || wide.minterms[1] != A;
+        kmap_wide_table_free(&wide);
+    } else {
+        wrong++;
+    }
+    if (parse_input_wide("P", SIZE_MAX, &wide) == 0) {
+        size_t words = kmap_wide_words(16);
+        wrong += wide.num_vars != 16 || wide.minterms[words / 2 - 1] != 0 ||
+                 wide.minterms[words / 2] != ~0ULL || wide.minterms[words - 1] != ~0ULL;
+        kmap_wide_table_free(&wide);
+    } else {
+        wrong++;
+    }
+    
+    /* Binary strings and lists still win over the expression reading */
+    wrong += parse_input_n("1010", SIZE_MAX, &tt) != 0 || tt.minterms != 0xA;
+    wrong += parse_input_n("1 d(63)", SIZE_MAX, &tt) != 0 || tt.minterms != 0x2;
+    
+    /* End to end */
+    char output[256];
+    wrong += solve_kmap("A&~B | C", output, sizeof(output)) != 0 ||
+             strcmp(output, "C + A&~B") != 0;
+    
+    return wrong;
+}
+
+int main() {
+    printf("Testing Boolean Expression Input\n");
+    printf("================================\n");
+    
+    int wrong = 0;
+    size_t count = sizeof(expressions) / sizeof(expressions[0]);
+    for (size_t i = 0; i < count; i++) {
+        truth_table_t tt;
+        int result = parse_input_n(expressions[i].input, SIZE_MAX, &tt);
+        
+        if (result != 0 || tt.num_vars != expressions[i].num_vars ||
+            tt.minterms != expressions[i].minterms || tt.dont_cares != 0) {
+            printf("  %-32s -> %d, %u vars, 0x%llx (C says 0x%llx)\n", expressions[i].input,
+                   result, tt.num_vars, (unsigned long long)tt.minterms,
+                   (unsigned long long)expressions[i].minterms);
+            wrong++;
+        }
+    }
+    printf("%zu expressions compared with C\n", count);
+    
+    size_t rejected_count = sizeof(rejected) / sizeof(rejected[0]);
+    for (size_t i = 0; i < rejected_count; i++) {
+        truth_table_t tt;
+        kmap_wide_table_t wide;
+        int narrow = parse_input_n(rejected[i], SIZE_MAX, &tt);
+        int wide_result = parse_input_wide(rejected[i], SIZE_MAX, &wide);
+        
+        if (narrow != -1 || wide_result != -1) {
+            printf("  \"%s\" accepted (%d, wide %d)\n", rejected[i], narrow, wide_result);
+            if (wide_result == 0) kmap_wide_table_free(&wide);
+            wrong++;
+        }
+    }
+    printf("%zu malformed inputs rejected\n", rejected_count);
+    
+    int edges = check_edges();
+    printf("edge cases: %d wrong\n", edges);
+    wrong += edges;
+    
+    printf("\n%s\n", wrong ? "EXPRESSION TEST FAILED" : "Parser agrees with C");
+    return wrong ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+#include "kmap_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Packed solution records: solved tables survive a round trip, the
+ * encoders emit known bytes and honour the (out, out_len) sizing
+ * contract, and unpack_solution refuses every corrupt record it meets
+ */
+
+/**
+ * @brief Decode space-separated hex bytes ("82 01 01 01") into out
+ * @return Number of bytes
+ */
+static size_t hex_bytes(const char* hex, uint8_t* out) {
+    size_t n = 0;
+    char* end;
+    
+    for (unsigned long byte = strtoul(hex, &end, 16); end != hex;
+         byte = strtoul(hex, &end, 16)) {
+        out[n++] = (uint8_t)byte;
+        hex = end;
+    }
+    return n;
+}
+
+/**
+ * @brief Solve, pack, unpack, and compare the decoded terms
+ * @return 1 if the record did not reproduce the solution
+ */
+static int round_trip(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars) {
+    truth_table_t tt;
+    solution_t solution, decoded;
+    uint8_t record[256], vars = 0;
+    
+    if (init_truth_table(minterms, dont_cares, num_vars, &tt) != 0 ||
+        find_prime_implicants(&tt, &solution) != 0) {
+        return 1;
+    }
+    
+    int size = pack_solution(&solution, num_vars, record, sizeof(record));
+    if (size <= 0 || pack_solution(&solution, num_vars, NULL, 0) != size) return 1;
+    if (unpack_solution(record, (size_t)size, &decoded, &vars) != size || vars != num_vars) {
+        return 1;
+    }
+    
+    if (decoded.implicant_count != solution.implicant_count ||
+        decoded.literal_count != solution.literal_count || decoded.optimal != solution.optimal) {
+        return 1;
+    }
+    
+    /* The record has no table, but its terms still cover exactly the 1s */
+    uint64_t covered = 0;
+    for (int i = 0; i < decoded.implicant_count; i++) {
+        if (decoded.implicants[i].literal_mask != solution.implicants[i].literal_mask ||
+            decoded.implicants[i].literal_values != solution.implicants[i].literal_values) {
+            return 1;
+        }
+        covered |= decoded.implicants[i].covered_minterms;
+    }
+    return (covered & ~dont_cares) != minterms;
+}
+
+static int suite_round_trip(void) {
+    int failed = 0;
+    
+    /* Every 3-variable function, then random 4-6 variable tables with don't cares */
+    for (uint64_t f = 0; f < 256; f++) failed += round_trip(f, 0, 3);
+    
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < 300; i++) {
+        uint8_t num_vars = (uint8_t)(4 + i % 3);
+        uint64_t all = num_vars == 6 ? ~0ULL : (1ULL << (1U << num_vars)) - 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t dont_cares = state & (state >> 3) & (state >> 5) & all;
+        failed += round_trip(state & ~dont_cares & all, dont_cares, num_vars);
+    }
+    
+    /* Records laid back to back: each unpack takes exactly its own bytes */
+    truth_table_t tt;
+    solution_t first, second, decoded;
+    uint8_t stream[128];
+    init_truth_table(0x6996, 0, 4, &tt);
+    find_prime_implicants(&tt, &first);
+    init_truth_table(0xA, 0, 2, &tt);
+    find_prime_implicants(&tt, &second);
+    
+    int a = pack_solution(&first, 4, stream, sizeof(stream));
+    int b = pack_solution(&second, 2, stream + a, sizeof(stream) - (size_t)a);
+    if (unpack_solution(stream, (size_t)(a + b), &decoded, NULL) != a ||
+        decoded.implicant_count != first.implicant_count ||
+        unpack_solution(stream + a, (size_t)b, &decoded, NULL) != b ||
+        decoded.implicant_count != second.implicant_count) {
+        failed++;
+    }
+    
+    return failed;
+}
+
+static int suite_exact_bytes(void) {
+    int failed = 0;
+    uint8_t record[16], expected[16];
+    
+    /* A: optimal flag on num_vars, one term, mask 1, value 1 */
+    truth_table_t tt;
+    solution_t solution;
+    init_truth_table(0xA, 0, 2, &tt);
+    find_prime_implicants(&tt, &solution);
+    size_t n = hex_bytes("82 01 01 01", expected);
+    if (pack_solution(&solution, 2, record, sizeof(record)) != (int)n ||
+        memcmp(record, expected, n) != 0) {
+        failed++;
+    }
+    
+    /* A&H over 8 variables: mask and values of 0x81 take two bytes each */
+    kmap_cube_t cube = {0x81, 0x81};
+    kmap_cover_t cover = {&cube, 1, 2, true};
+    n = hex_bytes("88 01 81 01 81 01", expected);
+    if (pack_cover(&cover, 8, record, sizeof(record)) != (int)n ||
+        memcmp(record, expected, n) != 0) {
+        failed++;
+    }
+    
+    /* Same format, but unpack_solution stops at 6 variables */
+    if (unpack_solution(record, n, &solution, NULL) != -2) failed++;
+    
+    /* A 6-variable wide cover decodes as a narrow solution */
+    kmap_cube_t cubes[2] = {{0x21, 0x01}, {0x06, 0x04}};
+    kmap_cover_t narrow = {cubes, 2, 4, false};
+    uint8_t vars = 0;
+    int size = pack_cover(&narrow, 6, record, sizeof(record));
+    if (unpack_solution(record, (size_t)size, &solution, &vars) != size || vars != 6 ||
+        solution.implicant_count != 2 || solution.optimal || solution.literal_count != 4 ||
+        solution.implicants[1].literal_mask != 0x06 ||
+        solution.implicants[1].literal_values != 0x04) {
+        failed++;
+    }
+    
+    return failed;
+}
+
+static int suite_short_buffers(void) {
+    int failed = 0;
+    uint8_t full[256], record[256];
+    
+    /* 6-variable parity: 32 terms, the largest narrow record */
+    truth_table_t tt;
+    solution_t solution;
+    init_truth_table(0x6996966996696996ULL, 0, 6, &tt);
+    find_prime_implicants(&tt, &solution);
+    int size = pack_solution(&solution, 6, full, sizeof(full));
+    
+    kmap_cube_t cubes[3] = {{0x81, 0x80}, {0x0300, 0x0100}, {0x0001, 0x0000}};
+    kmap_cover_t cover = {cubes, 3, 5, true};
+    int wide_size = pack_cover(&cover, 10, NULL, 0);
+    
+    /* Each shorter buffer gets the prefix that fits and the full size back */
+    for (int out_len = 0; out_len <= size; out_len++) {
+        memset(record, 0xEE, sizeof(record));
+        int result = pack_solution(&solution, 6, record, (size_t)out_len);
+        if (result != size || memcmp(record, full, (size_t)out_len) != 0 ||
+            record[out_len] != 0xEE) {
+            printf("  pack_solution out_len %d -> %d\n", out_len, result);
+            failed++;
+        }
+    }
+    
+    pack_cover(&cover, 10, full, sizeof(full));
+    for (int out_len = 0; out_len <= wide_size; out_len++) {
+        memset(record, 0xEE, sizeof(record));
+        int result = pack_cover(&cover, 10, record, (size_t)out_len);
+        if (result != wide_size || memcmp(record, full, (size_t)out_len) != 0 ||
+            record[out_len] != 0xEE) {
+            printf("  pack_cover out_len %d -> %d\n", out_len, result);
+            failed++;
+        }
+    }
+    
+    /* Encoder argument checks */
+    if (pack_solution(&solution, 7, record, sizeof(record)) != -2 ||
+        pack_solution(NULL, 6, record, sizeof(record)) != -1 ||
+        pack_solution(&solution, 6, NULL, 4) != -1) {
+        failed++;
+    }
+    
+    return failed;
+}
+
+static int suite_corrupt_records(void) {
+    static const struct {
+        const char* hex;
+        int result;
+        const char* why;
+    } corpus[] = {
+        {"82 01 01 01",             4, "A"},
+        {"02 00",                   2, "no terms"},
+        {"07 00",                  -2, "7 variables"},
+        {"02",                     -2, "count missing"},
+        {"02 81",                  -2, "count cut mid-varint"},
+        {"02 01 01",               -2, "values missing"},
+        {"02 02 01 01",            -2, "second term missing"},
+        {"02 80 00",               -2, "count ends in a zero group"},
+        {"02 01 81 00 01",         -2, "mask ends in a zero group"},
+        {"02 FF FF FF FF 1F",      -2, "count past 32 bits"},
+        {"02 80 80 80 80 80 01",   -2, "count six bytes long"},
+        {"02 21",                  -3, "33 terms"},
+        {"02 80 80 80 80 01",      -3, "2^28 terms"},
+        {"02 01 01 03",            -2, "values outside mask"},
+        {"02 01 04 00",            -2, "mask past num_vars"},
+    };
+    int failed = 0;
+    uint8_t bytes[16];
+    solution_t solution;
+    
+    for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+        size_t n = hex_bytes(corpus[i].hex, bytes);
+        int result = unpack_solution(bytes, n, &solution, NULL);
+        if (result != corpus[i].result) {
+            printf("  %-26s [%s] -> %d, expected %d\n", corpus[i].why, corpus[i].hex, result,
+                   corpus[i].result);
+            failed++;
+        }
+    }
+    if (unpack_solution(bytes, 0, &solution, NULL) != -1) failed++;
+    
+    /* Every proper prefix of a real record is truncated */
+    truth_table_t tt;
+    uint8_t record[256];
+    init_truth_table(0x0000FFFF0000F0F0ULL, 0x0F00000000000000ULL, 6, &tt);
+    find_prime_implicants(&tt, &solution);
+    int size = pack_solution(&solution, 6, record, sizeof(record));
+    for (int len = 1; len < size; len++) {
+        solution_t decoded;
+        if (unpack_solution(record, (size_t)len, &decoded, NULL) != -2) {
+            printf("  %d-byte prefix of a %d-byte record accepted\n", len, size);
+            failed++;
+        }
+    }
+    
+    return failed;
+}
+
+int main() {
+    static const struct {
+        const char* name;
+        int (*run)(void);
+    } suites[] = {
+        {"round trips", suite_round_trip},
+        {"exact bytes", suite_exact_bytes},
+        {"short buffers", suite_short_buffers},
+        {"corrupt records", suite_corrupt_records},
+    };
+    
+    printf("Testing Packed Solution Records\n");
+    printf("===============================\n");
+    
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++) {
+        int suite_failed = suites[i].run();
+        printf("%-16s %s\n", suites[i].name, suite_failed ? "FAILED" : "ok");
+        failed += suite_failed;
+    }
+    
+    printf("\n%d check(s) failed\n", failed);
+    return failed ? 1 : 0;
+}
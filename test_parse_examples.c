@@ -0,0 +1,239 @@
+#include "kmap_core.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Edge cases of the single-pass cell parser: binary strings, minterm
+ * lists with d(...) sections, (ptr, len) views and overlapping cells.
+ * Every table the narrow parser accepts must read the same wide.
+ */
+
+/**
+ * @brief Parse input[0..len) and compare with the expected table
+ * @return 1 on mismatch, 0 otherwise
+ */
+static int expect_parse(const char* input, size_t len, int result, uint8_t num_vars,
+                        uint64_t minterms, uint64_t dont_cares) {
+    truth_table_t tt;
+    int got = parse_input_n(input, len, &tt);
+    
+    if (got != result) {
+        printf("  \"%s\": returned %d, expected %d\n", input, got, result);
+        return 1;
+    }
+    if (result != 0) return 0;
+    
+    if (tt.num_vars != num_vars || tt.minterms != minterms || tt.dont_cares != dont_cares ||
+        tt.minterm_count != popcount(minterms)) {
+        printf("  \"%s\": got %u vars, m 0x%llx, d 0x%llx\n", input, tt.num_vars,
+               (unsigned long long)tt.minterms, (unsigned long long)tt.dont_cares);
+        return 1;
+    }
+    
+    /* The wide parser reads the same cells into word 0, but refuses an overlap */
+    kmap_wide_table_t wide;
+    int wide_result = parse_input_wide(input, len, &wide);
+    int wide_expected = (minterms & dont_cares) ? -2 : 0;
+    if (wide_result != wide_expected) {
+        printf("  \"%s\": wide returned %d, expected %d\n", input, wide_result, wide_expected);
+        if (wide_result == 0) kmap_wide_table_free(&wide);
+        return 1;
+    }
+    if (wide_result != 0) return 0;
+    
+    int same = wide.num_vars == num_vars && wide.minterms[0] == minterms &&
+               wide.dont_cares[0] == dont_cares;
+    kmap_wide_table_free(&wide);
+    if (!same) {
+        printf("  \"%s\": wide table differs\n", input);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parse input with the wide parser only
+ * @return 1 if the result, size or the bit for cell is not as expected
+ */
+static int expect_wide(const char* input, int result, uint8_t num_vars, uint32_t cell,
+                       bool dont_care) {
+    kmap_wide_table_t wide;
+    int got = parse_input_wide(input, SIZE_MAX, &wide);
+    
+    if (got != result) {
+        printf("  \"%s\": wide returned %d, expected %d\n", input, got, result);
+        if (got == 0) kmap_wide_table_free(&wide);
+        return 1;
+    }
+    if (result != 0) return 0;
+    
+    const uint64_t* bits = dont_care ? wide.dont_cares : wide.minterms;
+    int ok = wide.num_vars == num_vars && (bits[cell / 64] >> (cell % 64) & 1);
+    if (!ok) printf("  \"%s\": %u variables, cell %u not set\n", input, wide.num_vars, cell);
+    kmap_wide_table_free(&wide);
+    return !ok;
+}
+
+static int test_binary_strings() {
+    printf("\n=== Binary strings: first character is the highest cell ===\n");
+    int failed = 0;
+    
+    failed += expect_parse("1010", SIZE_MAX, 0, 2, 0xA, 0);
+    failed += expect_parse("10X1", SIZE_MAX, 0, 2, 0x9, 0x2);
+    failed += expect_parse("1x-0", SIZE_MAX, 0, 2, 0x8, 0x6);
+    failed += expect_parse("  1010  ", SIZE_MAX, 0, 2, 0xA, 0);
+    failed += expect_parse("1111111111111111111111111111111X", SIZE_MAX, 0, 5,
+                           0xFFFFFFFE, 0x1);
+    
+    /* Lengths that are not a power of two, or outside 4..64 cells */
+    failed += expect_parse("101", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("10", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("00000", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("10 10", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1021", SIZE_MAX, -1, 0, 0, 0);
+    
+    char cells[130];
+    memset(cells, '0', 128);
+    cells[0] = 'X';
+    cells[63] = '1';
+    cells[64] = '\0';
+    failed += expect_parse(cells, SIZE_MAX, 0, 6, 0x1, 0x8000000000000000ULL);
+    cells[64] = '0';
+    cells[128] = '\0';
+    failed += expect_parse(cells, SIZE_MAX, -1, 0, 0, 0);
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_minterm_lists() {
+    printf("\n=== Minterm lists ===\n");
+    int failed = 0;
+    
+    failed += expect_parse("0,1,3", SIZE_MAX, 0, 2, 0xB, 0);
+    failed += expect_parse("1, 2", SIZE_MAX, 0, 2, 0x6, 0);
+    failed += expect_parse("0,63", SIZE_MAX, 0, 6, 0x8000000000000001ULL, 0);
+    failed += expect_parse("4,", SIZE_MAX, 0, 3, 0x10, 0);
+    
+    /* Duplicates collapse into one cell and count once */
+    failed += expect_parse("1,1,2", SIZE_MAX, 0, 2, 0x6, 0);
+    
+    /* Empty entries are skipped, as the old strtok parser did */
+    failed += expect_parse("1,,2", SIZE_MAX, 0, 2, 0x6, 0);
+    failed += expect_parse(",1", SIZE_MAX, 0, 2, 0x2, 0);
+    
+    /* Cells past 63, numbers without a comma, stray characters */
+    failed += expect_parse("1,64", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1,99999999999", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1 2", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1,2)", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1;2", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("   ", SIZE_MAX, -1, 0, 0, 0);
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_dont_care_sections() {
+    printf("\n=== d(...) sections ===\n");
+    int failed = 0;
+    
+    failed += expect_parse("1,2,5 d(0,4,6)", SIZE_MAX, 0, 3, 0x26, 0x51);
+    failed += expect_parse("3 D(1)", SIZE_MAX, 0, 2, 0x8, 0x2);
+    failed += expect_parse("1 d(3,3)", SIZE_MAX, 0, 2, 0x2, 0x8);
+    
+    /* The highest don't care sizes the table too */
+    failed += expect_parse("1 d(9)", SIZE_MAX, 0, 4, 0x2, 0x200);
+    
+    /* An empty section, and a list that is only don't cares */
+    failed += expect_parse("1 d()", SIZE_MAX, 0, 2, 0x2, 0);
+    failed += expect_parse("d()", SIZE_MAX, 0, 2, 0, 0);
+    failed += expect_parse("d(1)", SIZE_MAX, 0, 2, 0, 0x2);
+    
+    /* Unterminated, unopened, repeated or followed by more cells */
+    failed += expect_parse("1,2 d(0,4", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1,2 d0", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1 d(4) d(5)", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1,2 d(3)4", SIZE_MAX, -1, 0, 0, 0);
+    failed += expect_parse("1 d(1)) ", SIZE_MAX, -1, 0, 0, 0);
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_length_views() {
+    printf("\n=== (ptr, len) views ===\n");
+    int failed = 0;
+    
+    /* Only len characters are read; a NUL ends the view early */
+    failed += expect_parse("1010XXXX", 4, 0, 2, 0xA, 0);
+    failed += expect_parse("0,1,3 trailing", 5, 0, 2, 0xB, 0);
+    failed += expect_parse("1,2 d(3)", 6, -1, 0, 0, 0);
+    failed += expect_parse("1010\0" "1111", 9, 0, 2, 0xA, 0);
+    
+    truth_table_t tt;
+    if (parse_input_n(NULL, 4, &tt) != -1 || parse_input_n("1010", 4, NULL) != -1) {
+        printf("  NULL arguments accepted\n");
+        failed++;
+    }
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_overlap() {
+    printf("\n=== A cell both 1 and don't care ===\n");
+    int failed = 0;
+    
+    /* The parser keeps both bits; validation refuses the table */
+    failed += expect_parse("1,2 d(2)", SIZE_MAX, 0, 2, 0x6, 0x4);
+    
+    char output[256];
+    int result = solve_kmap("1,2 d(2)", output, sizeof(output));
+    printf("solve_kmap(\"1,2 d(2)\") = %d\n", result);
+    if (result != -2) failed++;
+    
+    result = solve_kmap("1,1,2", output, sizeof(output));
+    printf("solve_kmap(\"1,1,2\") = %d: %s\n", result, result == 0 ? output : "");
+    if (result != 0 || strcmp(output, "A&~B + ~A&B") != 0) failed++;
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_wide_fallback() {
+    printf("\n=== Cells past 63 go to the wide parser ===\n");
+    int failed = 0;
+    
+    /* The highest cell sizes the table, minterm or don't care */
+    failed += expect_wide("1,2,99", 0, 7, 99, false);
+    failed += expect_wide("1,64", 0, 7, 64, false);
+    failed += expect_wide("1 d(200)", 0, 8, 200, true);
+    failed += expect_wide("1,,99", 0, 7, 99, false);
+    failed += expect_wide("0,65535", 0, 16, 65535, false);
+    
+    /* 16 variables is the limit */
+    failed += expect_wide("1,65536", -1, 0, 0, false);
+    failed += expect_wide("1,2 d(99", -1, 0, 0, false);
+    failed += expect_wide("1,2,99 d(99)", -2, 0, 0, false);
+    
+    char output[256];
+    int result = solve_kmap("1,2,99 d(99)", output, sizeof(output));
+    printf("solve_kmap(\"1,2,99 d(99)\") = %d\n", result);
+    if (result != -2) failed++;
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main() {
+    printf("Testing Cell Parser Edge Cases\n");
+    printf("==============================\n");
+    
+    int failed = test_binary_strings() + test_minterm_lists() + test_dont_care_sections() +
+                 test_length_views() + test_overlap() + test_wide_fallback();
+    
+    printf("\n%s: %d mismatch(es)\n", failed ? "FAILED" : "PASSED", failed);
+    return failed != 0;
+}
@@ -0,0 +1,271 @@
+#include "kmap_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * K-map grids, three ways: golden output of KMAP_FORM_MAP through the
+ * string API, random tables read back out of the rendered grid (labels,
+ * cell values, group letters), and the snprintf-style buffer contract
+ */
+
+/* === GOLDEN GRIDS === */
+
+/**
+ * @brief solve_kmap_form with KMAP_FORM_MAP added, compared with expected
+ * @return 1 on mismatch
+ */
+static int expect_map(const char* input, int form, const char* expected) {
+    char output[2048];
+    int result = solve_kmap_form(input, form | KMAP_FORM_MAP, output, sizeof(output));
+    
+    if (result != 0 || strcmp(output, expected) != 0) {
+        printf("  \"%s\" form %d -> %d:\n%s\n", input, form, result, result == 0 ? output : "");
+        return 1;
+    }
+    return 0;
+}
+
+static int test_golden(void) {
+    printf("\n=== Golden grids ===\n");
+    int failed = 0;
+    
+    /* The example in kmap_render.c, then its 0s lettered with clauses */
+    failed += expect_map("0,2,5,7,8,10,13,15", KMAP_FORM_SOP,
+                         "DC\\BA  00  01  11  10\n"
+                         "   00  1a  0   0   1a\n"
+                         "   01  0   1b  1b  0\n"
+                         "   11  0   1b  1b  0\n"
+                         "   10  1a  0   0   1a\n"
+                         "a: ~A&~C\n"
+                         "b: A&C\n"
+                         "~A&~C + A&C");
+    failed += expect_map("0,2,5,7,8,10,13,15", KMAP_FORM_POS,
+                         "DC\\BA  00  01  11  10\n"
+                         "   00  1   0a  0a  1\n"
+                         "   01  0b  1   1   0b\n"
+                         "   11  0b  1   1   0b\n"
+                         "   10  1   0a  0a  1\n"
+                         "a: ~A + C\n"
+                         "b: A + ~C\n"
+                         "(~A + C)&(A + ~C)");
+    
+    /* A don't care in three groups widens every column */
+    failed += expect_map("1,2,4,7 d(0)", KMAP_FORM_SOP,
+                         "C\\BA  00    01    11    10\n"
+                         "   0  Xbcd  1b    0     1c\n"
+                         "   1  1d    0     1a    0\n"
+                         "a: A&B&C\n"
+                         "b: ~B&~C\n"
+                         "c: ~A&~C\n"
+                         "d: ~A&~B\n"
+                         "A&B&C + ~B&~C + ~A&~C + ~A&~B");
+    
+    /* The POS cover is cheaper here, so the grid letters its clauses */
+    failed += expect_map("1,2,4,7 d(0)", KMAP_FORM_CHEAPEST,
+                         "C\\BA  00  01  11  10\n"
+                         "   0  X   1   0a  1\n"
+                         "   1  1   0b  1   0c\n"
+                         "a: ~A + ~B + C\n"
+                         "b: ~A + B + ~C\n"
+                         "c: A + ~B + ~C\n"
+                         "(~A + ~B + C)&(~A + B + ~C)&(A + ~B + ~C)");
+    
+    /* Both forms: one grid, from the SOP cover written first */
+    failed += expect_map("1,2 d(3)", KMAP_FORM_BOTH,
+                         "B\\A  0    1\n"
+                         "  0  0    1b\n"
+                         "  1  1a   Xab\n"
+                         "a: B\n"
+                         "b: A\n"
+                         "B + A\n"
+                         "A + B");
+    
+    /* Odd count: the extra variable goes to the columns */
+    failed += expect_map("20,21,22,23,28,29,30,31 d(0)", KMAP_FORM_SOP,
+                         "ED\\CBA  000  001  011  010  110  111  101  100\n"
+                         "    00  X    0    0    0    0    0    0    0\n"
+                         "    01  0    0    0    0    0    0    0    0\n"
+                         "    11  0    0    0    0    1a   1a   1a   1a\n"
+                         "    10  0    0    0    0    1a   1a   1a   1a\n"
+                         "a: C&E\n"
+                         "C&E");
+    
+    /* No groups: every cell is one character wide */
+    truth_table_t tt;
+    char output[2048];
+    init_truth_table(0xFF00FF0000000000ULL, 0, 6, &tt);
+    render_kmap(&tt, NULL, false, output, sizeof(output));
+    if (strcmp(output, "FED\\CBA  000  001  011  010  110  111  101  100\n"
+                       "    000  0    0    0    0    0    0    0    0\n"
+                       "    001  0    0    0    0    0    0    0    0\n"
+                       "    011  0    0    0    0    0    0    0    0\n"
+                       "    010  0    0    0    0    0    0    0    0\n"
+                       "    110  0    0    0    0    0    0    0    0\n"
+                       "    111  1    1    1    1    1    1    1    1\n"
+                       "    101  1    1    1    1    1    1    1    1\n"
+                       "    100  0    0    0    0    0    0    0    0") != 0) {
+        printf("  6-variable grid:\n%s\n", output);
+        failed++;
+    }
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+/* === GRIDS READ BACK === */
+
+/**
+ * @brief Read a binary label of bits characters
+ */
+static unsigned read_label(const char* text, unsigned bits) {
+    unsigned value = 0;
+    for (unsigned i = 0; i < bits; i++) value = (value << 1) | (unsigned)(text[i] == '1');
+    return value;
+}
+
+/**
+ * @brief Render a solved table, then read every cell back out of the text
+ *
+ * Cell numbers come from the printed labels, not from the Gray formula,
+ * so a label out of order shows up as a wrong value or letter set.
+ *
+ * @return 1 if the grid disagrees with the table or its cover
+ */
+static int read_back(const truth_table_t* tt, const solution_t* cover) {
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEF";
+    char grid[8192];
+    if (render_kmap(tt, cover, false, grid, sizeof(grid)) < 0) return 1;
+    
+    unsigned col_vars = (tt->num_vars + 1u) / 2, row_vars = tt->num_vars - col_vars;
+    unsigned cols = 1u << col_vars, rows = 1u << row_vars;
+    unsigned col_label[8], prev = 0;
+    
+    /* Header labels, each one bit from its neighbour, wrapping around */
+    char* line = strtok(grid, "\n");
+    char* field = strchr(line, '\\') + 1 + col_vars;
+    for (unsigned c = 0; c < cols; c++) {
+        field += strspn(field, " ");
+        col_label[c] = read_label(field, col_vars);
+        field += col_vars;
+        if (c > 0 && popcount(col_label[c] ^ prev) != 1) return 1;
+        prev = col_label[c];
+    }
+    if (cols > 2 && popcount(col_label[0] ^ col_label[cols - 1]) != 1) return 1;
+    
+    uint64_t seen = 0;
+    for (unsigned r = 0; r < rows; r++) {
+        line = strtok(NULL, "\n");
+        if (!line) return 1;
+        
+        char* cursor = line + strspn(line, " ");
+        unsigned row = read_label(cursor, row_vars);
+        cursor += row_vars;
+        
+        for (unsigned c = 0; c < cols; c++) {
+            cursor += strspn(cursor, " ");
+            unsigned cell = row << col_vars | col_label[c];
+            uint64_t bit = 1ULL << cell;
+            char want = (tt->dont_cares & bit) ? 'X' : (tt->minterms & bit) ? '1' : '0';
+            if (*cursor++ != want) return 1;
+            
+            /* Letters are exactly the groups holding the cell, in cover order */
+            for (int g = 0; g < cover->implicant_count; g++) {
+                const implicant_t* imp = &cover->implicants[g];
+                if ((cell & imp->literal_mask) == imp->literal_values) {
+                    if (*cursor++ != letters[g]) return 1;
+                }
+            }
+            if (*cursor != ' ' && *cursor != '\0') return 1;
+            seen |= bit;
+        }
+    }
+    
+    uint64_t all = tt->num_vars == 6 ? ~0ULL : (1ULL << (1u << tt->num_vars)) - 1;
+    if (seen != all) return 1;
+    
+    /* Legend: one line per group */
+    for (int g = 0; g < cover->implicant_count; g++) {
+        line = strtok(NULL, "\n");
+        if (!line || line[0] != letters[g] || line[1] != ':') return 1;
+    }
+    return strtok(NULL, "\n") != NULL;
+}
+
+static int test_read_back(void) {
+    printf("\n=== Random grids read back ===\n");
+    int failed = 0;
+    uint64_t state = 0xD1B54A32D192ED03ULL;
+    
+    for (int i = 0; i < 500; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        
+        uint8_t num_vars = (uint8_t)(2 + i % 5);
+        uint64_t all = num_vars == 6 ? ~0ULL : (1ULL << (1u << num_vars)) - 1;
+        uint64_t dont_cares = state & (state >> 7) & (state >> 11) & all;
+        
+        truth_table_t tt;
+        solution_t cover;
+        init_truth_table(state & ~dont_cares & all, dont_cares, num_vars, &tt);
+        if (find_prime_implicants(&tt, &cover) != 0 || read_back(&tt, &cover)) {
+            printf("  %u variables, m 0x%llx d 0x%llx\n", num_vars,
+                   (unsigned long long)tt.minterms, (unsigned long long)dont_cares);
+            failed++;
+        }
+    }
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+/* === BUFFERS AND ERRORS === */
+
+static int test_buffers(void) {
+    printf("\n=== Buffer sizing and errors ===\n");
+    int failed = 0;
+    
+    truth_table_t tt;
+    solution_t cover;
+    char full[2048], output[2048];
+    init_truth_table(0xA5A5, 0, 4, &tt);
+    find_prime_implicants(&tt, &cover);
+    size_t length = (size_t)render_kmap(&tt, &cover, false, full, sizeof(full));
+    
+    /* The full length back, the prefix that fits, always NUL-terminated, nothing past it */
+    for (size_t len = 0; len <= length + 1; len++) {
+        memset(output, '#', sizeof(output));
+        int result = render_kmap(&tt, &cover, false, len ? output : NULL, len);
+        size_t kept = len == 0 ? 0 : (len - 1 < length ? len - 1 : length);
+        
+        if (result != (int)length || (len && (strncmp(output, full, kept) != 0 ||
+                                              output[kept] != '\0' || output[len] != '#'))) {
+            printf("  output_len %zu -> %d\n", len, result);
+            failed++;
+        }
+    }
+    
+    /* A grid needs 2-6 variables and a form to go with it */
+    tt.num_vars = 7;
+    if (render_kmap(&tt, NULL, false, output, sizeof(output)) != -2) failed++;
+    if (render_kmap(NULL, NULL, false, output, sizeof(output)) != -1) failed++;
+    if (solve_kmap_form("1,2,99", KMAP_FORM_SOP | KMAP_FORM_MAP, output,
+                        sizeof(output)) != -1) {
+        failed++;
+    }
+    if (solve_kmap_form("1,2", KMAP_FORM_MAP, output, sizeof(output)) != -1) failed++;
+    
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main() {
+    printf("Testing K-Map Rendering\n");
+    printf("=======================\n");
+    
+    int failed = test_golden() + test_read_back() + test_buffers();
+    
+    printf("\n%s\n", failed ? "RENDER TEST FAILED" : "All grids match");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,509 @@
+#define _DEFAULT_SOURCE
+
+#include "kmap_internal.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * The solver daemon over a real socket in /tmp: a server thread per
+ * scenario, blocking clients that pipeline requests and read the answers
+ * back. Every answer is compared with solve_forms_n() run here, so the
+ * checks are about framing, ordering and connection handling.
+ */
+
+#define MAX_REQUEST_BYTES (4 << 20)             // As in kmap_serve.c
+#define ANSWER_BYTES 8192
+
+static int failures;
+
+#define CHECK(cond, what)                                                                   \
+    do {                                                                                    \
+        if (!(cond)) {                                                                      \
+            printf("  FAILED: %s (line %d)\n", what, __LINE__);                             \
+            failures++;                                                                     \
+        }                                                                                   \
+    } while (0)
+
+/* === SERVER THREAD === */
+
+typedef struct {
+    char path[64];
+    kmap_server_t* server;
+    kmap_pool_t* pool;
+    pthread_t thread;
+    int result;
+    kmap_serve_stats_t stats;
+} daemon_t;
+
+static void* run_server(void* arg) {
+    daemon_t* daemon = (daemon_t*)arg;
+    daemon->result = kmap_server_run(daemon->server);
+    return NULL;
+}
+
+static bool start_daemon(daemon_t* daemon, size_t max_batch, unsigned threads) {
+    kmap_serve_options_t opts;
+    kmap_serve_default_options(&opts);
+    opts.max_batch = max_batch;
+    
+    memset(daemon, 0, sizeof(daemon_t));
+    snprintf(daemon->path, sizeof(daemon->path), "/tmp/kmap_serve_test_%d.sock", (int)getpid());
+    daemon->pool = threads ? kmap_pool_create(threads) : NULL;
+    daemon->server = kmap_server_create(daemon->path, daemon->pool, &opts);
+    if (!daemon->server) return false;
+    return pthread_create(&daemon->thread, NULL, run_server, daemon) == 0;
+}
+
+/**
+ * @brief Stop and join the server, keeping its final counters
+ */
+static void stop_daemon(daemon_t* daemon) {
+    kmap_server_stop(daemon->server);
+    pthread_join(daemon->thread, NULL);
+    kmap_server_stats(daemon->server, &daemon->stats);
+    kmap_server_destroy(daemon->server);
+    kmap_pool_destroy(daemon->pool);
+}
+
+/* === CLIENT === */
+
+typedef struct {
+    int fd;
+    char data[4096];
+    size_t len;
+    size_t pos;
+} client_t;
+
+/**
+ * @brief Connect with a receive timeout, so a missing answer fails instead of hanging
+ */
+static bool connect_client(const daemon_t* daemon, client_t* client) {
+    struct sockaddr_un addr;
+    struct timeval timeout = {10, 0};
+    
+    memset(client, 0, sizeof(client_t));
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, daemon->path, strlen(daemon->path) + 1);
+    
+    client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client->fd < 0) return false;
+    setsockopt(client->fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return connect(client->fd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+}
+
+static bool send_all(int fd, const void* data, size_t len) {
+    const char* p = (const char*)data;
+    while (len > 0) {
+        ssize_t sent = send(fd, p, len, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        len -= (size_t)sent;
+    }
+    return true;
+}
+
+static int next_byte(client_t* client) {
+    if (client->pos == client->len) {
+        ssize_t got;
+        do {
+            got = recv(client->fd, client->data, sizeof(client->data), 0);
+        } while (got < 0 && errno == EINTR);
+        if (got <= 0) return -1;
+        client->len = (size_t)got;
+        client->pos = 0;
+    }
+    return (unsigned char)client->data[client->pos++];
+}
+
+/**
+ * @brief Read one answer line without its '\n'
+ * @return Length, or -1 on EOF, timeout or overflow
+ */
+static int read_line(client_t* client, char* out, size_t cap) {
+    size_t len = 0;
+    for (int byte = next_byte(client); byte != '\n'; byte = next_byte(client)) {
+        if (byte < 0 || len + 1 >= cap) return -1;
+        out[len++] = (char)byte;
+    }
+    out[len] = '\0';
+    return (int)len;
+}
+
+/**
+ * @brief Read one answer frame (0x00, uint32 length, text)
+ * @return Length, or -1 on EOF, timeout, a bad marker or overflow
+ */
+static int read_frame(client_t* client, char* out, size_t cap) {
+    if (next_byte(client) != 0) return -1;
+    
+    uint32_t len = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int byte = next_byte(client);
+        if (byte < 0) return -1;
+        len |= (uint32_t)byte << shift;
+    }
+    if (len + 1 > cap) return -1;
+    
+    for (uint32_t i = 0; i < len; i++) {
+        int byte = next_byte(client);
+        if (byte < 0) return -1;
+        out[i] = (char)byte;
+    }
+    out[len] = '\0';
+    return (int)len;
+}
+
+/**
+ * @brief True if the server closed the connection with nothing more to say
+ */
+static bool at_eof(client_t* client) {
+    if (client->pos < client->len) return false;
+    ssize_t got = recv(client->fd, client->data, sizeof(client->data), 0);
+    return got == 0 || (got < 0 && errno == ECONNRESET);
+}
+
+/* === REQUESTS AND EXPECTED ANSWERS === */
+
+/**
+ * @brief Append a frame request to a request buffer
+ */
+static void add_frame(kmap_buffer_t* requests, int form, const char* input) {
+    uint32_t len = (uint32_t)strlen(input);
+    unsigned char header[6] = {0, (unsigned char)form, (unsigned char)len,
+                               (unsigned char)(len >> 8), (unsigned char)(len >> 16),
+                               (unsigned char)(len >> 24)};
+    buffer_append(requests, header, sizeof(header));
+    buffer_append(requests, input, len);
+}
+
+static void add_line(kmap_buffer_t* requests, const char* line) {
+    buffer_append(requests, line, strlen(line));
+}
+
+/**
+ * @brief The answer text the daemon must send for one request
+ */
+static void expected_answer(const char* input, int form, bool framed, char* out) {
+    int result = solve_forms_n(input, SIZE_MAX, form, framed ? '\n' : '\t', out, ANSWER_BYTES);
+    if (result < 0) snprintf(out, ANSWER_BYTES, "error %d", result);
+}
+
+/**
+ * @brief Read one answer and compare it with the expected text
+ * @return 1 on mismatch
+ */
+static int expect_answer(client_t* client, const char* input, int form, bool framed) {
+    char want[ANSWER_BYTES], got[ANSWER_BYTES];
+    expected_answer(input, form, framed, want);
+    
+    int len = framed ? read_frame(client, got, sizeof(got)) : read_line(client, got, sizeof(got));
+    if (len < 0 || strcmp(got, want) != 0) {
+        printf("  %s \"%s\" form %d: got \"%s\", expected \"%s\"\n", framed ? "frame" : "line",
+               input, form, len < 0 ? "(nothing)" : got, want);
+        return 1;
+    }
+    return 0;
+}
+
+/* === SCENARIOS === */
+
+static void scenario_mixed_framing(void) {
+    daemon_t daemon;
+    client_t client;
+    kmap_buffer_t requests = {0};
+    char answer[ANSWER_BYTES];
+    
+    CHECK(start_daemon(&daemon, 0, 0), "server starts");
+    CHECK(connect_client(&daemon, &client), "client connects");
+    
+    /* Lines, prefixed lines, CRLF and frames back to back in one write */
+    add_line(&requests, "1010\n");
+    add_frame(&requests, 0, "0,1,3");
+    add_line(&requests, "sop:0,1,3\n");
+    add_line(&requests, "both:0,1,3\r\n");
+    add_frame(&requests, KMAP_FORM_BOTH, "0,1,3");
+    add_line(&requests, "pos:A&B | C\n");
+    add_frame(&requests, KMAP_FORM_SOP | KMAP_FORM_MAP, "1,2 d(3)");
+    add_line(&requests, "1,2,99 d(99)\n");
+    add_frame(&requests, 0x40, "1010");
+    add_line(&requests, "cheapest:1,2,4,7 d(0)\n");
+    CHECK(send_all(client.fd, requests.data, requests.len), "requests sent");
+    
+    /* Two answers spelled out, the rest from solve_forms_n */
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "A") == 0,
+          "plain line answered");
+    CHECK(read_frame(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "~B + A") == 0,
+          "frame with the default form answered");
+    
+    int wrong = expect_answer(&client, "0,1,3", KMAP_FORM_SOP, false);
+    wrong += expect_answer(&client, "0,1,3", KMAP_FORM_BOTH, false);
+    wrong += expect_answer(&client, "0,1,3", KMAP_FORM_BOTH, true);
+    wrong += expect_answer(&client, "A&B | C", KMAP_FORM_POS, false);
+    wrong += expect_answer(&client, "1,2 d(3)", KMAP_FORM_SOP | KMAP_FORM_MAP, true);
+    CHECK(wrong == 0, "prefixed and framed answers");
+    
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "error -2") == 0,
+          "invalid table answered with its error");
+    CHECK(read_frame(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "error -1") == 0,
+          "unknown form byte answered with an error");
+    CHECK(expect_answer(&client, "1,2,4,7 d(0)", KMAP_FORM_CHEAPEST, false) == 0,
+          "cheapest prefix");
+    
+    /* A "both:" answer is one line: SOP and POS are split by a tab */
+    requests.len = 0;
+    add_line(&requests, "both:1010\n1,2\n");
+    send_all(client.fd, requests.data, requests.len);
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "A\tA") == 0,
+          "both: keeps SOP and POS on one line");
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "A&~B + ~A&B") == 0,
+          "the next line is the next answer");
+    
+    close(client.fd);
+    stop_daemon(&daemon);
+    CHECK(daemon.result == 0 && daemon.stats.requests == 12 && daemon.stats.failed == 2,
+          "counters after the mixed connection");
+    free(requests.data);
+}
+
+/**
+ * @brief Request i of the ordering scenario: distinct 4-variable tables
+ */
+static void ordered_input(unsigned i, char* input) {
+    unsigned cells = (i * 40503u) & 0xFFFF;
+    for (int bit = 0; bit < 16; bit++) input[bit] = (char)('0' + (cells >> (15 - bit) & 1));
+    input[16] = '\0';
+}
+
+static void scenario_batch_order(void) {
+    enum { CLIENTS = 2, REQUESTS = 500 };
+    daemon_t daemon;
+    client_t clients[CLIENTS];
+    kmap_buffer_t requests[CLIENTS] = {{0}};
+    char input[17];
+    
+    /* Batches of 7 split every connection's pipeline and the 64-request chunks */
+    CHECK(start_daemon(&daemon, 7, 4), "server starts with a pool");
+    for (int c = 0; c < CLIENTS; c++) {
+        CHECK(connect_client(&daemon, &clients[c]), "client connects");
+        
+        for (unsigned i = 0; i < REQUESTS; i++) {
+            ordered_input(i + (unsigned)c * REQUESTS, input);
+            if (i % 3 == 0) {
+                add_frame(&requests[c], KMAP_FORM_POS, input);
+            } else {
+                add_line(&requests[c], i % 3 == 1 ? "" : "both:");
+                add_line(&requests[c], input);
+                add_line(&requests[c], "\n");
+            }
+        }
+    }
+    
+    /* Both pipelines are in flight before either is read */
+    for (int c = 0; c < CLIENTS; c++) {
+        CHECK(send_all(clients[c].fd, requests[c].data, requests[c].len), "pipeline sent");
+    }
+    
+    int wrong = 0;
+    for (int c = 0; c < CLIENTS; c++) {
+        for (unsigned i = 0; i < REQUESTS; i++) {
+            ordered_input(i + (unsigned)c * REQUESTS, input);
+            int form = i % 3 == 0 ? KMAP_FORM_POS : i % 3 == 1 ? KMAP_FORM_SOP : KMAP_FORM_BOTH;
+            if (expect_answer(&clients[c], input, form, i % 3 == 0)) {
+                wrong++;
+                break;
+            }
+        }
+        close(clients[c].fd);
+        free(requests[c].data);
+    }
+    CHECK(wrong == 0, "answers in request order on every connection");
+    
+    stop_daemon(&daemon);
+    CHECK(daemon.stats.requests == CLIENTS * REQUESTS, "every request answered once");
+    CHECK(daemon.stats.batches >= CLIENTS * REQUESTS / 7, "no batch over max_batch");
+}
+
+static void scenario_end_of_input(void) {
+    daemon_t daemon;
+    client_t client;
+    kmap_buffer_t requests = {0};
+    char answer[ANSWER_BYTES];
+    
+    CHECK(start_daemon(&daemon, 0, 0), "server starts");
+    
+    /* A last line without '\n' is still a request */
+    CHECK(connect_client(&daemon, &client), "client connects");
+    add_line(&requests, "1010\n0,1,3");
+    send_all(client.fd, requests.data, requests.len);
+    shutdown(client.fd, SHUT_WR);
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "A") == 0,
+          "line before EOF answered");
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "~B + A") == 0,
+          "unterminated last line answered");
+    CHECK(at_eof(&client), "closed once answered");
+    close(client.fd);
+    
+    /* A frame cut short can never complete: answer what came before, then close */
+    CHECK(connect_client(&daemon, &client), "client connects");
+    requests.len = 0;
+    add_line(&requests, "1010\n");
+    add_frame(&requests, 0, "0,1,3");
+    requests.len -= 2;
+    send_all(client.fd, requests.data, requests.len);
+    shutdown(client.fd, SHUT_WR);
+    CHECK(read_line(&client, answer, sizeof(answer)) >= 0 && strcmp(answer, "A") == 0,
+          "request before the partial frame answered");
+    CHECK(at_eof(&client), "partial frame at EOF closes the connection");
+    close(client.fd);
+    
+    /* Only a header */
+    CHECK(connect_client(&daemon, &client), "client connects");
+    send_all(client.fd, "\0\0\x10", 3);
+    shutdown(client.fd, SHUT_WR);
+    CHECK(at_eof(&client), "partial frame header at EOF closes the connection");
+    close(client.fd);
+    
+    stop_daemon(&daemon);
+    CHECK(daemon.stats.connections == 3 && daemon.stats.requests == 3, "counters after EOFs");
+    free(requests.data);
+}
+
+static void scenario_oversized(void) {
+    daemon_t daemon;
+    client_t client, other;
+    char answer[ANSWER_BYTES];
+    
+    CHECK(start_daemon(&daemon, 0, 0), "server starts");
+    
+    /* A frame header announcing more than MAX_REQUEST_BYTES drops at once */
+    CHECK(connect_client(&daemon, &client), "client connects");
+    uint32_t len = MAX_REQUEST_BYTES + 1;
+    unsigned char header[6] = {0, 0, (unsigned char)len, (unsigned char)(len >> 8),
+                               (unsigned char)(len >> 16), (unsigned char)(len >> 24)};
+    send_all(client.fd, header, sizeof(header));
+    CHECK(at_eof(&client), "oversized frame drops the connection");
+    close(client.fd);
+    
+    /* A line that never ends is dropped once it passes the limit */
+    size_t long_len = MAX_REQUEST_BYTES + (1 << 20);
+    char* long_line = malloc(long_len);
+    memset(long_line, '1', long_len);
+    CHECK(connect_client(&daemon, &client), "client connects");
+    send_all(client.fd, long_line, long_len);
+    CHECK(at_eof(&client), "endless line drops the connection");
+    close(client.fd);
+    free(long_line);
+    
+    /* The server itself carries on */
+    CHECK(connect_client(&daemon, &other), "client connects after the drops");
+    send_all(other.fd, "0,1,3\n", 6);
+    CHECK(read_line(&other, answer, sizeof(answer)) >= 0 && strcmp(answer, "~B + A") == 0,
+          "later connection answered");
+    close(other.fd);
+    
+    stop_daemon(&daemon);
+    CHECK(daemon.stats.requests == 1, "dropped requests never solved");
+}
+
+/**
+ * @brief Pipeline writer for the backpressure scenario
+ */
+typedef struct {
+    int fd;
+    const kmap_buffer_t* requests;
+    int done;
+} writer_t;
+
+static void* write_requests(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    send_all(writer->fd, writer->requests->data, writer->requests->len);
+    __atomic_store_n(&writer->done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void scenario_backpressure(void) {
+    /* 6-variable parity: each "both:" answer is about 1 KB, 8000 of them far past 1 MB */
+    enum { REQUESTS = 8000 };
+    static const char parity[] = "0110100110010110100101100110100110010110011010010110100110010110";
+    daemon_t daemon;
+    client_t slow, other;
+    kmap_buffer_t requests = {0};
+    char answer[ANSWER_BYTES];
+    
+    for (int i = 0; i < REQUESTS; i++) {
+        add_line(&requests, "both:");
+        add_line(&requests, parity);
+        add_line(&requests, "\n");
+    }
+    
+    CHECK(start_daemon(&daemon, 0, 2), "server starts with a pool");
+    CHECK(connect_client(&daemon, &slow), "slow client connects");
+    
+    /* Send everything, read nothing: the server must stop reading this client */
+    writer_t writer = {slow.fd, &requests, 0};
+    pthread_t thread;
+    CHECK(pthread_create(&thread, NULL, write_requests, &writer) == 0, "writer starts");
+    usleep(100000);
+    
+    CHECK(connect_client(&daemon, &other), "second client connects");
+    send_all(other.fd, "1010\n", 5);
+    CHECK(read_line(&other, answer, sizeof(answer)) >= 0 && strcmp(answer, "A") == 0,
+          "other clients are served while one is stalled");
+    close(other.fd);
+    
+    /* Without the high-water mark the server takes all of it in well within this wait */
+    for (int wait = 0; wait < 200 && !__atomic_load_n(&writer.done, __ATOMIC_ACQUIRE); wait++) {
+        usleep(10000);
+    }
+    CHECK(!__atomic_load_n(&writer.done, __ATOMIC_ACQUIRE),
+          "a client that reads nothing cannot send without limit");
+    
+    /* Reading drains the backlog and lets the writer finish */
+    int wrong = 0;
+    for (int i = 0; i < REQUESTS && !wrong; i++) {
+        wrong += expect_answer(&slow, parity, KMAP_FORM_BOTH, false);
+    }
+    CHECK(wrong == 0, "every stalled answer arrives in order");
+    pthread_join(thread, NULL);
+    CHECK(writer.done, "writer finished once answers were read");
+    close(slow.fd);
+    
+    stop_daemon(&daemon);
+    CHECK(daemon.stats.requests == REQUESTS + 1, "counters after backpressure");
+    free(requests.data);
+}
+
+int main() {
+    static const struct {
+        const char* name;
+        void (*run)(void);
+    } scenarios[] = {
+        {"line and frame requests on one connection", scenario_mixed_framing},
+        {"answer order across max_batch splits", scenario_batch_order},
+        {"end of input", scenario_end_of_input},
+        {"oversized requests", scenario_oversized},
+        {"output backpressure", scenario_backpressure},
+    };
+    
+    printf("Testing Solver Daemon\n");
+    printf("=====================\n");
+    
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        int before = failures;
+        printf("\n%s\n", scenarios[i].name);
+        scenarios[i].run();
+        printf("  %s\n", failures == before ? "ok" : "FAILED");
+    }
+    
+    printf("\n%s: %d check(s) failed\n", failures ? "FAILED" : "PASSED", failures);
+    return failures != 0;
+}
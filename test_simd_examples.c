@@ -0,0 +1,211 @@
+#include "kmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Every kernel set, forced in turn, against plain C references: binary
+ * strings over each vector lane edge, bad bytes, and strings that end at
+ * the last byte of their allocation so an overread shows up under ASan;
+ * column superset scans from every start over ragged tails
+ */
+
+static const struct {
+    kmap_simd_level_t level;
+    const char* name;
+} levels[] = {
+    {KMAP_SIMD_SCALAR, "scalar"},
+    {KMAP_SIMD_SSE2, "sse2"},
+    {KMAP_SIMD_AVX2, "avx2"},
+    {KMAP_SIMD_AVX512, "avx512"},
+};
+
+/* Near misses of "01Xx-", high-bit and control bytes */
+static const char bad_bytes[] = {'2', 'Y', 'y', '/', ' ', '\0', (char)0x80, (char)0xB1, (char)0xFF};
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/**
+ * @brief Character i is cell len-1-i; anything outside "01Xx-" fails
+ */
+static int reference_parse(const char* input, size_t len, truth_table_t* tt) {
+    memset(tt, 0, sizeof(truth_table_t));
+    for (size_t i = 0; i < len; i++) {
+        uint64_t bit = 1ULL << (len - 1 - i);
+        switch (input[i]) {
+            case '1': tt->minterms |= bit; break;
+            case '0': break;
+            case 'X':
+            case 'x':
+            case '-': tt->dont_cares |= bit; break;
+            default: return -1;
+        }
+    }
+    tt->num_vars = (uint8_t)ctz(len);
+    tt->minterm_count = popcount(tt->minterms);
+    return 0;
+}
+
+/**
+ * @brief Parse a copy that ends exactly at the end of its heap block
+ * @return 1 if the kernel disagrees with the reference
+ */
+static int differs(const char* input, size_t len) {
+    char* exact = malloc(len);
+    memcpy(exact, input, len);
+    
+    truth_table_t expected, actual;
+    int want = reference_parse(exact, len, &expected);
+    int got = parse_binary_n(exact, len, &actual);
+    free(exact);
+    
+    if (want != got) return 1;
+    return got == 0 && (actual.minterms != expected.minterms ||
+                        actual.dont_cares != expected.dont_cares ||
+                        actual.num_vars != expected.num_vars ||
+                        actual.minterm_count != expected.minterm_count);
+}
+
+/**
+ * @brief Run every length and corruption pattern through the current kernel
+ * @return Number of inputs the kernel got wrong
+ */
+static size_t check_kernel(size_t* inputs) {
+    static const char alphabet[] = "01Xx-";
+    static const size_t lengths[] = {4, 8, 16, 32, 64};
+    char input[MAX_CELLS];
+    size_t wrong = 0;
+    
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t len = lengths[l];
+        
+        for (int round = 0; round < 200; round++) {
+            for (size_t i = 0; i < len; i++) input[i] = alphabet[next_random() % 5];
+            wrong += differs(input, len);
+            (*inputs)++;
+            
+            /* One bad byte: first, last, either side of each 16-byte lane edge, random */
+            size_t spots[] = {0, len - 1, 15, 16, 31, 32, 47, 48, (size_t)(next_random() % len)};
+            for (size_t s = 0; s < sizeof(spots) / sizeof(spots[0]); s++) {
+                if (spots[s] >= len) continue;
+                char saved = input[spots[s]];
+                input[spots[s]] = bad_bytes[next_random() % sizeof(bad_bytes)];
+                wrong += differs(input, len);
+                (*inputs)++;
+                input[spots[s]] = saved;
+            }
+        }
+        
+        /* Uniform strings hit the all-ones and all-zero movemask words */
+        const char fills[] = {'0', '1', 'X', 'x', '-'};
+        for (size_t f = 0; f < sizeof(fills); f++) {
+            memset(input, fills[f], len);
+            wrong += differs(input, len);
+            (*inputs)++;
+        }
+    }
+    
+    /* Lengths that are not whole tables never reach a kernel */
+    static const size_t bad_lengths[] = {0, 1, 2, 3, 5, 12, 48, 65, 128};
+    memset(input, '1', sizeof(input));
+    for (size_t l = 0; l < sizeof(bad_lengths) / sizeof(bad_lengths[0]); l++) {
+        truth_table_t tt;
+        if (bad_lengths[l] <= MAX_CELLS && parse_binary_n(input, bad_lengths[l], &tt) != -1) {
+            wrong++;
+        }
+        (*inputs)++;
+    }
+    
+    return wrong;
+}
+
+/**
+ * @brief Strided records: a bad one is zeroed and reported, the rest parse
+ * @return 1 on failure
+ */
+static int check_batch(void) {
+    const char dump[] =
+        "1010101010101010\n"
+        "XXXXXXXXXXXXXXX1\n"
+        "10101010101010Z0\n"
+        "0000000000000000\n";
+    truth_table_t tables[4];
+    int status[4];
+    
+    int result = parse_binary_batch(dump, 16, 17, 4, tables, status);
+    if (result != -1 || status[0] != 0 || status[1] != 0 || status[2] != -1 ||
+        status[3] != 0 || tables[0].minterms != 0xAAAA || tables[1].minterms != 0x1 ||
+        tables[1].dont_cares != 0xFFFE || tables[2].num_vars != 0 ||
+        tables[3].num_vars != 4 || tables[3].minterms != 0) {
+        printf("batch of 4 records (one bad): %d, status %d %d %d %d\n", result,
+               status[0], status[1], status[2], status[3]);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief find_superset_column from every start, against a linear scan
+ * @return Number of wrong column indices
+ */
+static size_t check_superset(size_t* inputs) {
+    /* 37 columns leave a ragged tail after the whole 4- and 8-column steps */
+    enum { COLUMNS = 37 };
+    uint64_t* columns = malloc(COLUMNS * sizeof(uint64_t));
+    size_t wrong = 0;
+    
+    for (int round = 0; round < 40; round++) {
+        for (uint32_t j = 0; j < COLUMNS; j++) {
+            columns[j] = next_random() | next_random();
+        }
+        
+        for (uint32_t count = 0; count <= COLUMNS; count++) {
+            /* A subset of one column (often found), a random mask (rarely), or nothing */
+            uint64_t wants[3] = {0, next_random(), 0};
+            if (count > 0) wants[0] = columns[next_random() % count] & next_random();
+            
+            for (int w = 0; w < 3; w++) {
+                for (uint32_t start = 0; start <= count; start++) {
+                    uint32_t expected = start;
+                    while (expected < count && (wants[w] & ~columns[expected])) expected++;
+                    
+                    wrong += find_superset_column(columns, start, count, wants[w]) != expected;
+                    (*inputs)++;
+                }
+            }
+        }
+    }
+    
+    free(columns);
+    return wrong;
+}
+
+int main() {
+    printf("Testing Vector Kernels\n");
+    printf("======================\n");
+    printf("%-8s %8s %8s\n", "kernel", "inputs", "wrong");
+    
+    size_t wrong = 0;
+    for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        if (kmap_simd_force(levels[i].level) != 0) {
+            printf("%-8s %8s\n", levels[i].name, "skipped (not supported here)");
+            continue;
+        }
+        
+        size_t inputs = 0;
+        size_t level_wrong = check_kernel(&inputs) + check_superset(&inputs);
+        wrong += level_wrong + (size_t)check_batch();
+        printf("%-8s %8zu %8zu\n", levels[i].name, inputs, level_wrong);
+    }
+    kmap_simd_force(KMAP_SIMD_AUTO);
+    
+    printf("\n%s\n", wrong ? "KERNEL MISMATCH" : "All kernels agree with the reference");
+    return wrong ? 1 : 0;
+}
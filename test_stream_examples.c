@@ -0,0 +1,364 @@
+#define _DEFAULT_SOURCE
+
+#include "kmap_internal.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * kmap_stream_buffer() writing into a pipe that a reader thread drains:
+ * the captured text and kmap_stream_stats_t of each run are compared with
+ * answers built here, line by line, from solve_forms_n()
+ */
+
+/* === CAPTURE === */
+
+typedef struct {
+    int fd;
+    kmap_buffer_t text;
+} capture_t;
+
+static void* drain_pipe(void* arg) {
+    capture_t* capture = (capture_t*)arg;
+    char block[4096];
+    ssize_t got;
+    
+    while ((got = read(capture->fd, block, sizeof(block))) > 0) {
+        buffer_append(&capture->text, block, (size_t)got);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Stream data into a pipe and collect everything written to it
+ * @return kmap_stream_buffer() result
+ */
+static int stream_to_text(const char* data, size_t len, kmap_pool_t* pool,
+                          const kmap_stream_options_t* opts, kmap_stream_stats_t* stats,
+                          kmap_buffer_t* text) {
+    int fds[2];
+    if (pipe(fds) != 0) return -100;
+    
+    capture_t capture = {fds[0], {0}};
+    pthread_t reader;
+    pthread_create(&reader, NULL, drain_pipe, &capture);
+    
+    int result = kmap_stream_buffer(data, len, fds[1], pool, opts, stats);
+    close(fds[1]);
+    pthread_join(reader, NULL);
+    close(fds[0]);
+    
+    *text = capture.text;
+    buffer_append(text, "", 1);
+    text->len--;
+    return result;
+}
+
+/**
+ * @brief Append what one record must become: its answer, or "error <code>"
+ */
+static void add_answer(kmap_buffer_t* expected, const char* input, size_t len, int form) {
+    char answer[4096];
+    int result = solve_forms_n(input, len, form, '\t', answer, sizeof(answer));
+    if (result < 0) result = snprintf(answer, sizeof(answer), "error %d", result);
+    
+    buffer_append(expected, answer, (size_t)result);
+    buffer_append(expected, "\n", 1);
+    if (form & KMAP_FORM_MAP) buffer_append(expected, "\n", 1);
+}
+
+/**
+ * @brief Compare a run with the expected text and counters
+ * @return 1 on mismatch
+ */
+static int compare(const char* what, int result, const kmap_buffer_t* text,
+                   const kmap_stream_stats_t* stats, const kmap_buffer_t* expected,
+                   uint64_t records, uint64_t failed) {
+    bool same_text = text->len == expected->len &&
+                     (text->len == 0 || memcmp(text->data, expected->data, text->len) == 0);
+    
+    if (result != 0 || !same_text || stats->records != records || stats->failed != failed ||
+        stats->bytes_written != text->len) {
+        printf("  %s: result %d, %zu bytes (expected %zu), records %llu/%llu, failed %llu/%llu,"
+               " bytes_written %llu\n", what, result, text->len, expected->len,
+               (unsigned long long)stats->records, (unsigned long long)records,
+               (unsigned long long)stats->failed, (unsigned long long)failed,
+               (unsigned long long)stats->bytes_written);
+        return 1;
+    }
+    return 0;
+}
+
+/* === LINE INPUT === */
+
+static int test_line_input(void) {
+    static const struct {
+        const char* name;
+        const char* input;
+        int form;
+        const char* output;
+        uint64_t records;
+        uint64_t failed;
+    } cases[] = {
+        {"one line per record", "1010\n0,1,3\nA&B\n", KMAP_FORM_SOP,
+         "A\n~B + A\nA&B\n", 3, 0},
+        {"last line without newline", "1010\n0,1,3", KMAP_FORM_SOP, "A\n~B + A\n", 2, 0},
+        {"CRLF line ends", "1010\r\n0,1,3\r\n", KMAP_FORM_SOP, "A\n~B + A\n", 2, 0},
+        {"blank lines are failed records", "1010\n\n\r\n0,1,3\n", KMAP_FORM_SOP,
+         "A\nerror -1\nerror -1\n~B + A\n", 4, 2},
+        {"bad records stay in place", "1,2,99 d(99)\n101\n1010\n", KMAP_FORM_SOP,
+         "error -2\nerror -1\nA\n", 3, 2},
+        {"both forms split by a tab", "0,1,3\n", KMAP_FORM_BOTH, "~B + A\tA + ~B\n", 1, 0},
+        {"grids end with a blank line", "1010\n0,1,3\n", KMAP_FORM_SOP | KMAP_FORM_MAP,
+         "B\\A  0   1\n"
+         "  0  0   1a\n"
+         "  1  0   1a\n"
+         "a: A\n"
+         "A\n"
+         "\n"
+         "B\\A  0    1\n"
+         "  0  1a   1ab\n"
+         "  1  0    1b\n"
+         "a: ~B\n"
+         "b: A\n"
+         "~B + A\n"
+         "\n", 2, 0},
+        {"a failed grid is one line and the blank", "101\n1010\n", KMAP_FORM_SOP | KMAP_FORM_MAP,
+         "error -1\n"
+         "\n"
+         "B\\A  0   1\n"
+         "  0  0   1a\n"
+         "  1  0   1a\n"
+         "a: A\n"
+         "A\n"
+         "\n", 2, 1},
+        {"empty input", "", KMAP_FORM_SOP, "", 0, 0},
+    };
+    printf("\n--- line input ---\n");
+    int failed = 0;
+    
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        kmap_stream_options_t opts;
+        kmap_stream_default_options(&opts);
+        opts.form = cases[i].form;
+        
+        kmap_stream_stats_t stats;
+        kmap_buffer_t text, expected = {0};
+        buffer_append(&expected, cases[i].output, strlen(cases[i].output));
+        
+        int result = stream_to_text(cases[i].input, strlen(cases[i].input), NULL, &opts, &stats,
+                                    &text);
+        failed += compare(cases[i].name, result, &text, &stats, &expected, cases[i].records,
+                          cases[i].failed);
+        free(text.data);
+        free(expected.data);
+    }
+    
+    printf("%zu cases, %d failed\n", sizeof(cases) / sizeof(cases[0]), failed);
+    return failed;
+}
+
+/* === SLOT HANDOFF === */
+
+/**
+ * @brief Line i of the handoff input: distinct tables, every 7th one invalid
+ */
+static void handoff_line(unsigned i, char* line) {
+    if (i % 7 == 3) {
+        strcpy(line, "1,2,99 d(99)");
+        return;
+    }
+    unsigned cells = (i * 2654435761u) >> 16;
+    for (int bit = 0; bit < 16; bit++) line[bit] = "01X0"[cells >> ((15 - bit) % 8 * 2) & 3];
+    line[16] = '\0';
+}
+
+static int test_slot_handoff(void) {
+    enum { LINES = 5000 };
+    printf("\n--- two-slot handoff ---\n");
+    
+    /* Batches smaller than, equal to and across a chunk, with and without a pool */
+    static const size_t batches[] = {1, 3, 256, 257, 1000, 0};
+    kmap_pool_t* pool = kmap_pool_create(4);
+    kmap_buffer_t input = {0}, expected[2] = {{0}, {0}};
+    char line[32];
+    uint64_t bad = 0;
+    
+    for (unsigned i = 0; i < LINES; i++) {
+        handoff_line(i, line);
+        buffer_append(&input, line, strlen(line));
+        buffer_append(&input, i % 2 ? "\r\n" : "\n", i % 2 ? 2 : 1);
+        add_answer(&expected[0], line, SIZE_MAX, KMAP_FORM_SOP);
+        add_answer(&expected[1], line, SIZE_MAX, KMAP_FORM_BOTH);
+        bad += i % 7 == 3;
+    }
+    
+    int failed = 0;
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        for (int with_pool = 0; with_pool < 2; with_pool++) {
+            kmap_stream_options_t opts;
+            kmap_stream_default_options(&opts);
+            opts.batch_records = batches[b];
+            opts.form = with_pool ? KMAP_FORM_BOTH : KMAP_FORM_SOP;
+            
+            char what[64];
+            snprintf(what, sizeof(what), "batch %zu, %s", batches[b],
+                     with_pool ? "pool, both forms" : "no pool, SOP");
+            
+            kmap_stream_stats_t stats;
+            kmap_buffer_t text;
+            int result = stream_to_text(input.data, input.len, with_pool ? pool : NULL, &opts,
+                                        &stats, &text);
+            failed += compare(what, result, &text, &stats, &expected[with_pool], LINES, bad);
+            free(text.data);
+        }
+    }
+    
+    kmap_pool_destroy(pool);
+    free(input.data);
+    free(expected[0].data);
+    free(expected[1].data);
+    printf("%d run(s) failed\n", failed);
+    return failed;
+}
+
+/* === BINARY RECORDS === */
+
+/**
+ * @brief The binary-string spelling of a record, first character the highest cell
+ */
+static void record_text(uint64_t minterms, uint64_t dont_cares, uint8_t num_vars, char* text) {
+    size_t cells = (size_t)1 << num_vars;
+    for (size_t i = 0; i < cells; i++) {
+        uint64_t bit = 1ULL << (cells - 1 - i);
+        text[i] = (dont_cares & bit) ? 'X' : (minterms & bit) ? '1' : '0';
+    }
+    text[cells] = '\0';
+}
+
+static int test_binary_records(void) {
+    enum { RECORDS = 600 };
+    printf("\n--- binary records ---\n");
+    int failed = 0;
+    
+    uint64_t* words = malloc(RECORDS * 2 * sizeof(uint64_t));
+    kmap_buffer_t expected = {0};
+    uint64_t state = 0x243F6A8885A308D3ULL, bad = 0;
+    char text[MAX_CELLS + 1];
+    
+    for (int i = 0; i < RECORDS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        
+        /* Cells past the table, or a cell both 1 and don't care, fail the record */
+        words[2 * i] = state & 0xFFFF;
+        words[2 * i + 1] = (state >> 20) & (state >> 40) & 0xFFFF & ~words[2 * i];
+        if (i % 50 == 7) words[2 * i] |= 1ULL << 20;
+        if (i % 50 == 9) words[2 * i + 1] |= words[2 * i] & -words[2 * i];
+        
+        if (i % 50 == 7 || (i % 50 == 9 && words[2 * i])) {
+            buffer_append(&expected, "error -2\n", 9);
+            bad++;
+        } else {
+            record_text(words[2 * i], words[2 * i + 1], 4, text);
+            add_answer(&expected, text, SIZE_MAX, KMAP_FORM_CHEAPEST);
+        }
+    }
+    
+    kmap_stream_options_t opts;
+    kmap_stream_default_options(&opts);
+    opts.format = KMAP_STREAM_RECORDS;
+    opts.num_vars = 4;
+    opts.form = KMAP_FORM_CHEAPEST;
+    opts.batch_records = 100;
+    
+    kmap_stream_stats_t stats;
+    kmap_buffer_t out;
+    const char* data = (const char*)words;
+    size_t len = RECORDS * 2 * sizeof(uint64_t);
+    int result = stream_to_text(data, len, NULL, &opts, &stats, &out);
+    failed += compare("600 4-variable records", result, &out, &stats, &expected, RECORDS, bad);
+    free(out.data);
+    
+    /* A length that is not whole 16-byte records is refused before anything is written */
+    static const size_t ragged[] = {1, 15, 17, 16 * RECORDS - 8};
+    for (size_t r = 0; r < sizeof(ragged) / sizeof(ragged[0]); r++) {
+        result = stream_to_text(data, ragged[r], NULL, &opts, &stats, &out);
+        if (result != -1 || out.len != 0) {
+            printf("  %zu bytes of records: %d, %zu bytes written\n", ragged[r], result, out.len);
+            failed++;
+        }
+        free(out.data);
+    }
+    
+    /* Records need 2-6 variables */
+    opts.num_vars = 7;
+    result = stream_to_text(data, 16, NULL, &opts, &stats, &out);
+    if (result != -1 || out.len != 0) failed++;
+    free(out.data);
+    
+    free(expected.data);
+    free(words);
+    printf("%d check(s) failed\n", failed);
+    return failed;
+}
+
+/* === WRITE ERRORS === */
+
+static int test_write_errors(void) {
+    enum { LINES = 20000, BATCH = 64 };
+    printf("\n--- write errors ---\n");
+    int failed = 0;
+    
+    kmap_buffer_t input = {0};
+    for (int i = 0; i < LINES; i++) buffer_append(&input, "0,1,3\n", 6);
+    
+    kmap_stream_options_t opts;
+    kmap_stream_default_options(&opts);
+    opts.batch_records = BATCH;
+    
+    /* Nobody reads the pipe: the first write fails with EPIPE */
+    int fds[2];
+    pipe(fds);
+    close(fds[0]);
+    
+    kmap_stream_stats_t stats;
+    int result = kmap_stream_buffer(input.data, input.len, fds[1], NULL, &opts, &stats);
+    close(fds[1]);
+    
+    /* At most the batch in the other slot is solved after the writer fails */
+    if (result != -4 || stats.records > 2 * BATCH || stats.bytes_written == 0) {
+        printf("  closed pipe: %d after %llu records\n", result,
+               (unsigned long long)stats.records);
+        failed++;
+    }
+    
+    /* Not a descriptor at all */
+    result = kmap_stream_buffer(input.data, input.len, -1, NULL, &opts, &stats);
+    if (result != -4 || stats.records > 2 * BATCH) {
+        printf("  fd -1: %d after %llu records\n", result, (unsigned long long)stats.records);
+        failed++;
+    }
+    
+    free(input.data);
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main() {
+    printf("Testing Streaming Solver\n");
+    printf("========================\n");
+    
+    /* Write errors must come back as -4, not kill the process */
+    signal(SIGPIPE, SIG_IGN);
+    
+    int failed = test_line_input() + test_slot_handoff() + test_binary_records() +
+                 test_write_errors();
+    
+    printf("\n%s\n", failed ? "STREAM TEST FAILED" : "Every stream matches");
+    return failed ? 1 : 0;
+}